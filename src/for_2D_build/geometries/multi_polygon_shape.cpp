@@ -5,6 +5,189 @@ using namespace bg;
 namespace SPH
 {
 //=================================================================================================//
+void PolygonSegmentGrid::build(const boost_multi_poly &multi_poly)
+{
+    segment_start_.clear();
+    segment_end_.clear();
+    bg::for_each_segment(multi_poly, [&](const auto &seg)
+                         {
+                             segment_start_.push_back(Vecd(bg::get<0, 0>(seg), bg::get<0, 1>(seg)));
+                             segment_end_.push_back(Vecd(bg::get<1, 0>(seg), bg::get<1, 1>(seg))); });
+
+    size_t number_of_segments = segment_start_.size();
+    cell_offsets_.assign(1, 0);
+    row_offsets_.assign(1, 0);
+    cell_segments_.clear();
+    row_segments_.clear();
+    all_cells_ = Arrayi::Zero();
+    if (number_of_segments == 0)
+        return;
+
+    lower_bound_ = segment_start_[0];
+    upper_bound_ = segment_start_[0];
+    for (size_t k = 0; k != number_of_segments; ++k)
+    {
+        lower_bound_ = lower_bound_.cwiseMin(segment_start_[k].cwiseMin(segment_end_[k]));
+        upper_bound_ = upper_bound_.cwiseMax(segment_start_[k].cwiseMax(segment_end_[k]));
+    }
+    Vecd extent = upper_bound_ - lower_bound_;
+    boundary_tolerance_ = 10.0 * Eps * extent.norm();
+    /** About one segment per cell, while the number of cells is bounded for thin shapes. */
+    grid_spacing_ = SMAX(sqrt(extent[0] * extent[1] / Real(number_of_segments)),
+                         extent.maxCoeff() / Real(number_of_segments));
+    all_cells_ = (extent / grid_spacing_).array().floor().cast<int>() + Arrayi::Ones();
+
+    /** Counting sort of the segments into the cells and the row bands. */
+    size_t total_cells = all_cells_[0] * all_cells_[1];
+    cell_offsets_.assign(total_cells + 1, 0);
+    row_offsets_.assign(all_cells_[1] + 1, 0);
+    auto for_each_overlapped_cell = [&](size_t k, const auto &function)
+    {
+        Arrayi lower = CellIndexFromPosition(segment_start_[k].cwiseMin(segment_end_[k]));
+        Arrayi upper = CellIndexFromPosition(segment_start_[k].cwiseMax(segment_end_[k]));
+        for (int j = lower[1]; j <= upper[1]; ++j)
+            for (int i = lower[0]; i <= upper[0]; ++i)
+                function(i, j);
+    };
+    auto for_each_overlapped_row = [&](size_t k, const auto &function)
+    {
+        int lower = CellIndexFromPosition(segment_start_[k].cwiseMin(segment_end_[k]))[1];
+        int upper = CellIndexFromPosition(segment_start_[k].cwiseMax(segment_end_[k]))[1];
+        for (int j = lower; j <= upper; ++j)
+            function(j);
+    };
+
+    for (size_t k = 0; k != number_of_segments; ++k)
+    {
+        for_each_overlapped_cell(k, [&](int i, int j)
+                                 { cell_offsets_[j * all_cells_[0] + i + 1]++; });
+        for_each_overlapped_row(k, [&](int j)
+                                { row_offsets_[j + 1]++; });
+    }
+    for (size_t n = 0; n != total_cells; ++n)
+        cell_offsets_[n + 1] += cell_offsets_[n];
+    for (int j = 0; j != all_cells_[1]; ++j)
+        row_offsets_[j + 1] += row_offsets_[j];
+
+    cell_segments_.resize(cell_offsets_.back());
+    row_segments_.resize(row_offsets_.back());
+    StdVec<size_t> cell_fill(cell_offsets_.begin(), cell_offsets_.end() - 1);
+    StdVec<size_t> row_fill(row_offsets_.begin(), row_offsets_.end() - 1);
+    for (size_t k = 0; k != number_of_segments; ++k)
+    {
+        for_each_overlapped_cell(k, [&](int i, int j)
+                                 { cell_segments_[cell_fill[j * all_cells_[0] + i]++] = k; });
+        for_each_overlapped_row(k, [&](int j)
+                                { row_segments_[row_fill[j]++] = k; });
+    }
+}
+//=================================================================================================//
+Arrayi PolygonSegmentGrid::CellIndexFromPosition(const Vecd &position) const
+{
+    Arrayi cell_index = Arrayi::Zero();
+    for (int n = 0; n != Dimensions; ++n)
+    {
+        Real index = floor((position[n] - lower_bound_[n]) / grid_spacing_);
+        cell_index[n] = int(SMIN(SMAX(index, Real(0)), Real(all_cells_[n] - 1)));
+    }
+    return cell_index;
+}
+//=================================================================================================//
+Vecd PolygonSegmentGrid::closestPointOnSegment(size_t index, const Vecd &probe_point) const
+{
+    const Vecd &p_0 = segment_start_[index];
+    Vecd vec_v = segment_end_[index] - p_0;
+    Vecd vec_w = probe_point - p_0;
+
+    Real c1 = vec_v.dot(vec_w);
+    if (c1 <= 0)
+        return p_0;
+    Real c2 = vec_v.dot(vec_v);
+    if (c2 <= c1)
+        return segment_end_[index];
+    return p_0 + vec_v * c1 / c2;
+}
+//=================================================================================================//
+bool PolygonSegmentGrid::checkContain(const Vecd &probe_point, bool BOUNDARY_INCLUDED) const
+{
+    if (segment_start_.empty() ||
+        (probe_point - lower_bound_).minCoeff() < -boundary_tolerance_ ||
+        (upper_bound_ - probe_point).minCoeff() < -boundary_tolerance_)
+        return false;
+
+    int row = CellIndexFromPosition(probe_point)[1];
+    bool is_contained = false;
+    for (size_t n = row_offsets_[row]; n != row_offsets_[row + 1]; ++n)
+    {
+        size_t k = row_segments_[n];
+        if ((closestPointOnSegment(k, probe_point) - probe_point).norm() <= boundary_tolerance_)
+            return BOUNDARY_INCLUDED;
+
+        const Vecd &p_0 = segment_start_[k];
+        const Vecd &p_1 = segment_end_[k];
+        if ((p_0[1] > probe_point[1]) != (p_1[1] > probe_point[1]))
+        {
+            Real x_cross = p_0[0] + (probe_point[1] - p_0[1]) * (p_1[0] - p_0[0]) / (p_1[1] - p_0[1]);
+            if (probe_point[0] < x_cross)
+                is_contained = !is_contained;
+        }
+    }
+    return is_contained;
+}
+//=================================================================================================//
+Vecd PolygonSegmentGrid::findClosestPoint(const Vecd &probe_point) const
+{
+    if (segment_start_.empty())
+        return probe_point;
+
+    Arrayi center = CellIndexFromPosition(probe_point);
+    Vecd closest_point = probe_point;
+    Real closest_distance_sqr = MaxReal;
+    auto search_cell = [&](int i, int j)
+    {
+        if (i < 0 || j < 0 || i >= all_cells_[0] || j >= all_cells_[1])
+            return;
+        size_t cell = j * all_cells_[0] + i;
+        for (size_t n = cell_offsets_[cell]; n != cell_offsets_[cell + 1]; ++n)
+        {
+            Vecd point = closestPointOnSegment(cell_segments_[n], probe_point);
+            Real distance_sqr = (point - probe_point).squaredNorm();
+            if (distance_sqr < closest_distance_sqr)
+            {
+                closest_distance_sqr = distance_sqr;
+                closest_point = point;
+            }
+        }
+    };
+
+    /** The cells beyond the ring m are at least m grid spacings away from the probe point. */
+    int max_ring = all_cells_.maxCoeff();
+    for (int m = 0; m <= max_ring; ++m)
+    {
+        if (m == 0)
+        {
+            search_cell(center[0], center[1]);
+        }
+        else
+        {
+            for (int i = center[0] - m; i <= center[0] + m; ++i)
+            {
+                search_cell(i, center[1] - m);
+                search_cell(i, center[1] + m);
+            }
+            for (int j = center[1] - m + 1; j <= center[1] + m - 1; ++j)
+            {
+                search_cell(center[0] - m, j);
+                search_cell(center[0] + m, j);
+            }
+        }
+        Real ring_distance = Real(m) * grid_spacing_;
+        if (closest_distance_sqr <= ring_distance * ring_distance)
+            break;
+    }
+    return closest_point;
+}
+//=================================================================================================//
 MultiPolygon::MultiPolygon(const std::vector<Vecd> &points)
     : MultiPolygon()
 {
@@ -65,11 +248,13 @@ boost_multi_poly MultiPolygon::
 void MultiPolygon::addAMultiPolygon(MultiPolygon &multi_polygon_op, ShapeBooleanOps op)
 {
     multi_poly_ = MultiPolygonByBooleanOps(multi_poly_, multi_polygon_op.getBoostMultiPoly(), op);
+    segment_grid_.build(multi_poly_);
 }
 //=================================================================================================//
 void MultiPolygon::addABoostMultiPoly(boost_multi_poly &boost_multi_poly_op, ShapeBooleanOps op)
 {
     multi_poly_ = MultiPolygonByBooleanOps(multi_poly_, boost_multi_poly_op, op);
+    segment_grid_.build(multi_poly_);
 }
 //=================================================================================================//
 void MultiPolygon::addABox(Transform transform, const Vecd &halfsize, ShapeBooleanOps op)
@@ -116,6 +301,7 @@ void MultiPolygon::addACircle(const Vecd &center, Real radius, int resolution, S
     }
 
     multi_poly_ = MultiPolygonByBooleanOps(multi_poly_, multi_poly_circle, op);
+    segment_grid_.build(multi_poly_);
 }
 //=================================================================================================//
 void MultiPolygon::addAPolygon(const std::vector<Vecd> &points, ShapeBooleanOps op)
@@ -146,6 +332,7 @@ void MultiPolygon::addAPolygon(const std::vector<Vecd> &points, ShapeBooleanOps
     convert(poly, multi_poly_polygon);
 
     multi_poly_ = MultiPolygonByBooleanOps(multi_poly_, multi_poly_polygon, op);
+    segment_grid_.build(multi_poly_);
 }
 //=================================================================================================//
 void MultiPolygon::
@@ -176,78 +363,12 @@ void MultiPolygon::
 //=================================================================================================//
 bool MultiPolygon::checkContain(const Vec2d &probe_point, bool BOUNDARY_INCLUDED /*= true*/)
 {
-    if (BOUNDARY_INCLUDED)
-    {
-        return covered_by(boost_point(probe_point[0], probe_point[1]), multi_poly_);
-    }
-    else
-    {
-        return within(boost_point(probe_point[0], probe_point[1]), multi_poly_);
-    }
+    return segment_grid_.checkContain(probe_point, BOUNDARY_INCLUDED);
 }
 //=================================================================================================//
 Vecd MultiPolygon::findClosestPoint(const Vecd &probe_point)
 {
-    /**
-     * typedef model::segment<model::d2::point_xy<Real>> boost_seg;
-     * From the documentation on segment and referring_segment, the only difference between the two is that
-     * referring_segment holds a reference to the points.
-     * This is what is needed in a for each that modifies the segment since the points modified should be
-     * reflected in the line string. In a for each that does not modify the points, it should still take a
-     * reference (most likely a const reference) since it reduces the amount of copying.
-     */
-    boost_point input_p(probe_point[0], probe_point[1]);
-    bg::model::segment<boost_point> closest_seg;
-    Real closest_dist_2seg = boost::numeric::bounds<Real>::highest();
-    std::function<void(boost_seg)> findclosestsegment = [&closest_seg, &closest_dist_2seg, &input_p](boost_seg seg)
-    {
-        Real dist = bg::distance(input_p, seg);
-        if (dist < closest_dist_2seg)
-        {
-            closest_dist_2seg = dist;
-            // closest_seg.append(seg);
-            Real x0 = bg::get<0, 0>(seg);
-            Real y0 = bg::get<0, 1>(seg);
-            Real x1 = bg::get<1, 0>(seg);
-            Real y1 = bg::get<1, 1>(seg);
-            bg::set<0, 0>(closest_seg, x0);
-            bg::set<0, 1>(closest_seg, y0);
-            bg::set<1, 0>(closest_seg, x1);
-            bg::set<1, 1>(closest_seg, y1);
-        }
-    };
-    bg::for_each_segment(multi_poly_, findclosestsegment);
-
-    Vecd p_find = Vecd::Zero();
-
-    Real x0 = bg::get<0, 0>(closest_seg);
-    Real y0 = bg::get<0, 1>(closest_seg);
-    Real x1 = bg::get<1, 0>(closest_seg);
-    Real y1 = bg::get<1, 1>(closest_seg);
-    Vecd p_0(x0, y0);
-    Vecd p_1(x1, y1);
-    Vecd vec_v = p_1 - p_0;
-    Vecd vec_w = probe_point - p_0;
-
-    Real c1 = vec_v.dot(vec_w);
-    if (c1 <= 0)
-    {
-        p_find = p_0;
-    }
-    else
-    {
-        Real c2 = vec_v.dot(vec_v);
-        if (c2 <= c1)
-        {
-            p_find = p_1;
-        }
-        else
-        {
-            p_find = p_0 + vec_v * c1 / c2;
-        }
-    }
-
-    return p_find;
+    return segment_grid_.findClosestPoint(probe_point);
 }
 //=================================================================================================//
 BoundingBox MultiPolygon::findBounds()
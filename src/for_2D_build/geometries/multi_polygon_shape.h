@@ -73,6 +73,40 @@ typedef bg::model::polygon<boost_point> boost_poly;
 typedef bg::model::multi_polygon<boost_poly> boost_multi_poly;
 typedef bg::model::referring_segment<boost_point> boost_seg;
 
+/**
+ * @class PolygonSegmentGrid
+ * @brief The flattened segments of a multi polygon binned on a uniform grid.
+ * @details A cell keeps the segments whose bounding boxes overlap it
+ * and a row band keeps the segments overlapping its height.
+ * The containment is given by the crossing number of the segments in the row band of the probe point,
+ * and the closest point is searched in the rings of cells around the probe point
+ * until the rest segments are further than the closest one found.
+ * The grid is built once after each modification of the multi polygon
+ * so that the queries are read only and can be called concurrently.
+ */
+class PolygonSegmentGrid
+{
+  public:
+    PolygonSegmentGrid() {};
+    void build(const boost_multi_poly &multi_poly);
+    bool checkContain(const Vecd &probe_point, bool BOUNDARY_INCLUDED = true) const;
+    Vecd findClosestPoint(const Vecd &probe_point) const;
+
+  protected:
+    StdVec<Vecd> segment_start_, segment_end_;
+    Vecd lower_bound_ = Vecd::Zero();
+    Vecd upper_bound_ = Vecd::Zero();
+    Real grid_spacing_ = 1.0;
+    Real boundary_tolerance_ = 0.0;
+    Arrayi all_cells_ = Arrayi::Zero();
+    /** Segment indices of the cells and the row bands in compressed storage. */
+    StdVec<size_t> cell_offsets_, cell_segments_;
+    StdVec<size_t> row_offsets_, row_segments_;
+
+    Arrayi CellIndexFromPosition(const Vecd &position) const;
+    Vecd closestPointOnSegment(size_t index, const Vecd &probe_point) const;
+};
+
 /**
  * @class MultiPolygon
  * @brief used to define a closed region
@@ -83,7 +117,7 @@ class MultiPolygon
     MultiPolygon() {};
     explicit MultiPolygon(const std::vector<Vecd> &points);
     explicit MultiPolygon(const Vecd &center, Real radius, int resolution);
-    boost_multi_poly &getBoostMultiPoly() { return multi_poly_; };
+    const boost_multi_poly &getBoostMultiPoly() { return multi_poly_; };
 
     BoundingBox findBounds();
     bool checkContain(const Vecd &pnt, bool BOUNDARY_INCLUDED = true);
@@ -98,6 +132,7 @@ class MultiPolygon
 
   protected:
     boost_multi_poly multi_poly_;
+    PolygonSegmentGrid segment_grid_;
     boost_multi_poly MultiPolygonByBooleanOps(boost_multi_poly multi_poly_in,
                                               boost_multi_poly multi_poly_op,
                                               ShapeBooleanOps boolean_op);
@@ -102,6 +102,46 @@ UniquePtr<MultilevelLevelSet> SPHAdaptation::createLevelSet(Shape &shape, Real r
     return makeUnique<MultilevelLevelSet>(shape.getBounds(), coarser_level_sets.getMeshLevels().back(), shape, *this);
 }
 //=================================================================================================//
+AnisotropicAdaptation::AnisotropicAdaptation(Real resolution_ref, const Vecd &kernel_vector,
+                                             Real h_spacing_ratio, Real system_refinement_ratio)
+    : SPHAdaptation(resolution_ref, h_spacing_ratio, system_refinement_ratio),
+      kernel_vector_(kernel_vector), reference_transform_(Matd::Zero()), dv_anisotropic_transform_(nullptr)
+{
+    for (int axis = 0; axis != Dimensions; ++axis)
+    {
+        reference_transform_(axis, axis) = 1.0 / kernel_vector_[axis];
+    }
+}
+//=================================================================================================//
+AnisotropicAdaptation::AnisotropicAdaptation(SPHSystem &sph_system, const Vecd &kernel_vector,
+                                             Real h_spacing_ratio, Real system_refinement_ratio)
+    : AnisotropicAdaptation(sph_system.ReferenceResolution(), kernel_vector,
+                            h_spacing_ratio, system_refinement_ratio) {}
+//=================================================================================================//
+void AnisotropicAdaptation::initializeAdaptationVariables(BaseParticles &base_particles)
+{
+    SPHAdaptation::initializeAdaptationVariables(base_particles);
+    dv_anisotropic_transform_ =
+        base_particles.registerStateVariableOnly<Matd>("AnisotropicTransform", reference_transform_);
+    base_particles.addEvolvingVariable<Matd>("AnisotropicTransform");
+}
+//=================================================================================================//
+UniquePtr<BaseCellLinkedList> AnisotropicAdaptation::
+    createCellLinkedList(const BoundingBox &domain_bounds, BaseParticles &base_particles)
+{
+    Real shortest_support = kernel_vector_.minCoeff();
+    UniquePtr<CellLinkedList> cell_linked_list =
+        makeUnique<CellLinkedList>(domain_bounds, shortest_support * kernel_ptr_->CutOffRadius(), base_particles, *this);
+
+    Arrayi search_depth = Arrayi::Ones();
+    for (int axis = 0; axis != Dimensions; ++axis)
+    {
+        search_depth[axis] = (int)ceil(kernel_vector_[axis] / shortest_support - Eps);
+    }
+    cell_linked_list->setSearchDepth(search_depth);
+    return cell_linked_list;
+}
+//=================================================================================================//
 ParticleWithLocalRefinement::
     ParticleWithLocalRefinement(Real resolution_ref, Real h_spacing_ratio, Real system_refinement_ratio,
                                 int local_refinement_level)
@@ -102,6 +102,35 @@ class SPHAdaptation
     Real MostRefinedSpacingRegular(Real coarse_particle_spacing, int local_refinement_level);
 };
 
+/**
+ * @class AnisotropicAdaptation
+ * @brief Kernel support stretched along the coordinate axes by a kernel vector.
+ * The per-particle transform tensor maps a displacement to the isotropic kernel space
+ * and is initialized as the reference transform, i.e. the inverse of the kernel vector.
+ * The per-particle transforms may be modified but should not stretch the support beyond the reference one.
+ * The cell linked list has the cell size of the shortest support and is searched deeper along the longer axes.
+ */
+class AnisotropicAdaptation : public SPHAdaptation
+{
+  public:
+    AnisotropicAdaptation(Real resolution_ref, const Vecd &kernel_vector,
+                          Real h_spacing_ratio = 1.3, Real system_refinement_ratio = 1.0);
+    AnisotropicAdaptation(SPHSystem &sph_system, const Vecd &kernel_vector,
+                          Real h_spacing_ratio = 1.3, Real system_refinement_ratio = 1.0);
+    virtual ~AnisotropicAdaptation() {};
+
+    Vecd KernelVector() { return kernel_vector_; };
+    Matd ReferenceTransform() { return reference_transform_; };
+    DiscreteVariable<Matd> *dvAnisotropicTransform() { return dv_anisotropic_transform_; };
+    virtual void initializeAdaptationVariables(BaseParticles &base_particles) override;
+    virtual UniquePtr<BaseCellLinkedList> createCellLinkedList(const BoundingBox &domain_bounds, BaseParticles &base_particles) override;
+
+  protected:
+    Vecd kernel_vector_;
+    Matd reference_transform_;
+    DiscreteVariable<Matd> *dv_anisotropic_transform_;
+};
+
 /**
  * @class ParticleWithLocalRefinement
  * @brief Base class for particle with local refinement.
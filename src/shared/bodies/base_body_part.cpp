@@ -18,8 +18,8 @@ BodyPartByID::BodyPartByID(SPHBody &sph_body) : BodyPart(sph_body)
 }
 //=================================================================================================//
 BodyPartByParticle::BodyPartByParticle(SPHBody &sph_body)
-    : BodyPart(sph_body), body_part_bounds_(Vecd::Zero(), Vecd::Zero()),
-      body_part_bounds_set_(false)
+    : BodyPart(sph_body), dv_particle_list_(nullptr), dv_original_id_list_(nullptr),
+      number_of_taggings_(0), body_part_bounds_(Vecd::Zero(), Vecd::Zero()), body_part_bounds_set_(false)
 {
     sph_body.addBodyPartByParticle(this);
     base_particles_.addEvolvingVariable<int>(dv_body_part_id_);
@@ -38,22 +38,59 @@ BoundingBox BodyPartByParticle::getBodyPartBounds()
     return body_part_bounds_;
 }
 //=================================================================================================//
-void BodyPartByParticle::tagParticles(TaggingParticleMethod &tagging_particle_method)
+void BodyPartByParticle::collectTaggedParticles()
 {
-    for (size_t i = 0; i != base_particles_.TotalRealParticles(); ++i)
-    {
-        if (tagging_particle_method(i))
+    size_t total_real_particles = base_particles_.TotalRealParticles();
+    int *body_part_id = dv_body_part_id_->Data();
+    body_part_particles_.resize(total_real_particles);
+    // the scan keeps the ascending order of particle indexes as a sequential collection
+    size_t number_of_tagged_particles = parallel_scan(
+        IndexRange(0, total_real_particles), size_t(0),
+        [&](const IndexRange &r, size_t sum, bool is_final_scan) -> size_t
         {
-            dv_body_part_id_->setValue(i, part_id_);
-            body_part_particles_.push_back(i);
-        }
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                if (body_part_id[i] == part_id_)
+                {
+                    if (is_final_scan)
+                        body_part_particles_[sum] = i;
+                    sum++;
+                }
+            }
+            return sum;
+        },
+        [](size_t a, size_t b)
+        { return a + b; });
+    body_part_particles_.resize(number_of_tagged_particles);
+
+    if (dv_particle_list_ == nullptr)
+    {
+        dv_particle_list_ = unique_variable_ptrs_.createPtr<DiscreteVariable<UnsignedInt>>(
+            part_name_, number_of_tagged_particles);
+        dv_original_id_list_ = unique_variable_ptrs_.createPtr<DiscreteVariable<UnsignedInt>>(
+            part_name_ + "Initial", number_of_tagged_particles);
+        sv_range_size_ = unique_variable_ptrs_.createPtr<SingularVariable<UnsignedInt>>(
+            part_name_ + "_Size", number_of_tagged_particles);
     }
+    dv_particle_list_->reallocateData(par, number_of_tagged_particles);
+    dv_original_id_list_->reallocateData(par, number_of_tagged_particles);
+    sv_range_size_->setValue(number_of_tagged_particles);
 
-    dv_particle_list_ = unique_variable_ptrs_.createPtr<DiscreteVariable<UnsignedInt>>(
-        part_name_, body_part_particles_.size(), [&](size_t i)
-        { return body_part_particles_[i]; });
-    sv_range_size_ = unique_variable_ptrs_.createPtr<SingularVariable<UnsignedInt>>(
-        part_name_ + "_Size", body_part_particles_.size());
+    UnsignedInt *particle_list = dv_particle_list_->Data();
+    UnsignedInt *original_id_list = dv_original_id_list_->Data();
+    UnsignedInt *original_id = base_particles_.getVariableDataByName<UnsignedInt>("OriginalID");
+    parallel_for(
+        IndexRange(0, number_of_tagged_particles),
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                particle_list[i] = body_part_particles_[i];
+                original_id_list[i] = original_id[body_part_particles_[i]];
+            }
+        },
+        ap);
+    number_of_taggings_++;
 }
 //=================================================================================================//
 BodyPartByCell::BodyPartByCell(RealBody &real_body)
@@ -77,14 +114,21 @@ void BodyPartByCell::tagCells(TaggingCellMethod &tagging_cell_method)
     ConcurrentIndexVector cell_indexes;
     cell_linked_list_.tagBodyPartByCell(body_part_cells_, cell_indexes, tagging_cell_method);
 
-    for (size_t i = 0; i != body_part_cells_.size(); ++i)
-    {
-        ConcurrentIndexVector &particle_indexes = *body_part_cells_[i];
-        for (size_t num = 0; num < particle_indexes.size(); ++num)
+    int *body_part_id = dv_body_part_id_->Data();
+    parallel_for(
+        IndexRange(0, body_part_cells_.size()),
+        [&](const IndexRange &r)
         {
-            dv_body_part_id_->setValue(particle_indexes[num], part_id_);
-        }
-    }
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                ConcurrentIndexVector &particle_indexes = *body_part_cells_[i];
+                for (size_t num = 0; num < particle_indexes.size(); ++num)
+                {
+                    body_part_id[particle_indexes[num]] = part_id_;
+                }
+            }
+        },
+        ap);
     dv_cell_list_ = unique_variable_ptrs_.createPtr<DiscreteVariable<UnsignedInt>>(
         part_name_, cell_indexes.size(), [&](size_t i)
         { return cell_indexes[i]; });
@@ -97,8 +141,8 @@ BodyRegionByParticle::
     : BodyPartByParticle(sph_body), body_part_shape_(body_part_shape)
 {
     alias_ = body_part_shape_.getName();
-    TaggingParticleMethod tagging_particle_method = std::bind(&BodyRegionByParticle::tagByContain, this, _1);
-    tagParticles(tagging_particle_method);
+    tagParticles([&](size_t i)
+                 { return tagByContain(i); });
 }
 //=================================================================================================//
 BodyRegionByParticle::BodyRegionByParticle(SPHBody &sph_body, SharedPtr<Shape> shape_ptr)
@@ -117,8 +161,8 @@ BodySurface::BodySurface(SPHBody &sph_body)
       particle_spacing_min_(sph_body.getSPHAdaptation().MinimumSpacing())
 {
     alias_ = "BodySurface";
-    TaggingParticleMethod tagging_particle_method = std::bind(&BodySurface::tagNearSurface, this, _1);
-    tagParticles(tagging_particle_method);
+    tagParticles([&](size_t i)
+                 { return tagNearSurface(i); });
     std::cout << "Number of surface particles : " << body_part_particles_.size() << std::endl;
 }
 //=================================================================================================//
@@ -133,8 +177,8 @@ BodySurfaceLayer::BodySurfaceLayer(SPHBody &sph_body, Real layer_thickness)
       thickness_threshold_(sph_body.getSPHAdaptation().ReferenceSpacing() * layer_thickness)
 {
     alias_ = "InnerLayers";
-    TaggingParticleMethod tagging_particle_method = std::bind(&BodySurfaceLayer::tagSurfaceLayer, this, _1);
-    tagParticles(tagging_particle_method);
+    tagParticles([&](size_t i)
+                 { return tagSurfaceLayer(i); });
     std::cout << "Number of inner layers particles : " << body_part_particles_.size() << std::endl;
 }
 //=================================================================================================//
@@ -212,9 +256,8 @@ AlignedBoxPart::AlignedBoxPart(const std::string &part_name, const AlignedBox &a
 AlignedBoxByParticle::AlignedBoxByParticle(RealBody &real_body, const AlignedBox &aligned_box)
     : BodyPartByParticle(real_body), AlignedBoxPart(part_name_, aligned_box)
 {
-    TaggingParticleMethod tagging_particle_method =
-        std::bind(&AlignedBoxByParticle::tagByContain, this, _1);
-    tagParticles(tagging_particle_method);
+    tagParticles([&](size_t i)
+                 { return tagByContain(i); });
 }
 //=================================================================================================//
 bool AlignedBoxByParticle::tagByContain(size_t particle_index)
@@ -107,6 +107,9 @@ class BodyPartByParticle : public BodyPart
     IndexVector body_part_particles_; /**< Collection particle in this body part. */
     BaseParticles &getBaseParticles() { return base_particles_; };
     DiscreteVariable<UnsignedInt> *dvParticleList() { return dv_particle_list_; };
+    /** The original IDs of the tagged particles, which do not change by particle sorting. */
+    DiscreteVariable<UnsignedInt> *dvOriginalIDList() { return dv_original_id_list_; };
+    size_t NumberOfTaggings() { return number_of_taggings_; };
     IndexVector &LoopRange() { return body_part_particles_; };
     size_t SizeOfLoopRange() { return body_part_particles_.size(); };
     BodyPartByParticle(SPHBody &sph_body);
@@ -116,10 +119,19 @@ class BodyPartByParticle : public BodyPart
 
   protected:
     DiscreteVariable<UnsignedInt> *dv_particle_list_;
+    DiscreteVariable<UnsignedInt> *dv_original_id_list_;
+    size_t number_of_taggings_;
     BoundingBox body_part_bounds_;
     bool body_part_bounds_set_;
     typedef std::function<bool(size_t)> TaggingParticleMethod;
-    void tagParticles(TaggingParticleMethod &tagging_particle_method);
+
+    /** Flag the particles in parallel and then compact them into the particle list.
+     *  The tagging method is called concurrently and should be thread safe. */
+    template <typename TaggingMethod>
+    void tagParticles(const TaggingMethod &tagging_particle_method);
+    void collectTaggedParticles();
+    template <class ExecutionPolicy>
+    void synchronizeParticleLists(const ExecutionPolicy &ex_policy);
 };
 
 /**
@@ -149,6 +161,30 @@ class BodyPartByCell : public BodyPart
     void tagCells(TaggingCellMethod &tagging_cell_method);
 };
 
+template <typename TaggingMethod>
+void BodyPartByParticle::tagParticles(const TaggingMethod &tagging_particle_method)
+{
+    int *body_part_id = dv_body_part_id_->Data();
+    parallel_for(
+        IndexRange(0, base_particles_.TotalRealParticles()),
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                body_part_id[i] = tagging_particle_method(i) ? part_id_ : 0;
+            }
+        },
+        ap);
+    collectTaggedParticles();
+}
+
+template <class ExecutionPolicy>
+void BodyPartByParticle::synchronizeParticleLists(const ExecutionPolicy &ex_policy)
+{
+    dv_particle_list_->synchronizeToDevice(ex_policy);
+    dv_original_id_list_->synchronizeToDevice(ex_policy);
+}
+
 /**
  * @class BodyRegionByParticle
  * @brief A  body part with the collection of particles within by a prescribed shape.
@@ -163,6 +199,14 @@ class BodyRegionByParticle : public BodyPartByParticle
     BodyRegionByParticle(SPHBody &sph_body, SharedPtr<Shape> shape_ptr);
     virtual ~BodyRegionByParticle() {};
     Shape &getBodyPartShape() { return body_part_shape_; };
+    /** Re-tag the region, e.g. after the shape is moved. */
+    template <class ExecutionPolicy = ParallelPolicy>
+    void update(const ExecutionPolicy &ex_policy = ExecutionPolicy{})
+    {
+        tagParticles([&](size_t i)
+                     { return tagByContain(i); });
+        synchronizeParticleLists(ex_policy);
+    };
 
   protected:
     Shape &body_part_shape_;
@@ -263,6 +307,14 @@ class AlignedBoxByParticle : public BodyPartByParticle, public AlignedBoxPart
   public:
     AlignedBoxByParticle(RealBody &real_body, const AlignedBox &aligned_box);
     virtual ~AlignedBoxByParticle() {};
+    /** Re-tag the particles, e.g. after the aligned box is moved. */
+    template <class ExecutionPolicy = ParallelPolicy>
+    void update(const ExecutionPolicy &ex_policy = ExecutionPolicy{})
+    {
+        tagParticles([&](size_t i)
+                     { return tagByContain(i); });
+        synchronizeParticleLists(ex_policy);
+    };
 
   protected:
     bool tagByContain(size_t particle_index);
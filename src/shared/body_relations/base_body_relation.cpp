@@ -20,9 +20,21 @@ SPHRelation::SPHRelation(SPHBody &sph_body)
     : sph_body_(sph_body),
       base_particles_(sph_body.getBaseParticles()) {}
 //=================================================================================================//
+void SPHRelation::checkIsotropicAdaptation(SPHBody &sph_body)
+{
+    if (dynamic_cast<AnisotropicAdaptation *>(&sph_body.getSPHAdaptation()) != nullptr)
+    {
+        std::cout << "\n Error: the body " << sph_body.getName() << " with AnisotropicAdaptation "
+                  << "is only supported by the relations with Anisotropic neighborhood!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+}
+//=================================================================================================//
 BaseInnerRelation::BaseInnerRelation(RealBody &real_body)
     : SPHRelation(real_body), real_body_(&real_body)
 {
+    checkIsotropicAdaptation(real_body);
     subscribeToBody();
     inner_configuration_.resize(base_particles_.ParticlesBound(), Neighborhood());
 }
@@ -44,10 +56,12 @@ void BaseInnerRelation::resetNeighborhoodCurrentSize()
 BaseContactRelation::BaseContactRelation(SPHBody &sph_body, RealBodyVector contact_sph_bodies)
     : SPHRelation(sph_body), contact_bodies_(contact_sph_bodies)
 {
+    checkIsotropicAdaptation(sph_body);
     subscribeToBody();
     contact_configuration_.resize(contact_bodies_.size());
     for (size_t k = 0; k != contact_bodies_.size(); ++k)
     {
+        checkIsotropicAdaptation(*contact_bodies_[k]);
         const std::string name = contact_bodies_[k]->getName();
         contact_particles_.push_back(&contact_bodies_[k]->getBaseParticles());
         contact_adaptations_.push_back(&contact_bodies_[k]->getSPHAdaptation());
@@ -117,6 +117,8 @@ class SPHRelation
   protected:
     SPHBody &sph_body_;
     BaseParticles &base_particles_;
+    /** The neighbor search here is not for an anisotropic kernel support. */
+    void checkIsotropicAdaptation(SPHBody &sph_body);
 };
 
 /**
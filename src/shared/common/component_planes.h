@@ -0,0 +1,154 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file component_planes.h
+ * @brief Structure-of-arrays copies of vector and matrix variables.
+ * @details The particle variables are stored as arrays of Eigen fixed-size objects.
+ * A loop working on single components, or vectorized across particles,
+ * may work on a copy with one contiguous plane for each component instead.
+ * The copy is loaded from and stored back to the variable explicitly.
+ * @author Xiangyu Hu
+ */
+
+#ifndef COMPONENT_PLANES_H
+#define COMPONENT_PLANES_H
+
+#include "sphinxsys_variable.h"
+
+namespace SPH
+{
+/**
+ * @class PlanesAccessor
+ * @brief Kernel-side access to component planes.
+ * The element proxy converts to and assigns from the data type,
+ * so that a kernel written for an array of the data type compiles with it.
+ */
+template <typename DataType>
+class PlanesAccessor
+{
+  public:
+    static constexpr int number_of_components_ = DataType::SizeAtCompileTime;
+
+    PlanesAccessor(Real *planes, size_t plane_size) : planes_(planes), plane_size_(plane_size) {};
+
+    class Element
+    {
+      public:
+        Element(Real *first, size_t plane_size) : first_(first), plane_size_(plane_size) {};
+        operator DataType() const
+        {
+            DataType value;
+            for (int c = 0; c != number_of_components_; ++c)
+                value.data()[c] = first_[c * plane_size_];
+            return value;
+        };
+        Element &operator=(const DataType &value)
+        {
+            for (int c = 0; c != number_of_components_; ++c)
+                first_[c * plane_size_] = value.data()[c];
+            return *this;
+        };
+        Element &operator+=(const DataType &value)
+        {
+            for (int c = 0; c != number_of_components_; ++c)
+                first_[c * plane_size_] += value.data()[c];
+            return *this;
+        };
+
+      protected:
+        Real *first_;
+        size_t plane_size_;
+    };
+
+    Element operator[](size_t index) { return Element(planes_ + index, plane_size_); };
+    DataType load(size_t index) const { return Element(planes_ + index, plane_size_); };
+    Real *Plane(int component) { return planes_ + component * plane_size_; };
+
+  protected:
+    Real *planes_;
+    size_t plane_size_;
+};
+
+/**
+ * @class ComponentPlanes
+ * @brief A structure-of-arrays copy of a vector or matrix discrete variable.
+ * The planes are sized to the variable and reallocated with it.
+ * Note that the copy is not kept up to date with the variable automatically.
+ */
+template <typename DataType>
+class ComponentPlanes
+{
+  public:
+    static constexpr int number_of_components_ = DataType::SizeAtCompileTime;
+
+    explicit ComponentPlanes(DiscreteVariable<DataType> *dv_variable)
+        : dv_variable_(dv_variable), plane_size_(dv_variable->getDataSize()),
+          planes_(new Real[number_of_components_ * plane_size_]) {};
+    ~ComponentPlanes() { delete[] planes_; };
+
+    size_t PlaneSize() { return plane_size_; };
+    Real *Plane(int component) { return planes_ + component * plane_size_; };
+    PlanesAccessor<DataType> Accessor() { return PlanesAccessor<DataType>(planes_, plane_size_); };
+
+    /** Copy the first data of the variable into the planes. */
+    void load(size_t data_size)
+    {
+        checkPlaneSize();
+        DataType *data = dv_variable_->Data();
+        for (int c = 0; c != number_of_components_; ++c)
+        {
+            Real *plane = Plane(c);
+            for (size_t i = 0; i != data_size; ++i)
+                plane[i] = data[i].data()[c];
+        }
+    };
+
+    /** Copy the planes back into the first data of the variable. */
+    void store(size_t data_size)
+    {
+        DataType *data = dv_variable_->Data();
+        for (int c = 0; c != number_of_components_; ++c)
+        {
+            Real *plane = Plane(c);
+            for (size_t i = 0; i != data_size; ++i)
+                data[i].data()[c] = plane[i];
+        }
+    };
+
+  protected:
+    DiscreteVariable<DataType> *dv_variable_;
+    size_t plane_size_;
+    Real *planes_;
+
+    void checkPlaneSize()
+    {
+        if (plane_size_ != dv_variable_->getDataSize())
+        {
+            delete[] planes_;
+            plane_size_ = dv_variable_->getDataSize();
+            planes_ = new Real[number_of_components_ * plane_size_];
+        }
+    };
+};
+} // namespace SPH
+#endif // COMPONENT_PLANES_H
@@ -55,6 +55,30 @@ class Entity
     const std::string name_;
 };
 
+/**
+ * @class VariableAccessRecorder
+ * @brief Records the variables whose data are delegated, e.g. to computing kernels,
+ * so that the data dependencies between dynamics can be inferred.
+ */
+class VariableAccessRecorder
+{
+  public:
+    static void startRecording(StdVec<Entity *> *recorded_variables) { recorded_variables_ = recorded_variables; };
+    static void stopRecording() { recorded_variables_ = nullptr; };
+    static bool isRecording() { return recorded_variables_ != nullptr; };
+    static void record(Entity *variable)
+    {
+        if (recorded_variables_ != nullptr &&
+            std::find(recorded_variables_->begin(), recorded_variables_->end(), variable) == recorded_variables_->end())
+        {
+            recorded_variables_->push_back(variable);
+        }
+    };
+
+  private:
+    static inline thread_local StdVec<Entity *> *recorded_variables_ = nullptr;
+};
+
 template <typename DataType>
 class DeviceSharedSingularVariable : public Entity
 {
@@ -82,11 +106,16 @@ class SingularVariable : public Entity
     void incrementValue(const DataType &value) { *delegated_ += value; };
 
     template <class ExecutionPolicy>
-    DataType *DelegatedData(const ExecutionPolicy &ex_policy) { return delegated_; };
+    DataType *DelegatedData(const ExecutionPolicy &ex_policy)
+    {
+        VariableAccessRecorder::record(this);
+        return delegated_;
+    };
 
     template <class PolicyType>
     DataType *DelegatedData(const DeviceExecution<PolicyType> &ex_policy)
     {
+        VariableAccessRecorder::record(this);
         return DelegatedOnDevice();
     };
 
@@ -148,10 +177,18 @@ class DiscreteVariable : public Entity
     DataType getValue(size_t index) { return data_field_[index]; };
 
     template <class ExecutionPolicy>
-    DataType *DelegatedData(const ExecutionPolicy &ex_policy) { return data_field_; };
+    DataType *DelegatedData(const ExecutionPolicy &ex_policy)
+    {
+        VariableAccessRecorder::record(this);
+        return data_field_;
+    };
     DataType *DelegatedOnDevice();
     template <class PolicyType>
-    DataType *DelegatedData(const DeviceExecution<PolicyType> &ex_policy) { return DelegatedOnDevice(); };
+    DataType *DelegatedData(const DeviceExecution<PolicyType> &ex_policy)
+    {
+        VariableAccessRecorder::record(this);
+        return DelegatedOnDevice();
+    };
     bool isDataDelegated() { return device_data_field_ != nullptr; };
     size_t getDataSize() { return data_size_; }
     void setDeviceData(DataType *data_field) { device_data_field_ = data_field; };
@@ -169,6 +206,10 @@ class DiscreteVariable : public Entity
 
     void synchronizeWithDevice();
     void synchronizeToDevice();
+    template <class ExecutionPolicy>
+    void synchronizeToDevice(const ExecutionPolicy &ex_policy) {};
+    /** Renew the device copy after the host data are changed and possibly reallocated. */
+    void synchronizeToDevice(const ParallelDevicePolicy &par_device);
 
     template <class ExecutionPolicy>
     void prepareForOutput(const ExecutionPolicy &ex_policy) {};
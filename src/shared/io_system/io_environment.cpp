@@ -6,10 +6,10 @@
 namespace SPH
 {
 //=============================================================================================//
-IOEnvironment::IOEnvironment(SPHSystem &sph_system, bool delete_output)
+IOEnvironment::IOEnvironment(SPHSystem &sph_system, bool delete_output, const std::string &folder_suffix)
     : sph_system_(sph_system),
-      input_folder_("./input"), output_folder_("./output"),
-      restart_folder_("./restart"), reload_folder_("./reload")
+      input_folder_("./input"), output_folder_("./output" + folder_suffix),
+      restart_folder_("./restart" + folder_suffix), reload_folder_("./reload")
 {
     if (!fs::exists(input_folder_))
     {
@@ -59,7 +59,9 @@ class IOEnvironment
     std::string restart_folder_;
     std::string reload_folder_;
 
-    explicit IOEnvironment(SPHSystem &sph_system, bool delete_output = true);
+    /** The folder suffix is given to the output and restart folders,
+     *  e.g. for the replicas of an ensemble running in the same process. */
+    explicit IOEnvironment(SPHSystem &sph_system, bool delete_output = true, const std::string &folder_suffix = "");
     virtual ~IOEnvironment(){};
     ParameterizationIO *defineParameterizationIO();
 };
@@ -143,7 +143,7 @@ void BaseCellLinkedList::findNearestListDataEntryByMesh(Mesh &mesh, UnsignedInt
 //=================================================================================================//
 CellLinkedList::CellLinkedList(BoundingBox tentative_bounds, Real grid_spacing,
                                BaseParticles &base_particles, SPHAdaptation &sph_adaptation)
-    : BaseCellLinkedList(base_particles, sph_adaptation), mesh_(nullptr)
+    : BaseCellLinkedList(base_particles, sph_adaptation), mesh_(nullptr), search_depth_(Arrayi::Ones())
 {
     mesh_ = mesh_ptrs_keeper_.createPtr<Mesh>(tentative_bounds, grid_spacing, 2);
     meshes_.push_back(mesh_);
@@ -140,6 +140,7 @@ class NeighborSearch : public Mesh
   protected:
     UnsignedInt *particle_index_;
     UnsignedInt *cell_offset_;
+    Arrayi search_depth_;
 };
 
 /**
@@ -151,6 +152,7 @@ class CellLinkedList : public BaseCellLinkedList
 {
   protected:
     Mesh *mesh_;
+    Arrayi search_depth_; /**< number of cells searched on each side along each axis */
 
   public:
     CellLinkedList(BoundingBox tentative_bounds, Real grid_spacing,
@@ -170,6 +172,9 @@ class CellLinkedList : public BaseCellLinkedList
     template <class ExecutionPolicy>
     NeighborSearch createNeighborSearch(const ExecutionPolicy &ex_policy);
     UnsignedInt getCellOffsetListSize() { return cell_offset_list_size_; };
+    /** Cells smaller than the cut-off radius along some axes are searched deeper, only used by the CK neighbor search. */
+    void setSearchDepth(const Arrayi &search_depth) { search_depth_ = search_depth; };
+    Arrayi SearchDepth() { return search_depth_; };
 
     /** split algorithm */;
     template <class LocalDynamicsFunction>
@@ -187,7 +187,8 @@ template <class ExecutionPolicy>
 NeighborSearch::NeighborSearch(const ExecutionPolicy &ex_policy, CellLinkedList &cell_linked_list)
     : Mesh(cell_linked_list.getMesh()),
       particle_index_(cell_linked_list.dvParticleIndex()->DelegatedData(ex_policy)),
-      cell_offset_(cell_linked_list.dvCellOffset()->DelegatedData(ex_policy)) {}
+      cell_offset_(cell_linked_list.dvCellOffset()->DelegatedData(ex_policy)),
+      search_depth_(cell_linked_list.SearchDepth()) {}
 //=================================================================================================//
 template <typename FunctionOnEach>
 void NeighborSearch::forEachSearch(UnsignedInt source_index, const Vecd *source_pos,
@@ -195,8 +196,8 @@ void NeighborSearch::forEachSearch(UnsignedInt source_index, const Vecd *source_
 {
     const Arrayi target_cell_index = CellIndexFromPosition(source_pos[source_index]);
     mesh_for_each(
-        Arrayi::Zero().max(target_cell_index - Arrayi::Ones()),
-        all_cells_.min(target_cell_index + 2 * Arrayi::Ones()),
+        Arrayi::Zero().max(target_cell_index - search_depth_),
+        all_cells_.min(target_cell_index + search_depth_ + Arrayi::Ones()),
         [&](const Arrayi &cell_index)
         {
             const UnsignedInt linear_index = LinearCellIndexFromCellIndex(cell_index);
@@ -136,6 +136,7 @@ class ReduceDynamics : public LocalDynamicsType,
           BaseDynamics<ReturnType>(){};
     virtual ~ReduceDynamics(){};
     std::string QuantityName() { return this->quantity_name_; };
+    auto &getDynamicsIdentifier() { return this->identifier_; };
 
     virtual ReturnType exec(Real dt = 0.0) override
     {
@@ -147,6 +148,60 @@ class ReduceDynamics : public LocalDynamicsType,
     };
 };
 
+/**
+ * @class ReduceDynamicsGroup
+ * @brief Evaluates several reduce dynamics on the same particles in one particle pass.
+ * The reduced values are combined as a tuple with heterogeneous operations
+ * and returned in the order of the given dynamics,
+ * which remain usable separately.
+ */
+template <class ExecutionPolicy, class... LocalDynamicsTypes>
+class ReduceDynamicsGroup
+    : public BaseDynamics<std::tuple<typename LocalDynamicsTypes::ReturnType...>>
+{
+    using ReturnType = std::tuple<typename LocalDynamicsTypes::ReturnType...>;
+    using Operation = ReduceTuple<typename LocalDynamicsTypes::OperationType...>;
+    std::tuple<ReduceDynamics<LocalDynamicsTypes, ExecutionPolicy> &...> reduce_dynamics_;
+
+  public:
+    explicit ReduceDynamicsGroup(ReduceDynamics<LocalDynamicsTypes, ExecutionPolicy> &...reduce_dynamics)
+        : BaseDynamics<ReturnType>(), reduce_dynamics_(reduce_dynamics...)
+    {
+        std::apply(
+            [](auto &first, auto &...others)
+            {
+                if (((static_cast<void *>(&others.getDynamicsIdentifier()) !=
+                      static_cast<void *>(&first.getDynamicsIdentifier())) ||
+                     ...))
+                {
+                    std::cout << "\n Error: the grouped reduce dynamics are not on the same particles!" << std::endl;
+                    std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+                    exit(1);
+                }
+            },
+            reduce_dynamics_);
+    };
+    virtual ~ReduceDynamicsGroup(){};
+
+    virtual ReturnType exec(Real dt = 0.0) override
+    {
+        return execGroup(dt, std::index_sequence_for<LocalDynamicsTypes...>{});
+    };
+
+  protected:
+    template <size_t... Is>
+    ReturnType execGroup(Real dt, std::index_sequence<Is...>)
+    {
+        (std::get<Is>(reduce_dynamics_).setupDynamics(dt), ...);
+        ReturnType temp = particle_reduce(
+            ExecutionPolicy(), std::get<0>(reduce_dynamics_).getDynamicsIdentifier().LoopRange(),
+            ReturnType(std::get<Is>(reduce_dynamics_).Reference()...), Operation(),
+            [&](size_t i) -> ReturnType
+            { return ReturnType(std::get<Is>(reduce_dynamics_).reduce(i, dt)...); });
+        return ReturnType(std::get<Is>(reduce_dynamics_).outputResult(std::get<Is>(temp))...);
+    };
+};
+
 /**
  * @class BaseInteractionDynamics
  * @brief This is the base class for particle interaction with other particles
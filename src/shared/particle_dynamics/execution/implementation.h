@@ -35,6 +35,7 @@
 #include "execution_policy.h"
 #include "loop_range.h"
 #include "ownership.h"
+#include "sphinxsys_variable.h"
 
 namespace SPH
 {
@@ -119,9 +120,9 @@ class Implementation<ExecutionPolicy, LocalDynamicsType, ComputingKernelType>
             copyComputingKernel(ExecutionPolicy{}, temp_kernel, computing_kernel_);
             this->setUpdated();
         }
-
-        if (!this->isUpdated())
+        else if (!this->isUpdated() || VariableAccessRecorder::isRecording())
         {
+            // the kernel is rebuilt when recording so that the delegated variables are found
             overwriteComputingKernel(std::forward<Args>(args)...);
         }
 
@@ -40,6 +40,7 @@ namespace SPH
 //----------------------------------------------------------------------
 class Internal;            /**< A interaction considering the internal flows */
 class FreeSurface;         /**< A interaction considering the effect of free surface */
+class SmearedSurface;      /**< A interaction considering free surface only within the smeared surface layer */
 class FreeStream;          /**< A interaction considering the effect of free stream */
 class AngularConservative; /**< A interaction considering the conservation of angular momentum */
 
@@ -20,18 +20,30 @@ void EulerianCompressibleIntegration1stHalf<RiemannSolverType>::interaction(size
     Real energy_per_volume_i = E_[index_i] / Vol_[index_i];
     CompressibleFluidState state_i(rho_[index_i], vel_[index_i], p_[index_i], energy_per_volume_i);
     Vecd momentum_change_rate = force_prior_[index_i];
+    CompressibleFluidStateBatch batch;
     Neighborhood &inner_neighborhood = inner_configuration_[index_i];
-    for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+    for (size_t n0 = 0; n0 < inner_neighborhood.current_size_; n0 += batch.capacity_)
     {
-        size_t index_j = inner_neighborhood.j_[n];
-        Real dW_ijV_j = inner_neighborhood.dW_ij_[n] * Vol_[index_j];
-        Vecd &e_ij = inner_neighborhood.e_ij_[n];
+        batch.size_ = SMIN(inner_neighborhood.current_size_ - n0, batch.capacity_);
+        for (size_t k = 0; k != batch.size_; ++k)
+        {
+            size_t index_j = inner_neighborhood.j_[n0 + k];
+            Real energy_per_volume_j = E_[index_j] / Vol_[index_j];
+            CompressibleFluidState state_j(rho_[index_j], vel_[index_j], p_[index_j], energy_per_volume_j);
+            batch.setPair(k, state_i, state_j, inner_neighborhood.e_ij_[n0 + k]);
+        }
+        riemann_solver_.getInterfaceStates(batch);
 
-        Real energy_per_volume_j = E_[index_j] / Vol_[index_j];
-        CompressibleFluidState state_j(rho_[index_j], vel_[index_j], p_[index_j], energy_per_volume_j);
-        CompressibleFluidStarState interface_state = riemann_solver_.getInterfaceState(state_i, state_j, e_ij);
-        Matd convect_flux = interface_state.rho_ * interface_state.vel_ * interface_state.vel_.transpose();
-        momentum_change_rate -= 2.0 * Vol_[index_i] * dW_ijV_j * (convect_flux + interface_state.p_ * Matd::Identity()) * e_ij;
+        for (size_t k = 0; k != batch.size_; ++k)
+        {
+            size_t index_j = inner_neighborhood.j_[n0 + k];
+            Real dW_ijV_j = inner_neighborhood.dW_ij_[n0 + k] * Vol_[index_j];
+            Vecd &e_ij = inner_neighborhood.e_ij_[n0 + k];
+
+            CompressibleFluidStarState interface_state = batch.InterfaceState(k);
+            Matd convect_flux = interface_state.rho_ * interface_state.vel_ * interface_state.vel_.transpose();
+            momentum_change_rate -= 2.0 * Vol_[index_i] * dW_ijV_j * (convect_flux + interface_state.p_ * Matd::Identity()) * e_ij;
+        }
     }
     force_[index_i] = momentum_change_rate;
 }
@@ -56,19 +68,30 @@ void EulerianCompressibleIntegration2ndHalf<RiemannSolverType>::interaction(size
     CompressibleFluidState state_i(rho_[index_i], vel_[index_i], p_[index_i], energy_per_volume_i);
     Real mass_change_rate = 0.0;
     Real energy_change_rate = force_prior_[index_i].dot(vel_[index_i]); // TODO: not conservative formulation
+    CompressibleFluidStateBatch batch;
     Neighborhood &inner_neighborhood = inner_configuration_[index_i];
-    for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+    for (size_t n0 = 0; n0 < inner_neighborhood.current_size_; n0 += batch.capacity_)
     {
-        size_t index_j = inner_neighborhood.j_[n];
-        Vecd &e_ij = inner_neighborhood.e_ij_[n];
-        Real dW_ijV_j = inner_neighborhood.dW_ij_[n] * Vol_[index_j];
+        batch.size_ = SMIN(inner_neighborhood.current_size_ - n0, batch.capacity_);
+        for (size_t k = 0; k != batch.size_; ++k)
+        {
+            size_t index_j = inner_neighborhood.j_[n0 + k];
+            Real energy_per_volume_j = E_[index_j] / Vol_[index_j];
+            CompressibleFluidState state_j(rho_[index_j], vel_[index_j], p_[index_j], energy_per_volume_j);
+            batch.setPair(k, state_i, state_j, inner_neighborhood.e_ij_[n0 + k]);
+        }
+        riemann_solver_.getInterfaceStates(batch);
 
-        Real energy_per_volume_j = E_[index_j] / Vol_[index_j];
-        CompressibleFluidState state_j(rho_[index_j], vel_[index_j], p_[index_j], energy_per_volume_j);
-        CompressibleFluidStarState interface_state = riemann_solver_.getInterfaceState(state_i, state_j, e_ij);
+        for (size_t k = 0; k != batch.size_; ++k)
+        {
+            size_t index_j = inner_neighborhood.j_[n0 + k];
+            Vecd &e_ij = inner_neighborhood.e_ij_[n0 + k];
+            Real dW_ijV_j = inner_neighborhood.dW_ij_[n0 + k] * Vol_[index_j];
 
-        mass_change_rate -= 2.0 * Vol_[index_i] * dW_ijV_j * (interface_state.rho_ * interface_state.vel_).dot(e_ij);
-        energy_change_rate -= 2.0 * Vol_[index_i] * dW_ijV_j * ((interface_state.E_ + interface_state.p_) * interface_state.vel_).dot(e_ij);
+            CompressibleFluidStarState interface_state = batch.InterfaceState(k);
+            mass_change_rate -= 2.0 * Vol_[index_i] * dW_ijV_j * (interface_state.rho_ * interface_state.vel_).dot(e_ij);
+            energy_change_rate -= 2.0 * Vol_[index_i] * dW_ijV_j * ((interface_state.E_ + interface_state.p_) * interface_state.vel_).dot(e_ij);
+        }
     }
     dmass_dt_[index_i] = mass_change_rate;
     dE_dt_[index_i] = energy_change_rate;
@@ -28,18 +28,29 @@ void EulerianIntegration1stHalf<Inner<>, RiemannSolverType>::interaction(size_t
 {
     FluidStateIn state_i(rho_[index_i], vel_[index_i], p_[index_i]);
     Vecd momentum_change_rate = Vecd::Zero();
+    FluidStateBatch batch;
     Neighborhood &inner_neighborhood = inner_configuration_[index_i];
-    for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+    for (size_t n0 = 0; n0 < inner_neighborhood.current_size_; n0 += batch.capacity_)
     {
-        size_t index_j = inner_neighborhood.j_[n];
-        Real dW_ijV_j = inner_neighborhood.dW_ij_[n] * Vol_[index_j];
-        Vecd &e_ij = inner_neighborhood.e_ij_[n];
+        batch.size_ = SMIN(inner_neighborhood.current_size_ - n0, batch.capacity_);
+        for (size_t k = 0; k != batch.size_; ++k)
+        {
+            size_t index_j = inner_neighborhood.j_[n0 + k];
+            FluidStateIn state_j(rho_[index_j], vel_[index_j], p_[index_j]);
+            batch.setPair(k, state_i, state_j, inner_neighborhood.e_ij_[n0 + k]);
+        }
+        riemann_solver_.InterfaceStates(batch);
+
+        for (size_t k = 0; k != batch.size_; ++k)
+        {
+            size_t index_j = inner_neighborhood.j_[n0 + k];
+            Real dW_ijV_j = inner_neighborhood.dW_ij_[n0 + k] * Vol_[index_j];
+            Vecd &e_ij = inner_neighborhood.e_ij_[n0 + k];
 
-        FluidStateIn state_j(rho_[index_j], vel_[index_j], p_[index_j]);
-        FluidStateOut interface_state = riemann_solver_.InterfaceState(state_i, state_j, e_ij);
-        Matd convect_flux = interface_state.rho_ * interface_state.vel_ * interface_state.vel_.transpose();
-        
-        momentum_change_rate -= 2.0 * Vol_[index_i] * (convect_flux + interface_state.p_ * Matd::Identity()) * e_ij * dW_ijV_j;
+            FluidStateOut interface_state = batch.InterfaceState(k);
+            Matd convect_flux = interface_state.rho_ * interface_state.vel_ * interface_state.vel_.transpose();
+            momentum_change_rate -= 2.0 * Vol_[index_i] * (convect_flux + interface_state.p_ * Matd::Identity()) * e_ij * dW_ijV_j;
+        }
     }
     dmom_dt_[index_i] = momentum_change_rate;
 }
@@ -62,25 +73,37 @@ void EulerianIntegration1stHalf<Contact<Wall>, RiemannSolverType>::interaction(s
 {
     FluidStateIn state_i(rho_[index_i], vel_[index_i], p_[index_i]);
     Vecd momentum_change_rate = Vecd::Zero();
+    FluidStateBatch batch;
     for (size_t k = 0; k < contact_configuration_.size(); ++k)
     {
         Vecd *n_k = wall_n_[k];
         Real *Vol_k = wall_Vol_[k];
         Vecd *vel_ave_k = wall_vel_ave_[k];
         Neighborhood &wall_neighborhood = (*contact_configuration_[k])[index_i];
-        for (size_t n = 0; n != wall_neighborhood.current_size_; ++n)
+        for (size_t n0 = 0; n0 < wall_neighborhood.current_size_; n0 += batch.capacity_)
         {
-            size_t index_j = wall_neighborhood.j_[n];
-            Vecd &e_ij = wall_neighborhood.e_ij_[n];
-            Real dW_ijV_j = wall_neighborhood.dW_ij_[n] * Vol_k[index_j];
+            batch.size_ = SMIN(wall_neighborhood.current_size_ - n0, batch.capacity_);
+            for (size_t m = 0; m != batch.size_; ++m)
+            {
+                size_t index_j = wall_neighborhood.j_[n0 + m];
+                Vecd vel_j_in_wall = 2.0 * vel_ave_k[index_j] - state_i.vel_;
+                Real p_j_in_wall = state_i.p_;
+                Real rho_in_wall = state_i.rho_;
+                FluidStateIn state_j(rho_in_wall, vel_j_in_wall, p_j_in_wall);
+                batch.setPair(m, state_i, state_j, n_k[index_j]);
+            }
+            riemann_solver_.InterfaceStates(batch);
 
-            Vecd vel_j_in_wall = 2.0 * vel_ave_k[index_j] - state_i.vel_;
-            Real p_j_in_wall = state_i.p_;
-            Real rho_in_wall = state_i.rho_;
-            FluidStateIn state_j(rho_in_wall, vel_j_in_wall, p_j_in_wall);
-            FluidStateOut interface_state = riemann_solver_.InterfaceState(state_i, state_j, n_k[index_j]);
-            Matd convect_flux = interface_state.rho_ * interface_state.vel_ * interface_state.vel_.transpose();
-            momentum_change_rate -= 2.0 * Vol_[index_i] * (convect_flux + interface_state.p_ * Matd::Identity()) * e_ij * dW_ijV_j;
+            for (size_t m = 0; m != batch.size_; ++m)
+            {
+                size_t index_j = wall_neighborhood.j_[n0 + m];
+                Vecd &e_ij = wall_neighborhood.e_ij_[n0 + m];
+                Real dW_ijV_j = wall_neighborhood.dW_ij_[n0 + m] * Vol_k[index_j];
+
+                FluidStateOut interface_state = batch.InterfaceState(m);
+                Matd convect_flux = interface_state.rho_ * interface_state.vel_ * interface_state.vel_.transpose();
+                momentum_change_rate -= 2.0 * Vol_[index_i] * (convect_flux + interface_state.p_ * Matd::Identity()) * e_ij * dW_ijV_j;
+            }
         }
     }
     dmom_dt_[index_i] += momentum_change_rate;
@@ -97,17 +120,28 @@ void EulerianIntegration2ndHalf<Inner<>, RiemannSolverType>::interaction(size_t
 {
     FluidStateIn state_i(rho_[index_i], vel_[index_i], p_[index_i]);
     Real mass_change_rate = 0.0;
+    FluidStateBatch batch;
     Neighborhood &inner_neighborhood = inner_configuration_[index_i];
-    for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+    for (size_t n0 = 0; n0 < inner_neighborhood.current_size_; n0 += batch.capacity_)
     {
-        size_t index_j = inner_neighborhood.j_[n];
-        Vecd &e_ij = inner_neighborhood.e_ij_[n];
-        Real dW_ijV_j = inner_neighborhood.dW_ij_[n] * Vol_[index_j];
+        batch.size_ = SMIN(inner_neighborhood.current_size_ - n0, batch.capacity_);
+        for (size_t k = 0; k != batch.size_; ++k)
+        {
+            size_t index_j = inner_neighborhood.j_[n0 + k];
+            FluidStateIn state_j(rho_[index_j], vel_[index_j], p_[index_j]);
+            batch.setPair(k, state_i, state_j, inner_neighborhood.e_ij_[n0 + k]);
+        }
+        riemann_solver_.InterfaceStates(batch);
 
-        FluidStateIn state_j(rho_[index_j], vel_[index_j], p_[index_j]);
-        FluidStateOut interface_state = riemann_solver_.InterfaceState(state_i, state_j, e_ij);
-        
-        mass_change_rate -= 2.0 * Vol_[index_i] * (interface_state.rho_ * interface_state.vel_).dot(e_ij) * dW_ijV_j;
+        for (size_t k = 0; k != batch.size_; ++k)
+        {
+            size_t index_j = inner_neighborhood.j_[n0 + k];
+            Vecd &e_ij = inner_neighborhood.e_ij_[n0 + k];
+            Real dW_ijV_j = inner_neighborhood.dW_ij_[n0 + k] * Vol_[index_j];
+
+            FluidStateOut interface_state = batch.InterfaceState(k);
+            mass_change_rate -= 2.0 * Vol_[index_i] * (interface_state.rho_ * interface_state.vel_).dot(e_ij) * dW_ijV_j;
+        }
     }
     dmass_dt_[index_i] = mass_change_rate;
 }
@@ -131,25 +165,36 @@ void EulerianIntegration2ndHalf<Contact<Wall>, RiemannSolverType>::interaction(s
 {
     FluidStateIn state_i(this->rho_[index_i], this->vel_[index_i], this->p_[index_i]);
     Real mass_change_rate = 0.0;
+    FluidStateBatch batch;
     for (size_t k = 0; k < contact_configuration_.size(); ++k)
     {
         Vecd *n_k = this->wall_n_[k];
         Real *Vol_k = this->wall_Vol_[k];
         Vecd *vel_ave_k = wall_vel_ave_[k];
         Neighborhood &wall_neighborhood = (*contact_configuration_[k])[index_i];
-        for (size_t n = 0; n != wall_neighborhood.current_size_; ++n)
+        for (size_t n0 = 0; n0 < wall_neighborhood.current_size_; n0 += batch.capacity_)
         {
-            size_t index_j = wall_neighborhood.j_[n];
-            Vecd &e_ij = wall_neighborhood.e_ij_[n];
-            Real dW_ijV_j = wall_neighborhood.dW_ij_[n] * Vol_k[index_j];
+            batch.size_ = SMIN(wall_neighborhood.current_size_ - n0, batch.capacity_);
+            for (size_t m = 0; m != batch.size_; ++m)
+            {
+                size_t index_j = wall_neighborhood.j_[n0 + m];
+                Vecd vel_j_in_wall = 2.0 * vel_ave_k[index_j] - state_i.vel_;
+                Real p_j_in_wall = state_i.p_;
+                Real rho_in_wall = state_i.rho_;
+                FluidStateIn state_j(rho_in_wall, vel_j_in_wall, p_j_in_wall);
+                batch.setPair(m, state_i, state_j, n_k[index_j]);
+            }
+            this->riemann_solver_.InterfaceStates(batch);
 
-            Vecd vel_j_in_wall = 2.0 * vel_ave_k[index_j] - state_i.vel_;
-            Real p_j_in_wall = state_i.p_;
-            Real rho_in_wall = state_i.rho_;
+            for (size_t m = 0; m != batch.size_; ++m)
+            {
+                size_t index_j = wall_neighborhood.j_[n0 + m];
+                Vecd &e_ij = wall_neighborhood.e_ij_[n0 + m];
+                Real dW_ijV_j = wall_neighborhood.dW_ij_[n0 + m] * Vol_k[index_j];
 
-            FluidStateIn state_j(rho_in_wall, vel_j_in_wall, p_j_in_wall);
-            FluidStateOut interface_state = this->riemann_solver_.InterfaceState(state_i, state_j, n_k[index_j]);
-            mass_change_rate -= 2.0 * this->Vol_[index_i] * (interface_state.rho_ * interface_state.vel_).dot(e_ij) * dW_ijV_j;
+                FluidStateOut interface_state = batch.InterfaceState(m);
+                mass_change_rate -= 2.0 * this->Vol_[index_i] * (interface_state.rho_ * interface_state.vel_).dot(e_ij) * dW_ijV_j;
+            }
         }
     }
     this->dmass_dt_[index_i] += mass_change_rate;
@@ -3,6 +3,27 @@
 namespace SPH
 {
 //=================================================================================================//
+inline Real selectWaveState(bool is_left, bool is_left_star, bool is_right_star, bool is_right,
+                            Real left, Real left_star, Real right_star, Real right)
+{
+    // masked selection without branches, the later waves take precedence as in the scalar solvers
+    Real state = is_left ? left : Real(0);
+    state = is_left_star ? left_star : state;
+    state = is_right_star ? right_star : state;
+    return is_right ? right : state;
+}
+//=================================================================================================//
+inline void getSoundSpeeds(CompressibleFluid &compressible_fluid_i, CompressibleFluid &compressible_fluid_j,
+                           const CompressibleFluidStateBatch &batch, Real *c_i, Real *c_j)
+{
+    // the equation of state is evaluated ahead of the lane loops which are then free of virtual calls
+    for (size_t k = 0; k < batch.size_; ++k)
+    {
+        c_i[k] = compressible_fluid_i.getSoundSpeed(batch.p_i_[k], batch.rho_i_[k]);
+        c_j[k] = compressible_fluid_j.getSoundSpeed(batch.p_j_[k], batch.rho_j_[k]);
+    }
+}
+//=================================================================================================//
 NoRiemannSolverInCompressibleEulerianMethod::
     NoRiemannSolverInCompressibleEulerianMethod(CompressibleFluid &compressible_fluid_i,
                                                 CompressibleFluid &compressible_fluid_j)
@@ -19,6 +40,18 @@ CompressibleFluidStarState NoRiemannSolverInCompressibleEulerianMethod::
     return CompressibleFluidStarState(rho_star, v_star, p_star, energy_star);
 }
 //=================================================================================================//
+void NoRiemannSolverInCompressibleEulerianMethod::getInterfaceStates(CompressibleFluidStateBatch &batch)
+{
+    for (size_t k = 0; k < batch.size_; ++k)
+    {
+        batch.p_star_[k] = 0.5 * (batch.p_i_[k] + batch.p_j_[k]);
+        batch.rho_star_[k] = 0.5 * (batch.rho_i_[k] + batch.rho_j_[k]);
+        batch.E_star_[k] = 0.5 * (batch.E_i_[k] + batch.E_j_[k]);
+        for (int d = 0; d != Dimensions; ++d)
+            batch.vel_star_[d][k] = 0.5 * (batch.vel_i_[d][k] + batch.vel_j_[d][k]);
+    }
+}
+//=================================================================================================//
 HLLCRiemannSolver::HLLCRiemannSolver(CompressibleFluid &compressible_fluid_i,
                                      CompressibleFluid &compressible_fluid_j, Real limiter_parameter)
     : compressible_fluid_i_(compressible_fluid_i), compressible_fluid_j_(compressible_fluid_j){};
@@ -69,6 +102,58 @@ CompressibleFluidStarState HLLCRiemannSolver::
     return CompressibleFluidStarState(rho_star, v_star, p_star, energy_star);
 }
 //=================================================================================================//
+void HLLCRiemannSolver::getInterfaceStates(CompressibleFluidStateBatch &batch)
+{
+    Real c_i[CompressibleFluidStateBatch::capacity_], c_j[CompressibleFluidStateBatch::capacity_];
+    getSoundSpeeds(compressible_fluid_i_, compressible_fluid_j_, batch, c_i, c_j);
+    for (size_t k = 0; k < batch.size_; ++k)
+    {
+        Real rho_i = batch.rho_i_[k];
+        Real p_i = batch.p_i_[k];
+        Real E_i = batch.E_i_[k];
+        Real rho_j = batch.rho_j_[k];
+        Real p_j = batch.p_j_[k];
+        Real E_j = batch.E_j_[k];
+
+        Real ul = 0.0;
+        Real ur = 0.0;
+        for (int d = 0; d != Dimensions; ++d)
+        {
+            ul -= batch.e_ij_[d][k] * batch.vel_i_[d][k];
+            ur -= batch.e_ij_[d][k] * batch.vel_j_[d][k];
+        }
+        Real s_l = ul - c_i[k];
+        Real s_r = ur + c_j[k];
+        Real s_star = (rho_j * ur * (s_r - ur) + rho_i * ul * (ul - s_l) + p_i - p_j) /
+                      (rho_j * (s_r - ur) + rho_i * (ul - s_l));
+
+        bool is_left = 0.0 < s_l;
+        bool is_left_star = (s_l <= 0.0) & (0.0 <= s_star);
+        bool is_right_star = (s_star <= 0.0) & (0.0 <= s_r);
+        bool is_right = s_r < 0.0;
+
+        Real p_lr_star = p_i + rho_i * (s_l - ul) * (s_star - ul);
+        Real rho_l_star = rho_i * (s_l - ul) / (s_l - s_star);
+        Real rho_r_star = rho_j * (s_r - ur) / (s_r - s_star);
+        Real energy_l_star = rho_i * (s_l - ul) / (s_l - s_star) *
+                             (E_i / rho_i + (s_star - ul) * (s_star + p_i / rho_i / (s_l - ul)));
+        Real energy_r_star = rho_j * (s_r - ur) / (s_r - s_star) *
+                             (E_j / rho_j + (s_star - ur) * (s_star + p_j / rho_j / (s_r - ur)));
+
+        batch.p_star_[k] = selectWaveState(is_left, is_left_star, is_right_star, is_right, p_i, p_lr_star, p_lr_star, p_j);
+        batch.rho_star_[k] = selectWaveState(is_left, is_left_star, is_right_star, is_right, rho_i, rho_l_star, rho_r_star, rho_j);
+        batch.E_star_[k] = selectWaveState(is_left, is_left_star, is_right_star, is_right, E_i, energy_l_star, energy_r_star, E_j);
+        for (int d = 0; d != Dimensions; ++d)
+        {
+            Real vel_i = batch.vel_i_[d][k];
+            Real vel_j = batch.vel_j_[d][k];
+            batch.vel_star_[d][k] = selectWaveState(is_left, is_left_star, is_right_star, is_right, vel_i,
+                                                    vel_i - batch.e_ij_[d][k] * (s_star - ul),
+                                                    vel_j - batch.e_ij_[d][k] * (s_star - ur), vel_j);
+        }
+    }
+}
+//=================================================================================================//
 HLLCWithLimiterRiemannSolver::
     HLLCWithLimiterRiemannSolver(CompressibleFluid &compressible_fluid_i,
                                  CompressibleFluid &compressible_fluid_j, Real limiter_parameter)
@@ -146,4 +231,75 @@ CompressibleFluidStarState HLLCWithLimiterRiemannSolver::
     return CompressibleFluidStarState(rho_star, v_star, p_star, energy_star);
 }
 //=================================================================================================//
+void HLLCWithLimiterRiemannSolver::getInterfaceStates(CompressibleFluidStateBatch &batch)
+{
+    Real c_i[CompressibleFluidStateBatch::capacity_], c_j[CompressibleFluidStateBatch::capacity_];
+    getSoundSpeeds(compressible_fluid_i_, compressible_fluid_j_, batch, c_i, c_j);
+    for (size_t k = 0; k < batch.size_; ++k)
+    {
+        Real rho_i = batch.rho_i_[k];
+        Real p_i = batch.p_i_[k];
+        Real E_i = batch.E_i_[k];
+        Real rho_j = batch.rho_j_[k];
+        Real p_j = batch.p_j_[k];
+        Real E_j = batch.E_j_[k];
+
+        Real ul = 0.0;
+        Real ur = 0.0;
+        for (int d = 0; d != Dimensions; ++d)
+        {
+            ul -= batch.e_ij_[d][k] * batch.vel_i_[d][k];
+            ur -= batch.e_ij_[d][k] * batch.vel_j_[d][k];
+        }
+        Real vl_squared_norm = 0.0;
+        Real vr_squared_norm = 0.0;
+        for (int d = 0; d != Dimensions; ++d)
+        {
+            Real vl = batch.vel_i_[d][k] - ul * (-batch.e_ij_[d][k]);
+            Real vr = batch.vel_j_[d][k] - ur * (-batch.e_ij_[d][k]);
+            vl_squared_norm += vl * vl;
+            vr_squared_norm += vr * vr;
+        }
+        Real R_lf = rho_j / rho_i;
+        Real u_tilde = (ul + ur * R_lf) / (1.0 + R_lf);
+        Real v_tilde = (std::sqrt(vl_squared_norm) + std::sqrt(vr_squared_norm) * R_lf) / (1.0 + R_lf);
+        Real q_tilde = u_tilde;
+        Real hl = (E_i + p_i) / rho_i;
+        Real hr = (E_j + p_j) / rho_j;
+        Real h_tilde = (hl + hr * R_lf) / (1.0 + R_lf);
+        Real sound_tilde = std::sqrt((1.4 - 1.0) * (h_tilde - 0.5 * (u_tilde * u_tilde + v_tilde * v_tilde)));
+        Real s_l = SMIN(ul - c_i[k], q_tilde - sound_tilde);
+        Real s_r = SMAX(ur + c_j[k], q_tilde + sound_tilde);
+
+        Real clr = (c_i[k] * rho_i + c_j[k] * rho_j) / (rho_i + rho_j);
+        Real limiter = SMIN(limiter_parameter_ * SMAX((ul - ur) / clr, Real(0)), Real(1));
+        Real s_star = (p_j - p_i) * (limiter * limiter) / (rho_i * (s_l - ul) - rho_j * (s_r - ur)) +
+                      (rho_i * (s_l - ul) * ul - rho_j * (s_r - ur) * ur) / (rho_i * (s_l - ul) - rho_j * (s_r - ur));
+
+        bool is_left = 0.0 < s_l;
+        bool is_left_star = (s_l <= 0.0) & (0.0 <= s_star);
+        bool is_right_star = (s_star <= 0.0) & (0.0 <= s_r);
+        bool is_right = s_r < 0.0;
+
+        Real p_lr_star = 0.5 * (p_i + p_j) +
+                         0.5 * (rho_i * (s_l - ul) * (s_star - ul) + rho_j * (s_r - ur) * (s_star - ur)) * limiter;
+        Real rho_l_star = rho_i * (s_l - ul) / (s_l - s_star);
+        Real rho_r_star = rho_j * (s_r - ur) / (s_r - s_star);
+        Real energy_l_star = ((s_l - ul) * E_i - p_i * ul + p_lr_star * s_star) / (s_l - s_star);
+        Real energy_r_star = ((s_r - ur) * E_j - p_j * ur + p_lr_star * s_star) / (s_r - s_star);
+
+        batch.p_star_[k] = selectWaveState(is_left, is_left_star, is_right_star, is_right, p_i, p_lr_star, p_lr_star, p_j);
+        batch.rho_star_[k] = selectWaveState(is_left, is_left_star, is_right_star, is_right, rho_i, rho_l_star, rho_r_star, rho_j);
+        batch.E_star_[k] = selectWaveState(is_left, is_left_star, is_right_star, is_right, E_i, energy_l_star, energy_r_star, E_j);
+        for (int d = 0; d != Dimensions; ++d)
+        {
+            Real vel_i = batch.vel_i_[d][k];
+            Real vel_j = batch.vel_j_[d][k];
+            batch.vel_star_[d][k] = selectWaveState(is_left, is_left_star, is_right_star, is_right, vel_i,
+                                                    vel_i - batch.e_ij_[d][k] * (s_star - ul),
+                                                    vel_j - batch.e_ij_[d][k] * (s_star - ur), vel_j);
+        }
+    }
+}
+//=================================================================================================//
 } // namespace SPH
@@ -50,6 +50,27 @@ struct CompressibleFluidStarState : FluidStateOut
     CompressibleFluidStarState(Real rho, Vecd vel, Real p, Real E)
         : FluidStateOut(rho, vel, p), E_(E){};
 };
+/**
+ * @struct CompressibleFluidStateBatch
+ * @brief  The states of a block of particle pairs with energy for batched Riemann solvers in compressible flow.
+ */
+struct CompressibleFluidStateBatch : FluidStateBatch
+{
+    Real E_i_[capacity_], E_j_[capacity_], E_star_[capacity_];
+
+    void setPair(size_t k, const CompressibleFluidState &state_i, const CompressibleFluidState &state_j, const Vecd &e_ij)
+    {
+        FluidStateBatch::setPair(k, state_i, state_j, e_ij);
+        E_i_[k] = state_i.E_;
+        E_j_[k] = state_j.E_;
+    };
+
+    CompressibleFluidStarState InterfaceState(size_t k)
+    {
+        FluidStateOut state = FluidStateBatch::InterfaceState(k);
+        return CompressibleFluidStarState(state.rho_, state.vel_, state.p_, E_star_[k]);
+    };
+};
 
 /**
  * @struct NoRiemannSolverInCompressibleEulerianMethod
@@ -62,6 +83,7 @@ class NoRiemannSolverInCompressibleEulerianMethod
   public:
     NoRiemannSolverInCompressibleEulerianMethod(CompressibleFluid &fluid_i, CompressibleFluid &fluid_j);
     CompressibleFluidStarState getInterfaceState(const CompressibleFluidState &state_i, const CompressibleFluidState &state_j, const Vecd &e_ij);
+    void getInterfaceStates(CompressibleFluidStateBatch &batch);
 };
 
 /**
@@ -75,6 +97,7 @@ class HLLCRiemannSolver
   public:
     HLLCRiemannSolver(CompressibleFluid &compressible_fluid_i, CompressibleFluid &compressible_fluid_j, Real limiter_parameter = 0.0);
     CompressibleFluidStarState getInterfaceState(const CompressibleFluidState &state_i, const CompressibleFluidState &state_j, const Vecd &e_ij);
+    void getInterfaceStates(CompressibleFluidStateBatch &batch);
 };
 /**
  * @struct HLLCWithLimiterRiemannSolver
@@ -88,6 +111,7 @@ class HLLCWithLimiterRiemannSolver
   public:
     HLLCWithLimiterRiemannSolver(CompressibleFluid &compressible_fluid_i, CompressibleFluid &compressible_fluid_j, Real limiter_parameter = 1.0);
     CompressibleFluidStarState getInterfaceState(const CompressibleFluidState &state_i, const CompressibleFluidState &state_j, const Vecd &e_ij);
+    void getInterfaceStates(CompressibleFluidStateBatch &batch);
 };
 } // namespace SPH
 #endif // EULERIAN_RIEMANN_SOLVER_H
@@ -0,0 +1,75 @@
+#include "eulerian_steady_state.h"
+
+namespace SPH
+{
+namespace fluid_dynamics
+{
+//=================================================================================================//
+EulerianImplicitLUSGS::EulerianImplicitLUSGS(BaseInnerRelation &inner_relation, Real pseudo_time_cfl)
+    : EulerianIntegration<DataDelegateInner>(inner_relation),
+      pseudo_time_cfl_(pseudo_time_cfl),
+      pseudo_dt_(particles_->registerStateVariable<Real>("PseudoTimeStep")),
+      diagonal_(particles_->registerStateVariable<Real>("ImplicitDiagonal")),
+      delta_rho_(particles_->registerStateVariable<Real>("DensityIncrement")),
+      delta_mom_(particles_->registerStateVariable<Vecd>("MomentumDensityIncrement")) {}
+//=================================================================================================//
+Real EulerianImplicitLUSGS::spectralRadius(size_t index_i, size_t index_j, const Vecd &n_ij)
+{
+    Real lambda_i = ABS(vel_[index_i].dot(n_ij)) + fluid_.getSoundSpeed(p_[index_i], rho_[index_i]);
+    Real lambda_j = ABS(vel_[index_j].dot(n_ij)) + fluid_.getSoundSpeed(p_[index_j], rho_[index_j]);
+    return SMAX(lambda_i, lambda_j);
+}
+//=================================================================================================//
+void EulerianImplicitLUSGS::initialization(size_t index_i, Real dt)
+{
+    Real spectral_radius_sum = 0.0;
+    const Neighborhood &inner_neighborhood = inner_configuration_[index_i];
+    for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+    {
+        size_t index_j = inner_neighborhood.j_[n];
+        Real area = -2.0 * Vol_[index_i] * Vol_[index_j] * inner_neighborhood.dW_ij_[n];
+        spectral_radius_sum += spectralRadius(index_i, index_j, -inner_neighborhood.e_ij_[n]) * area;
+    }
+    pseudo_dt_[index_i] = pseudo_time_cfl_ * Vol_[index_i] / (spectral_radius_sum + TinyReal);
+    diagonal_[index_i] = Vol_[index_i] / pseudo_dt_[index_i] + 0.5 * spectral_radius_sum;
+    delta_rho_[index_i] = 0.0;
+    delta_mom_[index_i] = Vecd::Zero();
+}
+//=================================================================================================//
+void EulerianImplicitLUSGS::interaction(size_t index_i, Real dt)
+{
+    Real mass_residual = dmass_dt_[index_i];
+    Vecd momentum_residual = dmom_dt_[index_i] + force_prior_[index_i];
+    const Neighborhood &inner_neighborhood = inner_configuration_[index_i];
+    for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+    {
+        size_t index_j = inner_neighborhood.j_[n];
+        Vecd n_ij = -inner_neighborhood.e_ij_[n];
+        Real half_area = -Vol_[index_i] * Vol_[index_j] * inner_neighborhood.dW_ij_[n];
+        Real lambda = spectralRadius(index_i, index_j, n_ij);
+
+        Vecd mom_density_j = rho_[index_j] * vel_[index_j];
+        Real rho_j_new = rho_[index_j] + delta_rho_[index_j];
+        Vecd mom_density_j_new = mom_density_j + delta_mom_[index_j];
+        Real p_j_new = fluid_.getPressure(rho_j_new);
+        Vecd momentum_flux_change = mom_density_j_new * mom_density_j_new.dot(n_ij) / rho_j_new + p_j_new * n_ij -
+                                    mom_density_j * vel_[index_j].dot(n_ij) - p_[index_j] * n_ij;
+
+        mass_residual -= half_area * (delta_mom_[index_j].dot(n_ij) - lambda * delta_rho_[index_j]);
+        momentum_residual -= half_area * (momentum_flux_change - lambda * delta_mom_[index_j]);
+    }
+    delta_rho_[index_i] = mass_residual / diagonal_[index_i];
+    delta_mom_[index_i] = momentum_residual / diagonal_[index_i];
+}
+//=================================================================================================//
+void EulerianImplicitLUSGS::update(size_t index_i, Real dt)
+{
+    mom_[index_i] = Vol_[index_i] * (rho_[index_i] * vel_[index_i] + delta_mom_[index_i]);
+    rho_[index_i] += delta_rho_[index_i];
+    mass_[index_i] = rho_[index_i] * Vol_[index_i];
+    vel_[index_i] = mom_[index_i] / mass_[index_i];
+    p_[index_i] = fluid_.getPressure(rho_[index_i]);
+}
+//=================================================================================================//
+} // namespace fluid_dynamics
+} // namespace SPH
@@ -0,0 +1,120 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	eulerian_steady_state.h
+ * @brief 	Implicit pseudo-time marching of weakly compressible Eulerian flows to steady state.
+ * @details The mass and momentum residuals are given by the Eulerian integration without update.
+ *			The pseudo-time step of each particle is from the local CFL condition
+ *			given by the spectral radii of the pair fluxes, i.e. local time stepping.
+ *			The implicit system is approximated by the lower-upper symmetric Gauss-Seidel (LU-SGS)
+ *			factorization with the Rusanov flux Jacobian, which is a symmetric Gauss-Seidel sweep
+ *			with zero initial increments. The particles are colored on the inner neighbor topology,
+ *			which is the cell-face topology for FVM, so that the sweep is parallel within each color.
+ *			The density residual is monitored for the automatic stop.
+ *			The wall contributions, if any, are only included in the residuals.
+ * @author	Xiangyu Hu
+ */
+#ifndef EULERIAN_STEADY_STATE_H
+#define EULERIAN_STEADY_STATE_H
+
+#include "eulerian_fluid_integration.hpp"
+
+namespace SPH
+{
+namespace fluid_dynamics
+{
+/**
+ * @class EulerianImplicitLUSGS
+ * @brief The local pseudo-time step, the point relaxation of the implicit system
+ * and the update of the conservative variables.
+ */
+class EulerianImplicitLUSGS : public EulerianIntegration<DataDelegateInner>
+{
+  public:
+    explicit EulerianImplicitLUSGS(BaseInnerRelation &inner_relation, Real pseudo_time_cfl = 5.0);
+    virtual ~EulerianImplicitLUSGS() {};
+    void setPseudoTimeCFL(Real pseudo_time_cfl) { pseudo_time_cfl_ = pseudo_time_cfl; };
+    /** Local pseudo-time step and diagonal of the implicit system with zero increments. */
+    void initialization(size_t index_i, Real dt = 0.0);
+    /** Point relaxation with the latest increments of the neighbors. */
+    void interaction(size_t index_i, Real dt = 0.0);
+    void update(size_t index_i, Real dt = 0.0);
+    Real DensityChangeRateSquare(size_t index_i)
+    {
+        Real drho_dt = dmass_dt_[index_i] / Vol_[index_i];
+        return drho_dt * drho_dt;
+    };
+
+  protected:
+    Real pseudo_time_cfl_;
+    Real *pseudo_dt_, *diagonal_, *delta_rho_;
+    Vecd *delta_mom_;
+
+    Real spectralRadius(size_t index_i, size_t index_j, const Vecd &n_ij);
+};
+
+/**
+ * @class EulerianSteadyStateLUSGS
+ * @brief One implicit pseudo-time step, including the residuals, with the particles colored at the first execution.
+ * The step is repeated until isConverged().
+ */
+template <class MomentumResidualType, class MassResidualType>
+class EulerianSteadyStateLUSGS : public BaseDynamics<void>
+{
+  public:
+    /** The arguments after the inner relation are for the residuals. */
+    template <typename... Args>
+    explicit EulerianSteadyStateLUSGS(BaseInnerRelation &inner_relation, Args &&...args);
+    virtual ~EulerianSteadyStateLUSGS() {};
+    virtual void exec(Real dt = 0.0) override;
+    void setTolerance(Real tolerance) { tolerance_ = tolerance; };
+    void setPseudoTimeCFL(Real pseudo_time_cfl) { implicit_lusgs_.setPseudoTimeCFL(pseudo_time_cfl); };
+    /** Root mean square of the density change rate before the last step. */
+    Real ResidualNorm() { return residual_norm_; };
+    Real RelativeResidual() { return residual_norm_ / (reference_residual_norm_ + TinyReal); };
+    size_t NumberOfIterations() { return number_of_iterations_; };
+    size_t NumberOfColors() { return color_lists_.size(); };
+    bool isConverged() { return number_of_iterations_ != 0 && RelativeResidual() < tolerance_; };
+
+  protected:
+    SPHBody &sph_body_;
+    BaseParticles &particles_;
+    ParticleConfiguration &inner_configuration_;
+    MomentumResidualType momentum_residual_;
+    MassResidualType mass_residual_;
+    EulerianImplicitLUSGS implicit_lusgs_;
+    Real tolerance_;
+    Real residual_norm_, reference_residual_norm_;
+    size_t number_of_iterations_;
+    StdVec<IndexVector> color_lists_;
+
+    /** Greedy coloring so that no neighbors share a color. */
+    void colorParticles();
+};
+using EulerianSteadyStateLUSGSInnerRiemann =
+    EulerianSteadyStateLUSGS<EulerianIntegration1stHalfInnerRiemann, EulerianIntegration2ndHalfInnerRiemann>;
+using EulerianSteadyStateLUSGSWithWallRiemann =
+    EulerianSteadyStateLUSGS<EulerianIntegration1stHalfWithWallRiemann, EulerianIntegration2ndHalfWithWallRiemann>;
+} // namespace fluid_dynamics
+} // namespace SPH
+#endif // EULERIAN_STEADY_STATE_H
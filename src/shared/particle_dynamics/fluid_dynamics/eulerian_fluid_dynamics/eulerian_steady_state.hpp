@@ -0,0 +1,96 @@
+#ifndef EULERIAN_STEADY_STATE_HPP
+#define EULERIAN_STEADY_STATE_HPP
+
+#include "eulerian_steady_state.h"
+
+namespace SPH
+{
+namespace fluid_dynamics
+{
+//=================================================================================================//
+template <class MomentumResidualType, class MassResidualType>
+template <typename... Args>
+EulerianSteadyStateLUSGS<MomentumResidualType, MassResidualType>::
+    EulerianSteadyStateLUSGS(BaseInnerRelation &inner_relation, Args &&...args)
+    : BaseDynamics<void>(), sph_body_(inner_relation.getSPHBody()),
+      particles_(sph_body_.getBaseParticles()),
+      inner_configuration_(inner_relation.inner_configuration_),
+      momentum_residual_(inner_relation, args...), mass_residual_(inner_relation, args...),
+      implicit_lusgs_(inner_relation), tolerance_(1.0e-6),
+      residual_norm_(0.0), reference_residual_norm_(0.0), number_of_iterations_(0) {}
+//=================================================================================================//
+template <class MomentumResidualType, class MassResidualType>
+void EulerianSteadyStateLUSGS<MomentumResidualType, MassResidualType>::colorParticles()
+{
+    size_t total_real_particles = particles_.TotalRealParticles();
+    StdVec<size_t> colors(total_real_particles, 0);
+    StdVec<bool> is_color_taken;
+    for (size_t index_i = 0; index_i != total_real_particles; ++index_i)
+    {
+        is_color_taken.assign(color_lists_.size() + 1, false);
+        const Neighborhood &inner_neighborhood = inner_configuration_[index_i];
+        for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+        {
+            size_t index_j = inner_neighborhood.j_[n];
+            if (index_j < index_i)
+                is_color_taken[colors[index_j]] = true;
+        }
+
+        size_t color = 0;
+        while (is_color_taken[color])
+            ++color;
+        if (color == color_lists_.size())
+            color_lists_.push_back(IndexVector());
+        colors[index_i] = color;
+        color_lists_[color].push_back(index_i);
+    }
+}
+//=================================================================================================//
+template <class MomentumResidualType, class MassResidualType>
+void EulerianSteadyStateLUSGS<MomentumResidualType, MassResidualType>::exec(Real dt)
+{
+    if (color_lists_.empty())
+        colorParticles();
+
+    IndexRange real_particles(0, particles_.TotalRealParticles());
+    particle_for(execution::ParallelPolicy(), real_particles,
+                 [&](size_t i)
+                 { momentum_residual_.interaction(i, dt); });
+    particle_for(execution::ParallelPolicy(), real_particles,
+                 [&](size_t i)
+                 { mass_residual_.interaction(i, dt); });
+    particle_for(execution::ParallelPolicy(), real_particles,
+                 [&](size_t i)
+                 { implicit_lusgs_.initialization(i); });
+    Real residual_sum = particle_reduce(execution::ParallelPolicy(), real_particles, Real(0), ReduceSum<Real>(),
+                                        [&](size_t i) -> Real
+                                        { return implicit_lusgs_.DensityChangeRateSquare(i); });
+    residual_norm_ = sqrt(residual_sum / Real(real_particles.size()));
+    if (number_of_iterations_ == 0)
+        reference_residual_norm_ = residual_norm_;
+
+    // lower sweep
+    for (size_t k = 0; k != color_lists_.size(); ++k)
+    {
+        particle_for(execution::ParallelPolicy(), color_lists_[k],
+                     [&](size_t i)
+                     { implicit_lusgs_.interaction(i); });
+    }
+    // upper sweep
+    for (size_t k = color_lists_.size(); k != 0; --k)
+    {
+        particle_for(execution::ParallelPolicy(), color_lists_[k - 1],
+                     [&](size_t i)
+                     { implicit_lusgs_.interaction(i); });
+    }
+
+    particle_for(execution::ParallelPolicy(), real_particles,
+                 [&](size_t i)
+                 { implicit_lusgs_.update(i); });
+    number_of_iterations_++;
+    setUpdated(sph_body_);
+}
+//=================================================================================================//
+} // namespace fluid_dynamics
+} // namespace SPH
+#endif // EULERIAN_STEADY_STATE_HPP
@@ -57,9 +57,119 @@ void StaticConfinementIntegration2ndHalf::update(size_t index_i, Real dt)
     drho_dt_[index_i] += rho_[index_i] * (vel_[index_i] - vel_j_in_wall).dot(kernel_gradient);
 }
 //=================================================================================================//
+KernelIntegralTable::KernelIntegralTable(NearShapeSurface &near_surface, int sub_cell_number)
+    : mesh_(DynamicCast<CellLinkedList>(
+                this, DynamicCast<RealBody>(this, near_surface.getSPHBody()).getCellLinkedList())
+                .getMesh()),
+      sub_cell_number_(sub_cell_number), sub_cell_spacing_(mesh_.GridSpacing() / Real(sub_cell_number)),
+      nodes_per_cell_(1), number_of_tabulated_cells_(0),
+      dv_table_index_(unique_variable_ptrs_.createPtr<DiscreteVariable<UnsignedInt>>(
+          "KernelIntegralTableIndex", mesh_.NumberOfCells(), [](size_t i)
+          { return 0; })),
+      dv_kernel_integral_(nullptr), dv_kernel_gradient_integral_(nullptr)
+{
+    for (int k = 0; k != Dimensions; ++k)
+        nodes_per_cell_ *= sub_cell_number_ + 1;
+
+    UnsignedInt *table_index = dv_table_index_->Data();
+    UnsignedInt *cell_list = near_surface.dvCellList()->Data();
+    StdVec<Arrayi> tabulated_cells;
+    for (size_t n = 0; n != near_surface.dvCellList()->getDataSize(); ++n)
+    {
+        Arrayi cell_index = mesh_.transfer1DtoMeshIndex(mesh_.AllCells(), cell_list[n]);
+        mesh_for_each(
+            Arrayi::Zero().max(cell_index - Arrayi::Ones()),
+            mesh_.AllCells().min(cell_index + 2 * Arrayi::Ones()),
+            [&](const Arrayi &neighbor_cell_index)
+            {
+                size_t linear_index = mesh_.LinearCellIndexFromCellIndex(neighbor_cell_index);
+                if (table_index[linear_index] == 0)
+                {
+                    tabulated_cells.push_back(neighbor_cell_index);
+                    table_index[linear_index] = tabulated_cells.size();
+                }
+            });
+    }
+    number_of_tabulated_cells_ = tabulated_cells.size();
+
+    size_t total_nodes = number_of_tabulated_cells_ * nodes_per_cell_;
+    dv_kernel_integral_ = unique_variable_ptrs_.createPtr<DiscreteVariable<Real>>("KernelIntegral", total_nodes);
+    dv_kernel_gradient_integral_ =
+        unique_variable_ptrs_.createPtr<DiscreteVariable<Vecd>>("KernelGradientIntegral", total_nodes);
+    Real *kernel_integral = dv_kernel_integral_->Data();
+    Vecd *kernel_gradient_integral = dv_kernel_gradient_integral_->Data();
+    LevelSetShape &level_set_shape = near_surface.getLevelSetShape();
+    parallel_for(
+        IndexRange(0, number_of_tabulated_cells_),
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                Vecd cell_lower_corner =
+                    mesh_.MeshLowerBound() + tabulated_cells[i].cast<Real>().matrix() * mesh_.GridSpacing();
+                for (UnsignedInt l = 0; l != nodes_per_cell_; ++l)
+                {
+                    Arrayi node_index = Arrayi::Zero();
+                    UnsignedInt remainder = l;
+                    for (int k = Dimensions - 1; k >= 0; --k)
+                    {
+                        node_index[k] = remainder % (sub_cell_number_ + 1);
+                        remainder /= sub_cell_number_ + 1;
+                    }
+                    Vecd node_position = cell_lower_corner + node_index.cast<Real>().matrix() * sub_cell_spacing_;
+                    size_t node = i * nodes_per_cell_ + l;
+                    kernel_integral[node] = level_set_shape.computeKernelIntegral(node_position);
+                    kernel_gradient_integral[node] = level_set_shape.computeKernelGradientIntegral(node_position);
+                }
+            }
+        },
+        ap);
+}
+//=================================================================================================//
 StaticConfinement::StaticConfinement(NearShapeSurface &near_surface)
     : density_summation_(near_surface), pressure_relaxation_(near_surface),
       density_relaxation_(near_surface), surface_bounding_(near_surface) {}
 //=================================================================================================//
+CachedStaticConfinementDensity::
+    CachedStaticConfinementDensity(NearShapeSurface &near_surface, KernelIntegralTable &kernel_integral_table)
+    : StaticConfinementDensity(near_surface),
+      kernel_integral_table_(execution::ParallelPolicy(), kernel_integral_table) {}
+//=================================================================================================//
+void CachedStaticConfinementDensity::update(size_t index_i, Real dt)
+{
+    Real inv_Vol_0_i = rho0_ / mass_[index_i];
+    rho_sum_[index_i] +=
+        kernel_integral_table_.KernelIntegral(pos_[index_i]) * inv_Vol_0_i * rho0_ * inv_sigma0_;
+}
+//=================================================================================================//
+CachedStaticConfinementIntegration1stHalf::
+    CachedStaticConfinementIntegration1stHalf(NearShapeSurface &near_surface, KernelIntegralTable &kernel_integral_table)
+    : StaticConfinementIntegration1stHalf(near_surface),
+      kernel_integral_table_(execution::ParallelPolicy(), kernel_integral_table) {}
+//=================================================================================================//
+void CachedStaticConfinementIntegration1stHalf::update(size_t index_i, Real dt)
+{
+    Vecd kernel_gradient = kernel_integral_table_.KernelGradientIntegral(pos_[index_i]);
+    force_[index_i] -= 2.0 * mass_[index_i] * p_[index_i] * kernel_gradient / rho_[index_i];
+}
+//=================================================================================================//
+CachedStaticConfinementIntegration2ndHalf::
+    CachedStaticConfinementIntegration2ndHalf(NearShapeSurface &near_surface, KernelIntegralTable &kernel_integral_table)
+    : StaticConfinementIntegration2ndHalf(near_surface),
+      kernel_integral_table_(execution::ParallelPolicy(), kernel_integral_table) {}
+//=================================================================================================//
+void CachedStaticConfinementIntegration2ndHalf::update(size_t index_i, Real dt)
+{
+    Vecd kernel_gradient = kernel_integral_table_.KernelGradientIntegral(pos_[index_i]);
+    Vecd vel_j_in_wall = -vel_[index_i];
+    drho_dt_[index_i] += rho_[index_i] * (vel_[index_i] - vel_j_in_wall).dot(kernel_gradient);
+}
+//=================================================================================================//
+CachedStaticConfinement::CachedStaticConfinement(NearShapeSurface &near_surface, int sub_cell_number)
+    : kernel_integral_table_(near_surface, sub_cell_number),
+      density_summation_(near_surface, kernel_integral_table_),
+      pressure_relaxation_(near_surface, kernel_integral_table_),
+      density_relaxation_(near_surface, kernel_integral_table_), surface_bounding_(near_surface) {}
+//=================================================================================================//
 } // namespace fluid_dynamics
 } // namespace SPH
@@ -94,6 +94,98 @@ class StaticConfinementIntegration2ndHalf : public BaseLocalDynamics<BodyPartByC
     AcousticRiemannSolver riemann_solver_;
 };
 
+/**
+ * @class KernelIntegralTable
+ * @brief The kernel integral and its gradient of the level-set shape tabulated
+ * at the nodes of a sub-cell grid in the cells near the shape surface,
+ * so that they are obtained by a single multi-linear interpolation
+ * instead of probing the multilevel level set.
+ * The near-surface cells and their neighboring cells are tabulated,
+ * as a particle may have moved into a neighboring cell since the last update of the cell linked list.
+ * Out of the tabulated cells, the particles are beyond the kernel support from the surface
+ * and the integrals are zero.
+ * Note that the level-set probe is only piecewise smooth, and the sub-cell grid should be
+ * finer than the level-set data to follow it closely.
+ * The memory is (sub_cell_number + 1)^Dimensions nodes for each tabulated cell.
+ */
+class KernelIntegralTable
+{
+    UniquePtrsKeeper<Entity> unique_variable_ptrs_;
+
+  public:
+    explicit KernelIntegralTable(NearShapeSurface &near_surface, int sub_cell_number = 8);
+    ~KernelIntegralTable() {};
+    size_t NumberOfTabulatedCells() { return number_of_tabulated_cells_; };
+
+    class ComputingKernel
+    {
+      public:
+        template <class ExecutionPolicy>
+        ComputingKernel(const ExecutionPolicy &ex_policy, KernelIntegralTable &encloser)
+            : mesh_(encloser.mesh_), sub_cell_number_(encloser.sub_cell_number_),
+              sub_cell_spacing_(encloser.sub_cell_spacing_), nodes_per_cell_(encloser.nodes_per_cell_),
+              table_index_(encloser.dv_table_index_->DelegatedData(ex_policy)),
+              kernel_integral_(encloser.dv_kernel_integral_->DelegatedData(ex_policy)),
+              kernel_gradient_integral_(encloser.dv_kernel_gradient_integral_->DelegatedData(ex_policy)) {};
+
+        Real KernelIntegral(const Vecd &position) { return interpolate(kernel_integral_, position); };
+        Vecd KernelGradientIntegral(const Vecd &position) { return interpolate(kernel_gradient_integral_, position); };
+
+      protected:
+        Mesh mesh_;
+        int sub_cell_number_;
+        Real sub_cell_spacing_;
+        UnsignedInt nodes_per_cell_;
+        UnsignedInt *table_index_;
+        Real *kernel_integral_;
+        Vecd *kernel_gradient_integral_;
+
+        template <typename DataType>
+        DataType interpolate(DataType *node_data, const Vecd &position)
+        {
+            Arrayi cell_index = mesh_.CellIndexFromPosition(position);
+            UnsignedInt table_index = table_index_[mesh_.LinearCellIndexFromCellIndex(cell_index)];
+            if (table_index == 0)
+                return ZeroData<DataType>::value;
+
+            DataType *cell_data = node_data + (table_index - 1) * nodes_per_cell_;
+            Vecd cell_lower_corner = mesh_.MeshLowerBound() + cell_index.cast<Real>().matrix() * mesh_.GridSpacing();
+            Vecd local_position = (position - cell_lower_corner) / sub_cell_spacing_;
+            Arrayi node_index = floor(local_position.array())
+                                    .cast<int>()
+                                    .max(Arrayi::Zero())
+                                    .min((sub_cell_number_ - 1) * Arrayi::Ones());
+            Vecd alpha = (local_position - node_index.cast<Real>().matrix()).cwiseMax(0.0).cwiseMin(1.0);
+
+            DataType result = ZeroData<DataType>::value;
+            for (int corner = 0; corner != (1 << Dimensions); ++corner)
+            {
+                Real weight = 1.0;
+                UnsignedInt linear_index = 0;
+                for (int k = 0; k != Dimensions; ++k)
+                {
+                    int shift = (corner >> k) & 1;
+                    weight *= shift == 1 ? alpha[k] : 1.0 - alpha[k];
+                    linear_index = linear_index * (sub_cell_number_ + 1) + node_index[k] + shift;
+                }
+                result += weight * cell_data[linear_index];
+            }
+            return result;
+        };
+    };
+
+  protected:
+    Mesh mesh_;
+    int sub_cell_number_;
+    Real sub_cell_spacing_;
+    UnsignedInt nodes_per_cell_;
+    size_t number_of_tabulated_cells_;
+    /** The table index plus one of each cell of the cell linked list, zero for the cells not tabulated. */
+    DiscreteVariable<UnsignedInt> *dv_table_index_;
+    DiscreteVariable<Real> *dv_kernel_integral_;
+    DiscreteVariable<Vecd> *dv_kernel_gradient_integral_;
+};
+
 /**
  * @class StaticConfinement
  * @brief Static confined boundary condition for complex structures.
@@ -110,6 +202,71 @@ class StaticConfinement
     virtual ~StaticConfinement(){};
 };
 
+/**
+ * @class CachedStaticConfinementDensity
+ * @brief static confinement condition for density summation with the tabulated kernel integral
+ */
+class CachedStaticConfinementDensity : public StaticConfinementDensity
+{
+  public:
+    CachedStaticConfinementDensity(NearShapeSurface &near_surface, KernelIntegralTable &kernel_integral_table);
+    virtual ~CachedStaticConfinementDensity(){};
+    void update(size_t index_i, Real dt = 0.0);
+
+  protected:
+    KernelIntegralTable::ComputingKernel kernel_integral_table_;
+};
+
+/**
+ * @class CachedStaticConfinementIntegration1stHalf
+ * @brief static confinement condition for pressure relaxation with the tabulated kernel gradient integral
+ */
+class CachedStaticConfinementIntegration1stHalf : public StaticConfinementIntegration1stHalf
+{
+  public:
+    CachedStaticConfinementIntegration1stHalf(NearShapeSurface &near_surface, KernelIntegralTable &kernel_integral_table);
+    virtual ~CachedStaticConfinementIntegration1stHalf(){};
+    void update(size_t index_i, Real dt = 0.0);
+
+  protected:
+    KernelIntegralTable::ComputingKernel kernel_integral_table_;
+};
+
+/**
+ * @class CachedStaticConfinementIntegration2ndHalf
+ * @brief static confinement condition for density relaxation with the tabulated kernel gradient integral
+ */
+class CachedStaticConfinementIntegration2ndHalf : public StaticConfinementIntegration2ndHalf
+{
+  public:
+    CachedStaticConfinementIntegration2ndHalf(NearShapeSurface &near_surface, KernelIntegralTable &kernel_integral_table);
+    virtual ~CachedStaticConfinementIntegration2ndHalf(){};
+    void update(size_t index_i, Real dt = 0.0);
+
+  protected:
+    KernelIntegralTable::ComputingKernel kernel_integral_table_;
+};
+
+/**
+ * @class CachedStaticConfinement
+ * @brief Static confined boundary condition with the kernel integrals tabulated once
+ * in the cells near the surface. The surface bounding is the same as StaticConfinement.
+ */
+class CachedStaticConfinement
+{
+    KernelIntegralTable kernel_integral_table_;
+
+  public:
+    SimpleDynamics<CachedStaticConfinementDensity> density_summation_;
+    SimpleDynamics<CachedStaticConfinementIntegration1stHalf> pressure_relaxation_;
+    SimpleDynamics<CachedStaticConfinementIntegration2ndHalf> density_relaxation_;
+    SimpleDynamics<ShapeSurfaceBounding> surface_bounding_;
+
+    CachedStaticConfinement(NearShapeSurface &near_surface, int sub_cell_number = 8);
+    virtual ~CachedStaticConfinement(){};
+    KernelIntegralTable &getKernelIntegralTable() { return kernel_integral_table_; };
+};
+
 } // namespace fluid_dynamics
 } // namespace SPH
 #endif // SHAPE_CONFINEMENT_H
\ No newline at end of file
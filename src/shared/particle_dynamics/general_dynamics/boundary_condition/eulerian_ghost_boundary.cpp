@@ -10,53 +10,75 @@ GhostCreationInESPH::GhostCreationInESPH(BaseInnerRelation &inner_relation, Ghos
       indicator_(particles_->getVariableDataByName<int>("Indicator")),
       Vol_(particles_->getVariableDataByName<Real>("VolumetricMeasure")),
       pos_(particles_->getVariableDataByName<Vecd>("Position")),
-      ghost_bound_(ghost_boundary.GhostBound())
+      number_of_generations_(0), ghost_bound_(ghost_boundary.GhostBound())
 {
     ghostGenerationAndAddToConfiguration();
 };
 //=================================================================================================//
 void GhostCreationInESPH::ghostGenerationAndAddToConfiguration()
 {
-    ghost_bound_.second = ghost_bound_.first;
-    RealAndGhostParticleData real_and_ghost_necessary_data;
-
-    for (size_t index_i = 0; index_i != particles_->TotalRealParticles(); ++index_i)
-    {
-        if (indicator_[index_i] == 1)
+    size_t total_real_particles = particles_->TotalRealParticles();
+    StdVec<size_t> ghost_offsets(total_real_particles, 0);
+    size_t total_ghosts = parallel_scan(
+        IndexRange(0, total_real_particles), size_t(0),
+        [&](const IndexRange &r, size_t sum, bool is_final_scan) -> size_t
         {
-            Vecd gradient_summation = Vecd::Zero();
-            Neighborhood &inner_neighborhood = inner_configuration_[index_i];
-            for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+            for (size_t index_i = r.begin(); index_i != r.end(); ++index_i)
             {
-                size_t index_j = inner_neighborhood.j_[n];
-                Real dW_ijV_j = inner_neighborhood.dW_ij_[n] * Vol_[index_j];
-                gradient_summation += dW_ijV_j * inner_neighborhood.e_ij_[n];
+                if (is_final_scan)
+                    ghost_offsets[index_i] = sum;
+                if (indicator_[index_i] == 1)
+                    sum++;
             }
-            Real ghost_particle_dW_ijV_j = -gradient_summation.norm();
-            Vecd ghost_particle_eij = -gradient_summation / ghost_particle_dW_ijV_j;
-            Real distance_to_ghost = fabs(sph_body_.getInitialShape().findSignedDistance(pos_[index_i]));
-            Vecd displacement_to_ghost = distance_to_ghost * ghost_particle_eij;
-            Vecd ghost_position = pos_[index_i] - displacement_to_ghost;
-            mutex_create_ghost_particle_.lock();
-            size_t ghost_particle_index = ghost_bound_.second;
-            ghost_bound_.second++;
-            ghost_boundary_.checkWithinGhostSize(ghost_bound_);
-            particles_->updateGhostParticle(ghost_particle_index, index_i);
-            // Here, we ensure the volume as the same the real particle
-            Vol_[ghost_particle_index] = Vol_[index_i];
-            pos_[ghost_particle_index] = ghost_position;
-            mutex_create_ghost_particle_.unlock();
-            Real double_distance_to_ghost = 2.0 * distance_to_ghost;
-            Real ghost_particle_dW_ij = ghost_particle_dW_ijV_j / (Vol_[ghost_particle_index] + TinyReal);
-            get_inner_neighbor_(inner_neighborhood, double_distance_to_ghost, ghost_particle_dW_ij, ghost_particle_eij, ghost_particle_index);
+            return sum;
+        },
+        [](size_t a, size_t b)
+        { return a + b; });
 
-            // add all necessary data of real particle and corresponding ghost particle
-            real_and_ghost_necessary_data.real_index_ = index_i;
-            real_and_ghost_necessary_data.ghost_index_ = ghost_particle_index;
-            real_and_ghost_necessary_data.e_ij_ghost_ = ghost_particle_eij;
-            real_and_ghost_particle_data_.push_back(real_and_ghost_necessary_data);
-        }
-    }
+    ghost_bound_.second = ghost_bound_.first + total_ghosts;
+    ghost_boundary_.checkWithinGhostSize(ghost_bound_);
+    real_and_ghost_particle_data_.resize(total_ghosts);
+
+    parallel_for(
+        IndexRange(0, total_real_particles),
+        [&](const IndexRange &r)
+        {
+            for (size_t index_i = r.begin(); index_i != r.end(); ++index_i)
+            {
+                if (indicator_[index_i] == 1)
+                {
+                    Vecd gradient_summation = Vecd::Zero();
+                    Neighborhood &inner_neighborhood = inner_configuration_[index_i];
+                    for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+                    {
+                        size_t index_j = inner_neighborhood.j_[n];
+                        Real dW_ijV_j = inner_neighborhood.dW_ij_[n] * Vol_[index_j];
+                        gradient_summation += dW_ijV_j * inner_neighborhood.e_ij_[n];
+                    }
+                    Real ghost_particle_dW_ijV_j = -gradient_summation.norm();
+                    Vecd ghost_particle_eij = -gradient_summation / ghost_particle_dW_ijV_j;
+                    Real distance_to_ghost = fabs(sph_body_.getInitialShape().findSignedDistance(pos_[index_i]));
+                    Vecd displacement_to_ghost = distance_to_ghost * ghost_particle_eij;
+                    Vecd ghost_position = pos_[index_i] - displacement_to_ghost;
+                    size_t ghost_particle_index = ghost_bound_.first + ghost_offsets[index_i];
+                    particles_->updateGhostParticle(ghost_particle_index, index_i);
+                    // Here, we ensure the volume as the same the real particle
+                    Vol_[ghost_particle_index] = Vol_[index_i];
+                    pos_[ghost_particle_index] = ghost_position;
+                    Real double_distance_to_ghost = 2.0 * distance_to_ghost;
+                    Real ghost_particle_dW_ij = ghost_particle_dW_ijV_j / (Vol_[ghost_particle_index] + TinyReal);
+                    get_inner_neighbor_(inner_neighborhood, double_distance_to_ghost, ghost_particle_dW_ij, ghost_particle_eij, ghost_particle_index);
+
+                    // add all necessary data of real particle and corresponding ghost particle
+                    RealAndGhostParticleData &real_and_ghost_necessary_data = real_and_ghost_particle_data_[ghost_offsets[index_i]];
+                    real_and_ghost_necessary_data.real_index_ = index_i;
+                    real_and_ghost_necessary_data.ghost_index_ = ghost_particle_index;
+                    real_and_ghost_necessary_data.e_ij_ghost_ = ghost_particle_eij;
+                }
+            }
+        },
+        ap);
+    number_of_generations_++;
 }
 //=================================================================================================//
 GhostBoundaryConditionSetupInESPH::
@@ -68,47 +90,101 @@ GhostBoundaryConditionSetupInESPH::
       vel_(particles_->getVariableDataByName<Vecd>("Velocity")),
       pos_(particles_->getVariableDataByName<Vecd>("Position")),
       mom_(particles_->getVariableDataByName<Vecd>("Momentum")),
-      ghost_bound_(ghost_creation.ghost_bound_),
+      ghost_bound_(ghost_creation.ghost_bound_), ghost_creation_(ghost_creation),
       real_and_ghost_particle_data_(ghost_creation.real_and_ghost_particle_data_),
       boundary_type_(particles_->registerStateVariable<int>("BoundaryType")),
-      W0_(sph_body_.getSPHAdaptation().getKernel()->W0(ZeroVecd))
+      W0_(sph_body_.getSPHAdaptation().getKernel()->W0(ZeroVecd)),
+      number_of_ghost_generations_(ghost_creation.NumberOfGenerations())
+{
+    updateBoundaryTypes();
+}
+//=================================================================================================//
+void GhostBoundaryConditionSetupInESPH::updateBoundaryTypes()
 {
     setupBoundaryTypes();
+    sortGhostsByBoundaryType();
+}
+//=================================================================================================//
+void GhostBoundaryConditionSetupInESPH::sortGhostsByBoundaryType()
+{
+    size_t total_ghosts = real_and_ghost_particle_data_.size();
+    size_t number_of_boundary_types = 0;
+    for (size_t ghost_number = 0; ghost_number != total_ghosts; ++ghost_number)
+    {
+        int boundary_type = boundary_type_[real_and_ghost_particle_data_[ghost_number].real_index_];
+        number_of_boundary_types = SMAX(number_of_boundary_types, size_t(SMAX(boundary_type, 0)) + 1);
+    }
+
+    boundary_type_offsets_.assign(number_of_boundary_types + 1, 0);
+    for (size_t ghost_number = 0; ghost_number != total_ghosts; ++ghost_number)
+    {
+        int boundary_type = boundary_type_[real_and_ghost_particle_data_[ghost_number].real_index_];
+        if (boundary_type >= 0)
+            boundary_type_offsets_[boundary_type + 1]++;
+    }
+    for (size_t boundary_type = 0; boundary_type != number_of_boundary_types; ++boundary_type)
+    {
+        boundary_type_offsets_[boundary_type + 1] += boundary_type_offsets_[boundary_type];
+    }
+
+    sorted_ghost_data_.resize(boundary_type_offsets_.back());
+    StdVec<size_t> insert_position(boundary_type_offsets_.begin(), boundary_type_offsets_.end() - 1);
+    for (size_t ghost_number = 0; ghost_number != total_ghosts; ++ghost_number)
+    {
+        int boundary_type = boundary_type_[real_and_ghost_particle_data_[ghost_number].real_index_];
+        if (boundary_type >= 0)
+            sorted_ghost_data_[insert_position[boundary_type]++] = real_and_ghost_particle_data_[ghost_number];
+    }
 }
 //=================================================================================================//
 void GhostBoundaryConditionSetupInESPH::resetBoundaryConditions()
 {
-    for (size_t ghost_number = 0; ghost_number != real_and_ghost_particle_data_.size(); ++ghost_number)
+    // the boundary types of the recreated ghosts are set up again
+    if (number_of_ghost_generations_ != ghost_creation_.NumberOfGenerations())
+    {
+        updateBoundaryTypes();
+        number_of_ghost_generations_ = ghost_creation_.NumberOfGenerations();
+    }
+
+    for (size_t boundary_type = 0; boundary_type + 1 < boundary_type_offsets_.size(); ++boundary_type)
     {
-        size_t index_i = real_and_ghost_particle_data_[ghost_number].real_index_;
-        size_t ghost_index = real_and_ghost_particle_data_[ghost_number].ghost_index_;
-        Vecd e_ig = real_and_ghost_particle_data_[ghost_number].e_ij_ghost_;
+        if (boundary_type_offsets_[boundary_type] == boundary_type_offsets_[boundary_type + 1])
+            continue;
 
-        // Dispatch the appropriate boundary condition
-        switch (boundary_type_[index_i])
+        // Dispatch the appropriate boundary condition once for all ghosts of this type
+        switch (boundary_type)
         {
         case 3: // this refer to the different types of wall boundary conditions
-            applyNonSlipWallBoundary(ghost_index, index_i);
-            applyReflectiveWallBoundary(ghost_index, index_i, e_ig);
+            applyToBoundaryType(boundary_type, [&](size_t ghost_index, size_t index_i, const Vecd &e_ig)
+                                {
+                                    applyNonSlipWallBoundary(ghost_index, index_i);
+                                    applyReflectiveWallBoundary(ghost_index, index_i, e_ig); });
             break;
         case 4:
-            applyTopBoundary(ghost_index, index_i);
+            applyToBoundaryType(boundary_type, [&](size_t ghost_index, size_t index_i, const Vecd &e_ig)
+                                { applyTopBoundary(ghost_index, index_i); });
             break;
         case 5:
-            applyPressureOutletBC(ghost_index, index_i);
+            applyToBoundaryType(boundary_type, [&](size_t ghost_index, size_t index_i, const Vecd &e_ig)
+                                { applyPressureOutletBC(ghost_index, index_i); });
             break;
         case 7:
-            applySymmetryBoundary(ghost_index, index_i, e_ig);
+            applyToBoundaryType(boundary_type, [&](size_t ghost_index, size_t index_i, const Vecd &e_ig)
+                                { applySymmetryBoundary(ghost_index, index_i, e_ig); });
             break;
         case 9:
-            applyFarFieldBoundary(ghost_index, index_i);
+            applyToBoundaryType(boundary_type, [&](size_t ghost_index, size_t index_i, const Vecd &e_ig)
+                                { applyFarFieldBoundary(ghost_index, index_i); });
             break;
         case 10:
-            applyGivenValueInletFlow(ghost_index);
-            applyVelocityInletFlow(ghost_index, index_i);
+            applyToBoundaryType(boundary_type, [&](size_t ghost_index, size_t index_i, const Vecd &e_ig)
+                                {
+                                    applyGivenValueInletFlow(ghost_index);
+                                    applyVelocityInletFlow(ghost_index, index_i); });
             break;
         case 36:
-            applyOutletBoundary(ghost_index, index_i);
+            applyToBoundaryType(boundary_type, [&](size_t ghost_index, size_t index_i, const Vecd &e_ig)
+                                { applyOutletBoundary(ghost_index, index_i); });
             break;
         }
     }
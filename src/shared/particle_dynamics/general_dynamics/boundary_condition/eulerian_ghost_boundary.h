@@ -50,15 +50,17 @@ class GhostCreationInESPH : public LocalDynamics, public DataDelegateInner
     explicit GhostCreationInESPH(BaseInnerRelation &inner_relation, Ghost<ReserveSizeFactor> &ghost_boundary);
     virtual ~GhostCreationInESPH(){};
     std::vector<RealAndGhostParticleData> real_and_ghost_particle_data_;
+    /** Ghosts are counted per real particle, scanned to offsets and filled in parallel. */
     void ghostGenerationAndAddToConfiguration();
+    size_t NumberOfGenerations() { return number_of_generations_; };
 
   protected:
     Ghost<ReserveSizeFactor> &ghost_boundary_;
-    std::mutex mutex_create_ghost_particle_; /**< mutex exclusion for memory conflict */
     NeighborBuilderInnerInFVM get_inner_neighbor_;
     int *indicator_;
     Real *Vol_;
     Vecd *pos_;
+    size_t number_of_generations_;
 
   public:
     std::pair<size_t, size_t> &ghost_bound_;
@@ -82,15 +84,42 @@ class GhostBoundaryConditionSetupInESPH : public LocalDynamics, public DataDeleg
     virtual void applySymmetryBoundary(size_t ghost_index, size_t index_i, Vecd e_ij){};
     virtual void applyVelocityInletFlow(size_t ghost_index, size_t index_i){};
     virtual void setupBoundaryTypes(){};
+    /** Sets up the boundary types and sorts the ghosts by them,
+     *  to be called again if the boundary types are changed afterwards. */
+    void updateBoundaryTypes();
     void resetBoundaryConditions();
 
   protected:
     Real *rho_, *Vol_, *mass_;
     Vecd *vel_, *pos_, *mom_;
     std::pair<size_t, size_t> &ghost_bound_;
-    std::vector<RealAndGhostParticleData> real_and_ghost_particle_data_;
+    GhostCreationInESPH &ghost_creation_;
+    std::vector<RealAndGhostParticleData> &real_and_ghost_particle_data_;
     int *boundary_type_;
     Real W0_;
+    size_t number_of_ghost_generations_;
+    /** The ghosts of boundary type t are located in [boundary_type_offsets_[t], boundary_type_offsets_[t + 1]). */
+    StdVec<size_t> boundary_type_offsets_;
+    StdVec<RealAndGhostParticleData> sorted_ghost_data_;
+    /** Stable counting sort of the ghosts by boundary type. */
+    void sortGhostsByBoundaryType();
+
+    /** Applies a boundary condition to the contiguous range of the ghosts with the same boundary type. */
+    template <typename BoundaryConditionFunction>
+    void applyToBoundaryType(size_t boundary_type, const BoundaryConditionFunction &boundary_condition)
+    {
+        parallel_for(
+            IndexRange(boundary_type_offsets_[boundary_type], boundary_type_offsets_[boundary_type + 1]),
+            [&](const IndexRange &r)
+            {
+                for (size_t n = r.begin(); n != r.end(); ++n)
+                {
+                    const RealAndGhostParticleData &ghost_data = sorted_ghost_data_[n];
+                    boundary_condition(ghost_data.ghost_index_, ghost_data.real_index_, ghost_data.e_ij_ghost_);
+                }
+            },
+            ap);
+    };
 };
 /**
  * @class GhostKernelGradientUpdate
@@ -16,12 +16,125 @@ GhostCreationFromMesh::GhostCreationFromMesh(RealBody &real_body, ANSYSMesh &ans
       ghost_bound_(ghost_boundary.GhostBound())
 {
     ghost_boundary.checkParticlesReserved();
-    each_boundary_type_with_all_ghosts_index_.resize(50);
-    each_boundary_type_with_all_ghosts_eij_.resize(50);
-    each_boundary_type_contact_real_index_.resize(50);
     addGhostParticleAndSetInConfiguration();
 }
 //=================================================================================================//
+void GhostCreationFromMesh::addGhostParticleAndSetInConfiguration()
+{
+    size_t total_real_particles = particles_->TotalRealParticles();
+    StdVec<size_t> ghost_counts(total_real_particles, 0);
+    parallel_for(
+        IndexRange(0, total_real_particles),
+        [&](const IndexRange &r)
+        {
+            for (size_t index_i = r.begin(); index_i != r.end(); ++index_i)
+            {
+                for (size_t neighbor_index = 0; neighbor_index != mesh_topology_[index_i].size(); ++neighbor_index)
+                {
+                    if (mesh_topology_[index_i][neighbor_index][1] != 2)
+                        ghost_counts[index_i]++;
+                }
+            }
+        },
+        ap);
+
+    StdVec<size_t> ghost_offsets(total_real_particles, 0);
+    size_t total_ghosts = parallel_scan(
+        IndexRange(0, total_real_particles), size_t(0),
+        [&](const IndexRange &r, size_t sum, bool is_final_scan) -> size_t
+        {
+            for (size_t index_i = r.begin(); index_i != r.end(); ++index_i)
+            {
+                if (is_final_scan)
+                    ghost_offsets[index_i] = sum;
+                sum += ghost_counts[index_i];
+            }
+            return sum;
+        },
+        [](size_t a, size_t b)
+        { return a + b; });
+
+    ghost_bound_.second = ghost_bound_.first + total_ghosts;
+    ghost_boundary_.checkWithinGhostSize(ghost_bound_);
+    mesh_topology_.resize(ghost_bound_.second);
+
+    StdVec<size_t> ghost_boundary_type(total_ghosts);
+    StdVec<size_t> contact_real_index(total_ghosts);
+    StdVec<Vecd> ghost_eij(total_ghosts);
+    parallel_for(
+        IndexRange(0, total_real_particles),
+        [&](const IndexRange &r)
+        {
+            for (size_t index_i = r.begin(); index_i != r.end(); ++index_i)
+            {
+                size_t ghost_number = ghost_offsets[index_i];
+                for (size_t neighbor_index = 0; neighbor_index != mesh_topology_[index_i].size(); ++neighbor_index)
+                {
+                    StdVec<size_t> &boundary_face = mesh_topology_[index_i][neighbor_index];
+                    size_t boundary_type = boundary_face[1];
+                    if (boundary_type != 2)
+                    {
+                        size_t ghost_particle_index = ghost_bound_.first + ghost_number;
+                        particles_->updateGhostParticle(ghost_particle_index, index_i);
+                        pos_[ghost_particle_index] = ghostPosition(boundary_face);
+                        boundary_face[0] = ghost_particle_index + 1;
+
+                        // the ghost element is given by (corresponding_index_i, boundary_type, face nodes)
+                        StdVec<size_t> sub_element(boundary_face);
+                        sub_element[0] = index_i + 1;
+                        mesh_topology_[ghost_particle_index] = StdVec<StdVec<size_t>>(Dimensions + 1, sub_element);
+
+                        ghost_boundary_type[ghost_number] = boundary_type;
+                        contact_real_index[ghost_number] = index_i;
+                        ghost_eij[ghost_number] = ghostUnitNormal(index_i, boundary_face);
+                        ghost_number++;
+                    }
+                }
+            }
+        },
+        ap);
+
+    sortGhostsByBoundaryType(ghost_boundary_type, contact_real_index, ghost_eij);
+}
+//=================================================================================================//
+void GhostCreationFromMesh::sortGhostsByBoundaryType(const StdVec<size_t> &ghost_boundary_type,
+                                                     const StdVec<size_t> &contact_real_index,
+                                                     const StdVec<Vecd> &ghost_eij)
+{
+    size_t total_ghosts = ghost_boundary_type.size();
+    size_t number_of_boundary_types = 50; // the legacy per-type containers have at least 50 types
+    for (size_t ghost_number = 0; ghost_number != total_ghosts; ++ghost_number)
+    {
+        number_of_boundary_types = SMAX(number_of_boundary_types, ghost_boundary_type[ghost_number] + 1);
+    }
+
+    StdVec<size_t> number_of_ghosts(number_of_boundary_types, 0);
+    for (size_t ghost_number = 0; ghost_number != total_ghosts; ++ghost_number)
+    {
+        number_of_ghosts[ghost_boundary_type[ghost_number]]++;
+    }
+
+    each_boundary_type_with_all_ghosts_index_.resize(number_of_boundary_types);
+    each_boundary_type_with_all_ghosts_eij_.resize(number_of_boundary_types);
+    each_boundary_type_contact_real_index_.resize(number_of_boundary_types);
+    for (size_t boundary_type = 0; boundary_type != number_of_boundary_types; ++boundary_type)
+    {
+        each_boundary_type_with_all_ghosts_index_[boundary_type].resize(number_of_ghosts[boundary_type]);
+        each_boundary_type_with_all_ghosts_eij_[boundary_type].resize(number_of_ghosts[boundary_type]);
+        each_boundary_type_contact_real_index_[boundary_type].resize(number_of_ghosts[boundary_type]);
+    }
+
+    StdVec<size_t> insert_position(number_of_boundary_types, 0);
+    for (size_t ghost_number = 0; ghost_number != total_ghosts; ++ghost_number)
+    {
+        size_t boundary_type = ghost_boundary_type[ghost_number];
+        size_t sorted_number = insert_position[boundary_type]++;
+        each_boundary_type_with_all_ghosts_index_[boundary_type][sorted_number] = ghost_bound_.first + ghost_number;
+        each_boundary_type_with_all_ghosts_eij_[boundary_type][sorted_number] = ghost_eij[ghost_number];
+        each_boundary_type_contact_real_index_[boundary_type][sorted_number] = contact_real_index[ghost_number];
+    }
+}
+//=================================================================================================//
 BoundaryConditionSetupInFVM::
     BoundaryConditionSetupInFVM(BaseInnerRelationInFVM &inner_relation, GhostCreationFromMesh &ghost_creation)
     : LocalDynamics(inner_relation.getSPHBody()), DataDelegateInner(inner_relation),
@@ -37,4 +150,50 @@ BoundaryConditionSetupInFVM::
       each_boundary_type_with_all_ghosts_eij_(ghost_creation.each_boundary_type_with_all_ghosts_eij_),
       each_boundary_type_contact_real_index_(ghost_creation.each_boundary_type_contact_real_index_) {}
 //=================================================================================================//
+void BoundaryConditionSetupInFVM::resetBoundaryConditions()
+{
+    for (size_t boundary_type = 0; boundary_type < each_boundary_type_with_all_ghosts_index_.size(); ++boundary_type)
+    {
+        if (each_boundary_type_with_all_ghosts_index_[boundary_type].empty())
+            continue;
+
+        // Dispatch the appropriate boundary condition once for all ghosts of this type
+        switch (boundary_type)
+        {
+        case 3: // this refer to the different types of wall boundary conditions
+            applyToBoundaryType(boundary_type, [&](size_t ghost_index, size_t index_i, const Vecd &e_ij)
+                                {
+                                    applyNonSlipWallBoundary(ghost_index, index_i);
+                                    applyReflectiveWallBoundary(ghost_index, index_i, e_ij); });
+            break;
+        case 4:
+            applyToBoundaryType(boundary_type, [&](size_t ghost_index, size_t index_i, const Vecd &e_ij)
+                                { applyTopBoundary(ghost_index, index_i); });
+            break;
+        case 5:
+            applyToBoundaryType(boundary_type, [&](size_t ghost_index, size_t index_i, const Vecd &e_ij)
+                                { applyPressureOutletBC(ghost_index, index_i); });
+            break;
+        case 7:
+            applyToBoundaryType(boundary_type, [&](size_t ghost_index, size_t index_i, const Vecd &e_ij)
+                                { applySymmetryBoundary(ghost_index, index_i, e_ij); });
+            break;
+        case 9:
+            applyToBoundaryType(boundary_type, [&](size_t ghost_index, size_t index_i, const Vecd &e_ij)
+                                { applyFarFieldBoundary(ghost_index); });
+            break;
+        case 10:
+            applyToBoundaryType(boundary_type, [&](size_t ghost_index, size_t index_i, const Vecd &e_ij)
+                                {
+                                    applyGivenValueInletFlow(ghost_index);
+                                    applyVelocityInletFlow(ghost_index, index_i); });
+            break;
+        case 36:
+            applyToBoundaryType(boundary_type, [&](size_t ghost_index, size_t index_i, const Vecd &e_ij)
+                                { applyOutletBoundary(ghost_index, index_i); });
+            break;
+        }
+    }
+}
+//=================================================================================================//
 } // namespace SPH
@@ -48,15 +48,21 @@ class GhostCreationFromMesh : public LocalDynamics
 
   protected:
     Ghost<ReserveSizeFactor> &ghost_boundary_;
-    std::mutex mutex_create_ghost_particle_; /**< mutex exclusion for memory conflict */
     StdLargeVec<Vecd> &node_coordinates_;
     StdVec<StdVec<StdVec<size_t>>> &mesh_topology_;
     Vecd *pos_;
     Real *Vol_;
+    /** Ghosts are counted per real particle, scanned to offsets and filled in parallel. */
     void addGhostParticleAndSetInConfiguration();
+    /** Stable counting sort of the ghosts into the containers of their boundary types. */
+    void sortGhostsByBoundaryType(const StdVec<size_t> &ghost_boundary_type, const StdVec<size_t> &contact_real_index,
+                                  const StdVec<Vecd> &ghost_eij);
+    Vecd ghostPosition(const StdVec<size_t> &boundary_face);
+    Vecd ghostUnitNormal(size_t index_i, const StdVec<size_t> &boundary_face);
 
   public:
     std::pair<size_t, size_t> &ghost_bound_;
+    /** The ghosts of each boundary type, in the order of their creation. */
     StdVec<StdVec<size_t>> each_boundary_type_with_all_ghosts_index_;
     StdVec<StdVec<Vecd>> each_boundary_type_with_all_ghosts_eij_;
     StdVec<StdVec<size_t>> each_boundary_type_contact_real_index_;
@@ -89,6 +95,25 @@ class BoundaryConditionSetupInFVM : public LocalDynamics, public DataDelegateInn
     StdVec<StdVec<size_t>> &each_boundary_type_with_all_ghosts_index_;
     StdVec<StdVec<Vecd>> &each_boundary_type_with_all_ghosts_eij_;
     StdVec<StdVec<size_t>> &each_boundary_type_contact_real_index_;
+
+    /** Applies a boundary condition to all ghosts with the same boundary type. */
+    template <typename BoundaryConditionFunction>
+    void applyToBoundaryType(size_t boundary_type, const BoundaryConditionFunction &boundary_condition)
+    {
+        StdVec<size_t> &ghost_index = each_boundary_type_with_all_ghosts_index_[boundary_type];
+        StdVec<size_t> &contact_real_index = each_boundary_type_contact_real_index_[boundary_type];
+        StdVec<Vecd> &ghost_eij = each_boundary_type_with_all_ghosts_eij_[boundary_type];
+        parallel_for(
+            IndexRange(0, ghost_index.size()),
+            [&](const IndexRange &r)
+            {
+                for (size_t n = r.begin(); n != r.end(); ++n)
+                {
+                    boundary_condition(ghost_index[n], contact_real_index[n], ghost_eij[n]);
+                }
+            },
+            ap);
+    };
 };
 } // namespace SPH
 #endif // FVM_GHOST_BOUNDARY_H
@@ -144,5 +144,33 @@ struct ReduceReference<ReduceUpperBound>
     static inline const Vecd value = MinReal * Vecd::Ones();
 };
 
+/**
+ * @struct ReduceTuple
+ * @brief Element-wise combination of several reduce operations,
+ * for reducing several quantities in one pass.
+ */
+template <typename... Operations>
+struct ReduceTuple : ReturnFunction<std::tuple<typename Operations::ReturnType...>>
+{
+    using ReturnType = std::tuple<typename Operations::ReturnType...>;
+    ReturnType operator()(const ReturnType &x, const ReturnType &y) const
+    {
+        return combine(x, y, std::index_sequence_for<Operations...>{});
+    };
+
+  private:
+    template <size_t... Is>
+    ReturnType combine(const ReturnType &x, const ReturnType &y, std::index_sequence<Is...>) const
+    {
+        return ReturnType(Operations{}(std::get<Is>(x), std::get<Is>(y))...);
+    };
+};
+
+template <typename... Operations>
+struct ReduceReference<ReduceTuple<Operations...>>
+{
+    using TupleType = std::tuple<typename Operations::ReturnType...>;
+    static inline const TupleType value = TupleType(ReduceReference<Operations>::value...);
+};
 } // namespace SPH
 #endif // REDUCE_FUNCTORS_H
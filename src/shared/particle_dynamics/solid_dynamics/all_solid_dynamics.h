@@ -36,6 +36,7 @@
 #include "general_solid_dynamics.h"
 #include "inelastic_dynamics.h"
 #include "loading_dynamics.h"
+#include "modal_reduction.h"
 #include "solid_dynamics_variable.h"
 #include "thin_structure_dynamics.h"
 #include "thin_structure_math.h"
@@ -1,9 +1,39 @@
 #include "fluid_structure_interaction.hpp"
 
-#include "viscosity.h"
-
 namespace SPH
 {
+//=================================================================================================//
+WettedSurfaceByParticle::WettedSurfaceByParticle(BaseContactRelation &contact_relation)
+    : BodyPartByParticle(contact_relation.getSPHBody()), contact_relation_(contact_relation),
+      is_wetted_(base_particles_.registerStateVariable<int>(part_name_ + "IsWetted"))
+{
+    alias_ = "WettedSurface";
+    base_particles_.addEvolvingVariable<int>(part_name_ + "IsWetted");
+    update();
+}
+//=================================================================================================//
+void WettedSurfaceByParticle::update()
+{
+    tagParticles([&](size_t i)
+                 { return tagByContactNeighbors(i); });
+    synchronizeParticleLists(ParallelPolicy{});
+}
+//=================================================================================================//
+bool WettedSurfaceByParticle::tagByContactNeighbors(size_t particle_index)
+{
+    bool is_wetted = false;
+    for (size_t k = 0; k != contact_relation_.contact_configuration_.size(); ++k)
+    {
+        if (contact_relation_.contact_configuration_[k][particle_index].current_size_ != 0)
+        {
+            is_wetted = true;
+            break;
+        }
+    }
+    bool is_tagged = is_wetted || is_wetted_[particle_index] != 0;
+    is_wetted_[particle_index] = is_wetted;
+    return is_tagged;
+}
 //=====================================================================================================//
 namespace solid_dynamics
 {
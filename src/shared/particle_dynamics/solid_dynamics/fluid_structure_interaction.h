@@ -34,9 +34,32 @@
 #include "elastic_dynamics.h"
 #include "force_prior.hpp"
 #include "riemann_solver.h"
+#include "viscosity.h"
 
 namespace SPH
 {
+/**
+ * @class WettedSurfaceByParticle
+ * @brief The particles of a structure with fluid neighbors in the given contact relation.
+ * The particle list is maintained by update() after the contact configuration is updated.
+ * A particle is kept for one more update after it has lost its fluid neighbors,
+ * so that the force from fluid on it is evaluated, to be zero, once more before it is dropped.
+ */
+class WettedSurfaceByParticle : public BodyPartByParticle
+{
+  public:
+    explicit WettedSurfaceByParticle(BaseContactRelation &contact_relation);
+    virtual ~WettedSurfaceByParticle() {};
+    BaseContactRelation &getContactRelation() { return contact_relation_; };
+    void update();
+
+  protected:
+    BaseContactRelation &contact_relation_;
+    int *is_wetted_;
+
+    bool tagByContactNeighbors(size_t particle_index);
+};
+
 namespace solid_dynamics
 {
 /**
@@ -100,6 +123,66 @@ class PressureForceFromFluid : public BaseForceFromFluid
     StdVec<RiemannSolverType> riemann_solvers_;
 };
 
+/**
+ * @class BasePressureAndViscousForceFromFluid
+ * @brief The pressure and viscous forces from the fluid evaluated in a single pass over the contact neighbors.
+ * The fluid states and the average velocity and acceleration of the solid are gathered once for both forces,
+ * and the total is accumulated into the force prior as "ForceFromFluid".
+ * The two parts are also kept as "PressureForceFromFluid" and "ViscousForceFromFluid" for output,
+ * therefore, this class replaces, and should not be used together with, the two separate ones.
+ * As the viscous force is updated with the pressure force at every fluid acoustic step,
+ * the separate evaluation of the viscous force at the advection step is not required.
+ */
+template <class RiemannSolverType, class DynamicsIdentifier>
+class BasePressureAndViscousForceFromFluid : public BaseForcePrior<DynamicsIdentifier>, public DataDelegateContact
+{
+  public:
+    BasePressureAndViscousForceFromFluid(DynamicsIdentifier &identifier, BaseContactRelation &contact_relation);
+    virtual ~BasePressureAndViscousForceFromFluid() {};
+    void interaction(size_t index_i, Real dt = 0.0);
+
+  protected:
+    Solid &solid_;
+    Real *Vol_;
+    Vecd *vel_ave_, *acc_ave_, *n_;
+    Vecd *pressure_force_, *viscous_force_;
+    StdVec<Real *> contact_rho_, contact_mass_, contact_p_, contact_Vol_;
+    StdVec<Vecd *> contact_vel_, contact_force_prior_;
+    StdVec<Real> mu_, smoothing_length_;
+    StdVec<RiemannSolverType> riemann_solvers_;
+};
+
+/**
+ * @class PressureAndViscousForceFromFluid
+ * @brief The fused force from fluid evaluated on all particles of the solid body.
+ */
+template <class FluidIntegration2ndHalfType>
+class PressureAndViscousForceFromFluid
+    : public BasePressureAndViscousForceFromFluid<typename FluidIntegration2ndHalfType::RiemannSolver, SPHBody>
+{
+  public:
+    explicit PressureAndViscousForceFromFluid(BaseContactRelation &contact_relation)
+        : BasePressureAndViscousForceFromFluid<typename FluidIntegration2ndHalfType::RiemannSolver, SPHBody>(
+              contact_relation.getSPHBody(), contact_relation) {};
+    virtual ~PressureAndViscousForceFromFluid() {};
+};
+
+/**
+ * @class PressureAndViscousForceFromFluidOnWettedSurface
+ * @brief The fused force from fluid evaluated only on the wetted surface particles,
+ * which saves the loop over the inner particles of a large solid body.
+ */
+template <class FluidIntegration2ndHalfType>
+class PressureAndViscousForceFromFluidOnWettedSurface
+    : public BasePressureAndViscousForceFromFluid<typename FluidIntegration2ndHalfType::RiemannSolver, WettedSurfaceByParticle>
+{
+  public:
+    explicit PressureAndViscousForceFromFluidOnWettedSurface(WettedSurfaceByParticle &wetted_surface)
+        : BasePressureAndViscousForceFromFluid<typename FluidIntegration2ndHalfType::RiemannSolver, WettedSurfaceByParticle>(
+              wetted_surface, wetted_surface.getContactRelation()) {};
+    virtual ~PressureAndViscousForceFromFluidOnWettedSurface() {};
+};
+
 /**
  * @class InitializeDisplacement
  * @brief initialize the displacement for computing average velocity.
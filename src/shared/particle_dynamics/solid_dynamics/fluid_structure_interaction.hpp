@@ -58,6 +58,78 @@ void PressureForceFromFluid<FluidIntegration2ndHalfType>::interaction(size_t ind
     force_from_fluid_[index_i] = force * Vol_[index_i];
 }
 //=================================================================================================//
+template <class RiemannSolverType, class DynamicsIdentifier>
+BasePressureAndViscousForceFromFluid<RiemannSolverType, DynamicsIdentifier>::
+    BasePressureAndViscousForceFromFluid(DynamicsIdentifier &identifier, BaseContactRelation &contact_relation)
+    : BaseForcePrior<DynamicsIdentifier>(identifier, "ForceFromFluid"), DataDelegateContact(contact_relation),
+      solid_(DynamicCast<Solid>(this, this->sph_body_.getBaseMaterial())),
+      Vol_(this->particles_->template getVariableDataByName<Real>("VolumetricMeasure")),
+      vel_ave_(solid_.AverageVelocity(this->particles_)),
+      acc_ave_(solid_.AverageAcceleration(this->particles_)),
+      n_(this->particles_->template getVariableDataByName<Vecd>("NormalDirection")),
+      pressure_force_(this->particles_->template registerStateVariable<Vecd>("PressureForceFromFluid")),
+      viscous_force_(this->particles_->template registerStateVariable<Vecd>("ViscousForceFromFluid"))
+{
+    for (size_t k = 0; k != contact_particles_.size(); ++k)
+    {
+        Fluid &fluid_k = DynamicCast<Fluid>(this, contact_particles_[k]->getBaseMaterial());
+        Viscosity &viscosity_k = DynamicCast<Viscosity>(this, contact_particles_[k]->getBaseMaterial());
+        contact_rho_.push_back(contact_particles_[k]->template getVariableDataByName<Real>("Density"));
+        contact_mass_.push_back(contact_particles_[k]->template getVariableDataByName<Real>("Mass"));
+        contact_vel_.push_back(contact_particles_[k]->template getVariableDataByName<Vecd>("Velocity"));
+        contact_Vol_.push_back(contact_particles_[k]->template getVariableDataByName<Real>("VolumetricMeasure"));
+        contact_p_.push_back(contact_particles_[k]->template getVariableDataByName<Real>("Pressure"));
+        contact_force_prior_.push_back(contact_particles_[k]->template getVariableDataByName<Vecd>("ForcePrior"));
+        mu_.push_back(viscosity_k.ReferenceViscosity());
+        smoothing_length_.push_back(contact_bodies_[k]->getSPHAdaptation().ReferenceSmoothingLength());
+        riemann_solvers_.push_back(RiemannSolverType(fluid_k, fluid_k));
+    }
+}
+//=================================================================================================//
+template <class RiemannSolverType, class DynamicsIdentifier>
+void BasePressureAndViscousForceFromFluid<RiemannSolverType, DynamicsIdentifier>::
+    interaction(size_t index_i, Real dt)
+{
+    const Vecd &vel_ave_i = vel_ave_[index_i];
+    const Vecd &acc_ave_i = acc_ave_[index_i];
+    const Vecd &n_i = n_[index_i];
+    Vecd pressure_force = Vecd::Zero();
+    Vecd viscous_force = Vecd::Zero();
+    for (size_t k = 0; k < contact_configuration_.size(); ++k)
+    {
+        Real *Vol_k = contact_Vol_[k];
+        Real *rho_k = contact_rho_[k];
+        Real *mass_k = contact_mass_[k];
+        Real *p_k = contact_p_[k];
+        Vecd *vel_k = contact_vel_[k];
+        Vecd *force_prior_k = contact_force_prior_[k];
+        Real viscous_factor_k = 4.0 * mu_[k];
+        Real smoothing_length_k = smoothing_length_[k];
+        RiemannSolverType &riemann_solvers_k = riemann_solvers_[k];
+        Neighborhood &contact_neighborhood = (*contact_configuration_[k])[index_i];
+        for (size_t n = 0; n != contact_neighborhood.current_size_; ++n)
+        {
+            size_t index_j = contact_neighborhood.j_[n];
+            const Vecd &e_ij = contact_neighborhood.e_ij_[n];
+            Real r_ij = contact_neighborhood.r_ij_[n];
+            Real dW_ijV_j = contact_neighborhood.dW_ij_[n] * Vol_k[index_j];
+            const Vecd &vel_j = vel_k[index_j];
+            Real p_j = p_k[index_j];
+
+            Real face_wall_external_acceleration =
+                (force_prior_k[index_j] / mass_k[index_j] - acc_ave_i).dot(e_ij);
+            Real p_j_in_wall = p_j + rho_k[index_j] * r_ij * SMAX(Real(0), face_wall_external_acceleration);
+            Real u_jump = 2.0 * (vel_j - vel_ave_i).dot(n_i);
+            pressure_force -= (riemann_solvers_k.DissipativePJump(u_jump) * n_i + (p_j_in_wall + p_j) * e_ij) * dW_ijV_j;
+
+            viscous_force += viscous_factor_k * (vel_ave_i - vel_j) / (r_ij + 0.01 * smoothing_length_k) * dW_ijV_j;
+        }
+    }
+    pressure_force_[index_i] = pressure_force * Vol_[index_i];
+    viscous_force_[index_i] = viscous_force * Vol_[index_i];
+    this->current_force_[index_i] = pressure_force_[index_i] + viscous_force_[index_i];
+}
+//=================================================================================================//
 } // namespace solid_dynamics
 } // namespace SPH
 #endif // FLUID_STRUCTURE_INTERACTION_HPP
\ No newline at end of file
@@ -0,0 +1,302 @@
+#include "modal_reduction.h"
+
+namespace SPH
+{
+//=========================================================================================================//
+namespace solid_dynamics
+{
+//=================================================================================================//
+LinearizedElasticStiffness::
+    LinearizedElasticStiffness(BaseInnerRelation &inner_relation, Real stabilization_factor)
+    : LocalDynamics(inner_relation.getSPHBody()), DataDelegateInner(inner_relation),
+      elastic_solid_(DynamicCast<ElasticSolid>(this, sph_body_.getBaseMaterial())),
+      lambda0_(elastic_solid_.BulkModulus() - 2.0 * elastic_solid_.ShearModulus() / 3.0),
+      G0_(elastic_solid_.ShearModulus()), stabilization_factor_(stabilization_factor),
+      Vol_(particles_->getVariableDataByName<Real>("VolumetricMeasure")),
+      B_(particles_->getVariableDataByName<Matd>("LinearGradientCorrectionMatrix")) {}
+//=================================================================================================//
+Matd LinearizedElasticStiffness::DisplacementGradient(size_t index_i, const Vecd *displacement)
+{
+    Matd gradient = Matd::Zero();
+    const Neighborhood &inner_neighborhood = inner_configuration_[index_i];
+    for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+    {
+        size_t index_j = inner_neighborhood.j_[n];
+        Vecd gradW_ijV_j = inner_neighborhood.dW_ij_[n] * Vol_[index_j] * inner_neighborhood.e_ij_[n];
+        gradient -= (displacement[index_i] - displacement[index_j]) * gradW_ijV_j.transpose();
+    }
+    return gradient * B_[index_i];
+}
+//=================================================================================================//
+Matd LinearizedElasticStiffness::DualStress(size_t index_i, const Vecd *displacement, const Matd *gradient)
+{
+    Matd strain = 0.5 * (gradient[index_i] + gradient[index_i].transpose());
+    Matd dual_stress = Vol_[index_i] * (lambda0_ * strain.trace() * Matd::Identity() + 2.0 * G0_ * strain);
+    const Neighborhood &inner_neighborhood = inner_configuration_[index_i];
+    for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+    {
+        size_t index_j = inner_neighborhood.j_[n];
+        const Vecd &e_ij = inner_neighborhood.e_ij_[n];
+        Real r_ij = inner_neighborhood.r_ij_[n];
+        Real weight = StabilizationWeight(index_i, index_j, inner_neighborhood.W_ij_[n], r_ij);
+        dual_stress += 0.5 * weight * r_ij *
+                       DisplacementDeviation(index_i, index_j, e_ij, r_ij, displacement, gradient) * e_ij.transpose();
+    }
+    return dual_stress;
+}
+//=================================================================================================//
+Vecd LinearizedElasticStiffness::StiffnessProduct(size_t index_i, const Vecd *displacement,
+                                                  const Matd *gradient, const Matd *dual_stress)
+{
+    Vecd product = Vecd::Zero();
+    const Neighborhood &inner_neighborhood = inner_configuration_[index_i];
+    for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+    {
+        size_t index_j = inner_neighborhood.j_[n];
+        const Vecd &e_ij = inner_neighborhood.e_ij_[n];
+        Real r_ij = inner_neighborhood.r_ij_[n];
+        Real weight = StabilizationWeight(index_i, index_j, inner_neighborhood.W_ij_[n], r_ij);
+        product -= inner_neighborhood.dW_ij_[n] *
+                       (Vol_[index_i] * dual_stress[index_j] * B_[index_j].transpose() +
+                        Vol_[index_j] * dual_stress[index_i] * B_[index_i].transpose()) *
+                       e_ij +
+                   weight * DisplacementDeviation(index_i, index_j, e_ij, r_ij, displacement, gradient);
+    }
+    return product;
+}
+//=================================================================================================//
+ModalReduction::ModalReduction(BaseInnerRelation &inner_relation, BodyPartByParticle &constrained_part,
+                               size_t number_of_modes, Real damping_ratio)
+    : BaseDynamics<void>(), sph_body_(inner_relation.getSPHBody()),
+      particles_(sph_body_.getBaseParticles()), stiffness_(inner_relation),
+      constrained_particles_(constrained_part.body_part_particles_), reconstruction_part_(nullptr),
+      number_of_modes_(number_of_modes), damping_ratio_(damping_ratio), tolerance_(1.0e-8),
+      mass_(particles_.getVariableDataByName<Real>("Mass")),
+      pos_(particles_.getVariableDataByName<Vecd>("Position")),
+      pos0_(particles_.registerStateVariableFrom<Vecd>("InitialPosition", "Position")),
+      vel_(particles_.registerStateVariable<Vecd>("Velocity")),
+      vel_ave_(DynamicCast<Solid>(this, sph_body_.getBaseMaterial()).AverageVelocity(&particles_)),
+      acc_ave_(DynamicCast<Solid>(this, sph_body_.getBaseMaterial()).AverageAcceleration(&particles_)),
+      force_prior_(particles_.registerStateVariable<Vecd>("ForcePrior")),
+      F_(particles_.registerStateVariable<Matd>("DeformationGradient", IdentityMatrix<Matd>::value)) {}
+//=================================================================================================//
+void ModalReduction::multiplyStiffness(const StdVec<Vecd> &displacement, StdVec<Vecd> &product)
+{
+    IndexRange real_particles(0, particles_.TotalRealParticles());
+    particle_for(execution::ParallelPolicy(), real_particles,
+                 [&](size_t i)
+                 { gradient_[i] = stiffness_.DisplacementGradient(i, displacement.data()); });
+    particle_for(execution::ParallelPolicy(), real_particles,
+                 [&](size_t i)
+                 { dual_stress_[i] = stiffness_.DualStress(i, displacement.data(), gradient_.data()); });
+    particle_for(execution::ParallelPolicy(), real_particles,
+                 [&](size_t i)
+                 { product[i] = stiffness_.StiffnessProduct(i, displacement.data(), gradient_.data(), dual_stress_.data()); });
+    setConstrainedToZero(product);
+}
+//=================================================================================================//
+void ModalReduction::solveStiffness(const StdVec<Vecd> &rhs, StdVec<Vecd> &solution)
+{
+    size_t total_real_particles = particles_.TotalRealParticles();
+    IndexRange real_particles(0, total_real_particles);
+    StdVec<Vecd> residual(rhs), direction(rhs), product(total_real_particles, Vecd::Zero());
+    setConstrainedToZero(residual);
+    setConstrainedToZero(direction);
+    solution.assign(total_real_particles, Vecd::Zero());
+
+    Real residual_square = innerProduct(residual, residual);
+    Real target_residual_square = tolerance_ * tolerance_ * residual_square;
+    size_t max_iterations = 10 * Dimensions * total_real_particles;
+    for (size_t k = 0; k != max_iterations && residual_square > target_residual_square; ++k)
+    {
+        multiplyStiffness(direction, product);
+        Real step = residual_square / (innerProduct(direction, product) + TinyReal);
+        particle_for(execution::ParallelPolicy(), real_particles,
+                     [&](size_t i)
+                     {
+                         solution[i] += step * direction[i];
+                         residual[i] -= step * product[i];
+                     });
+        Real new_residual_square = innerProduct(residual, residual);
+        Real ratio = new_residual_square / residual_square;
+        particle_for(execution::ParallelPolicy(), real_particles,
+                     [&](size_t i)
+                     { direction[i] = residual[i] + ratio * direction[i]; });
+        residual_square = new_residual_square;
+    }
+}
+//=================================================================================================//
+Real ModalReduction::massInnerProduct(const StdVec<Vecd> &a, const StdVec<Vecd> &b)
+{
+    return particle_reduce(execution::ParallelPolicy(), IndexRange(0, particles_.TotalRealParticles()),
+                           Real(0), ReduceSum<Real>(),
+                           [&](size_t i) -> Real
+                           { return mass_[i] * a[i].dot(b[i]); });
+}
+//=================================================================================================//
+Real ModalReduction::innerProduct(const StdVec<Vecd> &a, const StdVec<Vecd> &b)
+{
+    return particle_reduce(execution::ParallelPolicy(), IndexRange(0, particles_.TotalRealParticles()),
+                           Real(0), ReduceSum<Real>(),
+                           [&](size_t i) -> Real
+                           { return a[i].dot(b[i]); });
+}
+//=================================================================================================//
+void ModalReduction::setConstrainedToZero(StdVec<Vecd> &field)
+{
+    particle_for(execution::ParallelPolicy(), constrained_particles_,
+                 [&](size_t i)
+                 { field[i] = Vecd::Zero(); });
+}
+//=================================================================================================//
+void ModalReduction::computeModes()
+{
+    size_t total_real_particles = particles_.TotalRealParticles();
+    IndexRange real_particles(0, total_real_particles);
+    gradient_.assign(total_real_particles, Matd::Zero());
+    dual_stress_.assign(total_real_particles, Matd::Zero());
+    size_t free_dofs = Dimensions * (total_real_particles - constrained_particles_.size());
+    size_t max_steps = SMIN(free_dofs, 10 * number_of_modes_ + 50);
+
+    // deterministic pseudo-random start vector
+    StdVec<Vecd> lanczos_vector(total_real_particles, Vecd::Zero());
+    for (size_t i = 0; i != total_real_particles; ++i)
+        for (int d = 0; d != Dimensions; ++d)
+            lanczos_vector[i][d] = Real((7919 * (i * Dimensions + d) + 1) % 1000) / 1000.0 - 0.5;
+    setConstrainedToZero(lanczos_vector);
+    Real start_norm = sqrt(massInnerProduct(lanczos_vector, lanczos_vector));
+    for (size_t i = 0; i != total_real_particles; ++i)
+        lanczos_vector[i] /= start_norm;
+
+    // Lanczos iterations for the shift-invert operator inverse(K) * M in the M-inner product
+    StdVec<StdVec<Vecd>> lanczos_vectors;
+    StdVec<Real> alpha, beta;
+    StdVec<Vecd> mass_product(total_real_particles), w(total_real_particles);
+    Eigen::SelfAdjointEigenSolver<MatXd> tridiagonal_solver;
+    while (lanczos_vectors.size() != max_steps)
+    {
+        lanczos_vectors.push_back(lanczos_vector);
+        size_t k = lanczos_vectors.size() - 1;
+        particle_for(execution::ParallelPolicy(), real_particles,
+                     [&](size_t i)
+                     { mass_product[i] = mass_[i] * lanczos_vectors[k][i]; });
+        solveStiffness(mass_product, w);
+        alpha.push_back(massInnerProduct(w, lanczos_vectors[k]));
+        // full re-orthogonalization, twice is enough
+        for (size_t pass = 0; pass != 2; ++pass)
+            for (size_t l = 0; l != lanczos_vectors.size(); ++l)
+            {
+                Real projection = massInnerProduct(w, lanczos_vectors[l]);
+                particle_for(execution::ParallelPolicy(), real_particles,
+                             [&](size_t i)
+                             { w[i] -= projection * lanczos_vectors[l][i]; });
+            }
+        beta.push_back(sqrt(massInnerProduct(w, w)));
+
+        size_t steps = lanczos_vectors.size();
+        if (steps >= number_of_modes_)
+        {
+            MatXd tridiagonal = MatXd::Zero(steps, steps);
+            for (size_t l = 0; l != steps; ++l)
+            {
+                tridiagonal(l, l) = alpha[l];
+                if (l + 1 != steps)
+                    tridiagonal(l, l + 1) = tridiagonal(l + 1, l) = beta[l];
+            }
+            tridiagonal_solver.compute(tridiagonal);
+            // the largest Ritz values are the lowest modes
+            bool is_converged = true;
+            for (size_t m = 0; m != number_of_modes_; ++m)
+            {
+                size_t column = steps - 1 - m;
+                Real ritz_residual = ABS(beta.back() * tridiagonal_solver.eigenvectors()(steps - 1, column));
+                is_converged = is_converged && ritz_residual < tolerance_ * tridiagonal_solver.eigenvalues()[column];
+            }
+            if (is_converged)
+                break;
+        }
+        // invariant subspace found
+        if (beta.back() < tolerance_ * ABS(alpha.back()))
+            break;
+
+        for (size_t i = 0; i != total_real_particles; ++i)
+            lanczos_vector[i] = w[i] / beta.back();
+    }
+
+    size_t steps = lanczos_vectors.size();
+    if (steps < number_of_modes_)
+    {
+        MatXd tridiagonal = MatXd::Zero(steps, steps);
+        for (size_t l = 0; l != steps; ++l)
+        {
+            tridiagonal(l, l) = alpha[l];
+            if (l + 1 != steps)
+                tridiagonal(l, l + 1) = tridiagonal(l + 1, l) = beta[l];
+        }
+        tridiagonal_solver.compute(tridiagonal);
+    }
+
+    size_t number_of_modes = SMIN(number_of_modes_, steps);
+    natural_frequencies_.resize(number_of_modes);
+    mode_shapes_.assign(number_of_modes, StdVec<Vecd>(total_real_particles, Vecd::Zero()));
+    mode_gradients_.assign(number_of_modes, StdVec<Matd>(total_real_particles, Matd::Zero()));
+    for (size_t m = 0; m != number_of_modes; ++m)
+    {
+        size_t column = steps - 1 - m;
+        natural_frequencies_[m] = sqrt(1.0 / tridiagonal_solver.eigenvalues()[column]);
+        StdVec<Vecd> &mode_shape = mode_shapes_[m];
+        for (size_t l = 0; l != steps; ++l)
+        {
+            Real coefficient = tridiagonal_solver.eigenvectors()(l, column);
+            particle_for(execution::ParallelPolicy(), real_particles,
+                         [&](size_t i)
+                         { mode_shape[i] += coefficient * lanczos_vectors[l][i]; });
+        }
+        particle_for(execution::ParallelPolicy(), real_particles,
+                     [&](size_t i)
+                     { mode_gradients_[m][i] = stiffness_.DisplacementGradient(i, mode_shape.data()); });
+    }
+    q_.assign(number_of_modes, 0.0);
+    dq_dt_.assign(number_of_modes, 0.0);
+    dq2_dt2_.assign(number_of_modes, 0.0);
+}
+//=================================================================================================//
+void ModalReduction::exec(Real dt)
+{
+    if (natural_frequencies_.empty())
+        computeModes();
+
+    IndexRange real_particles(0, particles_.TotalRealParticles());
+    for (size_t m = 0; m != natural_frequencies_.size(); ++m)
+    {
+        const StdVec<Vecd> &mode_shape = mode_shapes_[m];
+        Real generalized_force = particle_reduce(execution::ParallelPolicy(), real_particles, Real(0), ReduceSum<Real>(),
+                                                 [&](size_t i) -> Real
+                                                 { return mode_shape[i].dot(force_prior_[i]); });
+        // Newmark average acceleration method
+        Real omega = natural_frequencies_[m];
+        Real damping = 2.0 * damping_ratio_ * omega;
+        Real stiffness = omega * omega;
+        Real predicted_dq_dt = dq_dt_[m] + 0.5 * dt * dq2_dt2_[m];
+        Real predicted_q = q_[m] + dt * dq_dt_[m] + 0.25 * dt * dt * dq2_dt2_[m];
+        Real new_dq2_dt2 = (generalized_force - damping * predicted_dq_dt - stiffness * predicted_q) /
+                           (1.0 + 0.5 * dt * damping + 0.25 * dt * dt * stiffness);
+        q_[m] = predicted_q + 0.25 * dt * dt * new_dq2_dt2;
+        dq_dt_[m] = predicted_dq_dt + 0.5 * dt * new_dq2_dt2;
+        dq2_dt2_[m] = new_dq2_dt2;
+    }
+
+    if (reconstruction_part_ != nullptr)
+        reconstruct(reconstruction_part_->LoopRange());
+    else
+        reconstruct(real_particles);
+    setUpdated(sph_body_);
+}
+//=================================================================================================//
+void ModalReduction::reconstructAllParticles()
+{
+    reconstruct(IndexRange(0, particles_.TotalRealParticles()));
+}
+//=================================================================================================//
+} // namespace solid_dynamics
+} // namespace SPH
@@ -0,0 +1,162 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	modal_reduction.h
+ * @brief 	Reduced-order elastic solid dynamics by the lowest vibration modes.
+ * @details The stiffness operator is the linearization of the total Lagrangian elastic dynamics
+ *			at the initial configuration, i.e. the corrected gradient of the displacement,
+ *			the linear elastic stress and its divergence in the same form as Integration1stHalf.
+ *			It is written as the derivative of an elastic energy so that it is symmetric,
+ *			and a pairwise stabilization penalizing the deviation from the linear displacement
+ *			suppresses the zero-energy modes of the particle gradient.
+ *			The lowest modes are computed once by the shift-invert Lanczos method
+ *			with the matrix-free stiffness operator and conjugate gradient inner solves.
+ *			The modal equations are integrated by the Newmark average acceleration method
+ *			with the generalized forces projected from the prior force, which includes the forces from fluid,
+ *			so that the time step is that of the fluid and not the acoustic time step of the solid.
+ *			Small deformation is assumed. The mode shapes are defined on the particle indices,
+ *			therefore, the particles of the body should not be sorted.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef MODAL_REDUCTION_H
+#define MODAL_REDUCTION_H
+
+#include "all_body_relations.h"
+#include "all_particle_dynamics.h"
+#include "base_general_dynamics.h"
+#include "elastic_solid.h"
+
+namespace SPH
+{
+namespace solid_dynamics
+{
+/**
+ * @class LinearizedElasticStiffness
+ * @brief Matrix-free product of the linearized stiffness matrix and a displacement field.
+ * The product is computed in three passes: the corrected displacement gradient,
+ * the dual stress and at last the stiffness product itself.
+ */
+class LinearizedElasticStiffness : public LocalDynamics, public DataDelegateInner
+{
+  public:
+    explicit LinearizedElasticStiffness(BaseInnerRelation &inner_relation, Real stabilization_factor = 0.1);
+    virtual ~LinearizedElasticStiffness() {};
+    Matd DisplacementGradient(size_t index_i, const Vecd *displacement);
+    Matd DualStress(size_t index_i, const Vecd *displacement, const Matd *gradient);
+    Vecd StiffnessProduct(size_t index_i, const Vecd *displacement, const Matd *gradient, const Matd *dual_stress);
+
+  protected:
+    ElasticSolid &elastic_solid_;
+    Real lambda0_, G0_, stabilization_factor_;
+    Real *Vol_;
+    Matd *B_;
+
+    /** Deviation of the displacement jump from that given by the averaged gradient. */
+    Vecd DisplacementDeviation(size_t index_i, size_t index_j, const Vecd &e_ij, Real r_ij,
+                               const Vecd *displacement, const Matd *gradient)
+    {
+        return displacement[index_j] - displacement[index_i] + 0.5 * (gradient[index_i] + gradient[index_j]) * e_ij * r_ij;
+    };
+    Real StabilizationWeight(size_t index_i, size_t index_j, Real W_ij, Real r_ij)
+    {
+        return stabilization_factor_ * G0_ * Vol_[index_i] * Vol_[index_j] * W_ij / (r_ij * r_ij);
+    };
+};
+
+/**
+ * @class ModalReduction
+ * @brief The reduced-order dynamics of an elastic body replacing the stress relaxation sub-steps
+ * and the average velocity and acceleration in FSI. One execution is one fluid time step.
+ * The modes are computed at the first execution if not yet.
+ * The position, velocity, average velocity and acceleration and deformation gradient
+ * are reconstructed on all particles or only on the given body part, e.g. the surface wetted by the fluid.
+ */
+class ModalReduction : public BaseDynamics<void>
+{
+  public:
+    ModalReduction(BaseInnerRelation &inner_relation, BodyPartByParticle &constrained_part,
+                   size_t number_of_modes, Real damping_ratio = 0.0);
+    virtual ~ModalReduction() {};
+    virtual void exec(Real dt = 0.0) override;
+    void computeModes();
+    void reconstructOn(BodyPartByParticle &reconstruction_part) { reconstruction_part_ = &reconstruction_part; };
+    void reconstructAllParticles();
+    size_t NumberOfModes() { return natural_frequencies_.size(); };
+    /** Angular natural frequency of the mode. */
+    Real NaturalFrequency(size_t mode) { return natural_frequencies_[mode]; };
+    Real ModalCoordinate(size_t mode) { return q_[mode]; };
+    StdVec<Vecd> &ModeShape(size_t mode) { return mode_shapes_[mode]; };
+
+  protected:
+    SPHBody &sph_body_;
+    BaseParticles &particles_;
+    LinearizedElasticStiffness stiffness_;
+    IndexVector &constrained_particles_;
+    BodyPartByParticle *reconstruction_part_;
+    size_t number_of_modes_;
+    Real damping_ratio_, tolerance_;
+    Real *mass_;
+    Vecd *pos_, *pos0_, *vel_, *vel_ave_, *acc_ave_, *force_prior_;
+    Matd *F_;
+    StdVec<Real> natural_frequencies_;
+    StdVec<StdVec<Vecd>> mode_shapes_;
+    StdVec<StdVec<Matd>> mode_gradients_;
+    StdVec<Real> q_, dq_dt_, dq2_dt2_;
+    StdVec<Matd> gradient_, dual_stress_;
+
+    void multiplyStiffness(const StdVec<Vecd> &displacement, StdVec<Vecd> &product);
+    /** Conjugate gradient solution with the constrained particles excluded. */
+    void solveStiffness(const StdVec<Vecd> &rhs, StdVec<Vecd> &solution);
+    Real massInnerProduct(const StdVec<Vecd> &a, const StdVec<Vecd> &b);
+    Real innerProduct(const StdVec<Vecd> &a, const StdVec<Vecd> &b);
+    void setConstrainedToZero(StdVec<Vecd> &field);
+
+    template <class LoopRange>
+    void reconstruct(const LoopRange &loop_range)
+    {
+        particle_for(execution::ParallelPolicy(), loop_range,
+                     [&](size_t i)
+                     {
+                         Vecd displacement = Vecd::Zero();
+                         Vecd velocity = Vecd::Zero();
+                         Vecd acceleration = Vecd::Zero();
+                         Matd deformation = Matd::Identity();
+                         for (size_t m = 0; m != natural_frequencies_.size(); ++m)
+                         {
+                             displacement += q_[m] * mode_shapes_[m][i];
+                             velocity += dq_dt_[m] * mode_shapes_[m][i];
+                             acceleration += dq2_dt2_[m] * mode_shapes_[m][i];
+                             deformation += q_[m] * mode_gradients_[m][i];
+                         }
+                         pos_[i] = pos0_[i] + displacement;
+                         vel_[i] = velocity;
+                         vel_ave_[i] = velocity;
+                         acc_ave_[i] = acceleration;
+                         F_[i] = deformation;
+                     });
+    };
+};
+} // namespace solid_dynamics
+} // namespace SPH
+#endif // MODAL_REDUCTION_H
@@ -28,4 +28,15 @@ FluidStateOut NoRiemannSolver::
     return FluidStateOut(rho_star, v_star, p_star);
 }
 //=================================================================================================//
+void NoRiemannSolver::InterfaceStates(FluidStateBatch &batch)
+{
+    for (size_t k = 0; k < batch.size_; ++k)
+    {
+        batch.rho_star_[k] = 0.5 * (batch.rho_i_[k] + batch.rho_j_[k]);
+        batch.p_star_[k] = 0.5 * (batch.p_i_[k] + batch.p_j_[k]);
+        for (int d = 0; d != Dimensions; ++d)
+            batch.vel_star_[d][k] = 0.5 * (batch.vel_i_[d][k] + batch.vel_j_[d][k]);
+    }
+}
+//=================================================================================================//
 } // namespace SPH
@@ -48,6 +48,44 @@ struct FluidStateOut
     FluidStateOut(Real rho, Vecd vel, Real p) : vel_(vel), rho_(rho), p_(p){};
 };
 
+/**
+ * @struct FluidStateBatch
+ * @brief  The states of a block of particle pairs and their interface states in structure-of-arrays layout.
+ * Batched Riemann solvers evaluate all pairs of the block without branches
+ * so that the loop over the pairs can be vectorized by the compiler.
+ */
+struct FluidStateBatch
+{
+    static constexpr size_t capacity_ = 16;
+    size_t size_ = 0;
+    Real rho_i_[capacity_], p_i_[capacity_], vel_i_[Dimensions][capacity_];
+    Real rho_j_[capacity_], p_j_[capacity_], vel_j_[Dimensions][capacity_];
+    Real e_ij_[Dimensions][capacity_];
+    Real rho_star_[capacity_], p_star_[capacity_], vel_star_[Dimensions][capacity_];
+
+    void setPair(size_t k, const FluidStateIn &state_i, const FluidStateIn &state_j, const Vecd &e_ij)
+    {
+        rho_i_[k] = state_i.rho_;
+        p_i_[k] = state_i.p_;
+        rho_j_[k] = state_j.rho_;
+        p_j_[k] = state_j.p_;
+        for (int d = 0; d != Dimensions; ++d)
+        {
+            vel_i_[d][k] = state_i.vel_[d];
+            vel_j_[d][k] = state_j.vel_[d];
+            e_ij_[d][k] = e_ij[d];
+        }
+    };
+
+    FluidStateOut InterfaceState(size_t k)
+    {
+        Vecd vel_star;
+        for (int d = 0; d != Dimensions; ++d)
+            vel_star[d] = vel_star_[d][k];
+        return FluidStateOut(rho_star_[k], vel_star, p_star_[k]);
+    };
+};
+
 /**
  * @struct NoRiemannSolver
  * @brief  Central difference scheme without Riemann flux.
@@ -72,6 +110,7 @@ class NoRiemannSolver
 
     Vecd AverageV(const Vecd &vel_i, const Vecd &vel_j);
     FluidStateOut InterfaceState(const FluidStateIn &state_i, const FluidStateIn &state_j, const Vecd &e_ij);
+    void InterfaceStates(FluidStateBatch &batch);
 
   protected:
     Real rho0_i_, rho0_j_;
@@ -114,6 +153,28 @@ class BaseAcousticRiemannSolver : public NoRiemannSolver
         return FluidStateOut(average_state.rho_, vel_star, p_star);
     };
 
+    void InterfaceStates(FluidStateBatch &batch)
+    {
+        NoRiemannSolver::InterfaceStates(batch);
+        for (size_t k = 0; k < batch.size_; ++k)
+        {
+            Real ul = 0.0;
+            Real ur = 0.0;
+            for (int d = 0; d != Dimensions; ++d)
+            {
+                ul -= batch.e_ij_[d][k] * batch.vel_i_[d][k];
+                ur -= batch.e_ij_[d][k] * batch.vel_j_[d][k];
+            }
+            Real u_jump = ul - ur;
+            Real limited_mach_number = limiter_(SMAX(u_jump, Real(0)));
+
+            batch.p_star_[k] += 0.5 * rho0c0_geo_ave_ * u_jump * limited_mach_number;
+            Real u_dissipative = 0.5 * (batch.p_i_[k] - batch.p_j_[k]) * inv_rho0c0_ave_ * limited_mach_number * limited_mach_number;
+            for (int d = 0; d != Dimensions; ++d)
+                batch.vel_star_[d][k] -= batch.e_ij_[d][k] * u_dissipative;
+        }
+    };
+
   protected:
     Real inv_rho0c0_ave_, rho0c0_geo_ave_;
     LimiterType limiter_;
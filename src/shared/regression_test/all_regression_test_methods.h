@@ -31,6 +31,7 @@
 #define ALL_REGRESSION_TEST_METHODS_H
 
 #include "dynamic_time_warping_method.hpp"
+#include "ensemble_runner.h"
 #include "ensemble_average_method.hpp"
 #include "regression_test_base.hpp"
 #include "time_average_method.hpp"
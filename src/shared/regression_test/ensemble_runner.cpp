@@ -0,0 +1,66 @@
+#include "ensemble_runner.h"
+
+namespace SPH
+{
+//=================================================================================================//
+EnsembleRunner::EnsembleRunner(size_t number_of_replicas, size_t number_of_arenas)
+    : number_of_replicas_(number_of_replicas),
+      number_of_arenas_(SMAX(number_of_arenas == 0
+                                 ? SMIN(number_of_replicas, size_t(std::thread::hardware_concurrency()))
+                                 : SMIN(number_of_replicas, number_of_arenas),
+                             size_t(1))),
+      threads_per_arena_(SMAX(size_t(std::thread::hardware_concurrency()) / number_of_arenas_, size_t(1))),
+      next_replica_(0), next_in_order_(0), is_in_order_(number_of_replicas, false)
+{
+    if (number_of_replicas_ == 0)
+    {
+        std::cout << "\n Error: the ensemble has no replica!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+}
+//=================================================================================================//
+void EnsembleRunner::run(const std::function<void(size_t)> &replica)
+{
+    next_replica_ = 0;
+    next_in_order_ = 0;
+    is_in_order_.assign(number_of_replicas_, false);
+
+    StdVec<std::thread> arena_threads;
+    for (size_t k = 0; k != number_of_arenas_; ++k)
+    {
+        arena_threads.emplace_back(
+            [&]()
+            {
+                tbb::task_arena arena(static_cast<int>(threads_per_arena_));
+                for (size_t index = next_replica_++; index < number_of_replicas_; index = next_replica_++)
+                {
+                    arena.execute([&]()
+                                  { replica(index); });
+                    // the replicas after this one should not wait for an in-order function never called
+                    runInOrder(index, []() {});
+                }
+            });
+    }
+
+    for (auto &arena_thread : arena_threads)
+    {
+        arena_thread.join();
+    }
+}
+//=================================================================================================//
+void EnsembleRunner::runInOrder(size_t replica_index, const std::function<void()> &function)
+{
+    std::unique_lock<std::mutex> lock(order_mutex_);
+    if (is_in_order_[replica_index])
+        return;
+
+    order_condition_.wait(lock, [&]()
+                          { return next_in_order_ == replica_index; });
+    function();
+    is_in_order_[replica_index] = true;
+    next_in_order_++;
+    order_condition_.notify_all();
+}
+//=================================================================================================//
+} // namespace SPH
@@ -0,0 +1,113 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	ensemble_runner.h
+ * @brief 	Concurrent runs of the replicas of a case in one process,
+ * 			e.g. for generating regression test data or parameter sweeps.
+ * @details The TBB worker pool is partitioned into task arenas, each running one replica at a time.
+ * 			The preprocessing shared by the replicas, e.g. geometries and relaxed particles,
+ * 			is carried out only once before the replicas run.
+ * 			Each replica builds its own SPHSystem with the output and restart folders given by the replica index,
+ * 			and remembers its observations in memory, which are handed to the regression tests in the order of the replicas.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef ENSEMBLE_RUNNER_H
+#define ENSEMBLE_RUNNER_H
+
+#include "regression_test_base.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <tbb/task_arena.h>
+#include <thread>
+
+namespace SPH
+{
+/**
+ * @class EnsembleRunner
+ * @brief Runs the replicas given by their indices concurrently in task arenas.
+ * The replicas are started in the order of their indices.
+ * Note that the SPHSystem of a replica should be built with the default number of threads,
+ * as the number of threads in the global control is shared by all replicas.
+ */
+class EnsembleRunner
+{
+  public:
+    /** The number of arenas is that of the hardware threads, or the number of replicas if less, by default. */
+    explicit EnsembleRunner(size_t number_of_replicas, size_t number_of_arenas = 0);
+    virtual ~EnsembleRunner() {};
+    size_t NumberOfReplicas() { return number_of_replicas_; };
+    size_t NumberOfArenas() { return number_of_arenas_; };
+    size_t ThreadsPerArena() { return threads_per_arena_; };
+    /** The suffix of the output and restart folders of a replica. */
+    static std::string FolderSuffix(size_t replica_index) { return "_Replica" + std::to_string(replica_index); };
+    /** Run all replicas and return when they are finished. */
+    void run(const std::function<void(size_t)> &replica);
+    /** Carry out the function after those of the replicas with smaller indices, e.g. a regression test.
+     *  It is called at most once by a replica. */
+    void runInOrder(size_t replica_index, const std::function<void()> &function);
+
+  protected:
+    size_t number_of_replicas_, number_of_arenas_, threads_per_arena_;
+    std::atomic<size_t> next_replica_;
+    std::mutex order_mutex_;
+    std::condition_variable order_condition_;
+    size_t next_in_order_;
+    StdVec<bool> is_in_order_;
+};
+
+/**
+ * @class ObservationsInMemory
+ * @brief The observations are remembered in memory as snapshot * observation, besides written to file,
+ * so that they can be handed to a regression test by setObservations without reading files.
+ */
+template <class ObserveMethodType>
+class ObservationsInMemory : public ObserveMethodType
+{
+    using VariableType = decltype(ObserveMethodType::type_indicator_);
+
+  public:
+    template <typename... Args>
+    explicit ObservationsInMemory(Args &&...args) : ObserveMethodType(std::forward<Args>(args)...) {};
+    virtual ~ObservationsInMemory() {};
+    BiVector<VariableType> &Observations() { return observations_; };
+    StdVec<std::string> &ElementTags() { return element_tag_; };
+
+    virtual void writeToFile(size_t iteration = 0) override
+    {
+        ObserveMethodType::writeToFile(iteration);
+        VariableType *observed_quantities = this->getObservedQuantity();
+        observations_.push_back(
+            StdVec<VariableType>(observed_quantities, observed_quantities + this->NumberOfObservedQuantity()));
+        element_tag_.push_back("Snapshot_" + std::to_string(iteration));
+    };
+
+  protected:
+    BiVector<VariableType> observations_;
+    StdVec<std::string> element_tag_;
+};
+} // namespace SPH
+#endif // ENSEMBLE_RUNNER_H
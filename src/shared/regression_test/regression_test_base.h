@@ -98,6 +98,8 @@ class RegressionTestBase : public ObserveMethodType
     void writeResultToXml();               /** write the result to the .xml file. (all result) */
     void readResultFromXml(int run_index); /* read the result from the .xml file with the specified index. (DTW method, TA method) */
     void writeResultToXml(int run_index);  /* write the result to the .xml file with the specified index. (DTW method, TA method) */
+    /** set the current result by the observations remembered elsewhere, e.g. by a replica of an ensemble run. */
+    void setObservations(const BiVector<VariableType> &observations, const StdVec<std::string> &element_tag);
 
     /** the interface to write observed quantity into xml memory. */
     void writeToFile(size_t iteration = 0) override
@@ -117,6 +117,21 @@ void RegressionTestBase<ObserveMethodType>::rememberObservations(size_t iteratio
 }
 //=================================================================================================//
 template <class ObserveMethodType>
+void RegressionTestBase<ObserveMethodType>::setObservations(
+    const BiVector<VariableType> &observations, const StdVec<std::string> &element_tag)
+{
+    if (observations.size() != element_tag.size())
+    {
+        std::cout << "\n Error: the numbers of observations and snapshot tags are not the same!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    current_result_ = observations;
+    element_tag_ = element_tag;
+    snapshot_ = observations.size();
+}
+//=================================================================================================//
+template <class ObserveMethodType>
 void RegressionTestBase<ObserveMethodType>::transposeTheIndex()
 {
     current_result_trans_ = BiVector<VariableType>(observation_, StdVec<VariableType>(snapshot_));
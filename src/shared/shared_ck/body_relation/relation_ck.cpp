@@ -47,6 +47,39 @@ void Relation<Base>::resetComputingKernelUpdated(UnsignedInt target_index)
     }
 }
 //=================================================================================================//
+void Relation<Base>::enableCompressedNeighborList()
+{
+    if (isNeighborListCompressed())
+        return;
+
+    for (size_t k = 0; k != target_names_.size(); ++k)
+    {
+        const std::string &name = target_names_[k];
+        dv_target_neighbor_offset_.push_back(addRelationVariable<int16_t>(
+            name + "NeighborOffset", offset_list_size_ + neighbor_block_size_));
+        dv_target_escape_size_.push_back(addRelationVariable<UnsignedInt>(name + "EscapeSize", offset_list_size_));
+        dv_target_escape_offset_.push_back(addRelationVariable<UnsignedInt>(name + "EscapeOffset", offset_list_size_));
+        dv_target_escape_index_.push_back(addRelationVariable<UnsignedInt>(name + "EscapeIndex", 1));
+        resetComputingKernelUpdated(k);
+    }
+}
+//=================================================================================================//
+size_t Relation<Base>::NeighborListBytes(UnsignedInt target_index)
+{
+    UnsignedInt total_source_particles = particles_.TotalRealParticles();
+    UnsignedInt *particle_offset = dv_target_particle_offset_[target_index]->Data();
+    return (particle_offset[total_source_particles] + total_source_particles + 1) * sizeof(UnsignedInt);
+}
+//=================================================================================================//
+size_t Relation<Base>::CompressedNeighborListBytes(UnsignedInt target_index)
+{
+    UnsignedInt total_source_particles = particles_.TotalRealParticles();
+    UnsignedInt *particle_offset = dv_target_particle_offset_[target_index]->Data();
+    UnsignedInt *escape_offset = dv_target_escape_offset_[target_index]->Data();
+    return particle_offset[total_source_particles] * sizeof(int16_t) +
+           (escape_offset[total_source_particles] + 2 * (total_source_particles + 1)) * sizeof(UnsignedInt);
+}
+//=================================================================================================//
 Relation<Inner<>>::Relation(RealBody &real_body)
     : Relation<Base>(real_body, StdVec<RealBody *>{&real_body}),
       real_body_(&real_body) {}
@@ -33,8 +33,13 @@
 #include "base_particles.h"
 #include "implementation.h"
 
+#include <cstdint>
+#include <limits>
+
 namespace SPH
 {
+class Anisotropic;
+
 enum class ConfigType
 {
     Eulerian,
@@ -62,7 +67,32 @@ class Relation<Base>
     DiscreteVariable<UnsignedInt> *getParticleOffset(UnsignedInt target_index = 0);
     void registerComputingKernel(execution::Implementation<Base> *implementation, UnsignedInt target_index = 0);
     void resetComputingKernelUpdated(UnsignedInt target_index = 0);
+    /** The compressed neighbor lists are built in addition to the full-width ones by UpdateRelation. */
+    void enableCompressedNeighborList();
+    bool isNeighborListCompressed() { return !dv_target_neighbor_offset_.empty(); };
+    template <class ExecutionPolicy>
+    void compressNeighborList(const ExecutionPolicy &ex_policy, UnsignedInt total_source_particles,
+                              UnsignedInt total_neighbors, UnsignedInt target_index = 0);
+    /** Memory in bytes of the full-width and compressed neighbor lists. */
+    size_t NeighborListBytes(UnsignedInt target_index = 0);
+    size_t CompressedNeighborListBytes(UnsignedInt target_index = 0);
+    /** Neighbors are decoded in blocks of this size, so that the widening of the offsets can be vectorized. */
+    static constexpr UnsignedInt neighbor_block_size_ = 8;
+    static constexpr int16_t neighbor_offset_escape_ = std::numeric_limits<int16_t>::min();
+    static inline bool isCompressible(UnsignedInt index_i, UnsignedInt index_j)
+    {
+        int64_t offset = int64_t(index_j) - int64_t(index_i);
+        return offset > int64_t(neighbor_offset_escape_) && offset <= int64_t(std::numeric_limits<int16_t>::max());
+    };
 
+    /**
+     * @class NeighborList
+     * @brief The neighbor list of a particle given by the particle offset to the neighbor indices.
+     * If the neighbor list is compressed, the neighbor indices are also given by
+     * 16-bit signed offsets relative to the particle index. The offset of a neighbor out of the 16-bit range
+     * is replaced by an escape value, and its index is found in the escape list of the particle.
+     * The function forEachNeighbor decodes the compressed list if available.
+     */
     class NeighborList
     {
       public:
@@ -73,8 +103,50 @@ class Relation<Base>
       protected:
         UnsignedInt *neighbor_index_;
         UnsignedInt *particle_offset_;
+        int16_t *neighbor_offset_;
+        UnsignedInt *escape_offset_;
+        UnsignedInt *escape_index_;
         inline UnsignedInt FirstNeighbor(UnsignedInt i) { return particle_offset_[i]; };
         inline UnsignedInt LastNeighbor(UnsignedInt i) { return particle_offset_[i + 1]; };
+
+        template <typename FunctionOnEach>
+        inline void forEachNeighbor(UnsignedInt i, const FunctionOnEach &function)
+        {
+            if (neighbor_offset_ == nullptr)
+            {
+                for (UnsignedInt n = FirstNeighbor(i); n != LastNeighbor(i); ++n)
+                    function(neighbor_index_[n]);
+                return;
+            }
+
+            UnsignedInt escape = escape_offset_[i];
+            UnsignedInt last = LastNeighbor(i);
+            UnsignedInt block[neighbor_block_size_];
+            for (UnsignedInt n = FirstNeighbor(i); n < last; n += neighbor_block_size_)
+            {
+                // the offset list is padded by one block, therefore a full block is always decoded
+                bool has_escape = false;
+                for (UnsignedInt k = 0; k != neighbor_block_size_; ++k)
+                {
+                    int16_t offset = neighbor_offset_[n + k];
+                    block[k] = i + static_cast<UnsignedInt>(static_cast<int>(offset));
+                    has_escape |= offset == neighbor_offset_escape_;
+                }
+
+                UnsignedInt block_size = SMIN(neighbor_block_size_, last - n);
+                if (has_escape)
+                {
+                    for (UnsignedInt k = 0; k != block_size; ++k)
+                    {
+                        if (neighbor_offset_[n + k] == neighbor_offset_escape_)
+                            block[k] = escape_index_[escape++];
+                    }
+                }
+
+                for (UnsignedInt k = 0; k != block_size; ++k)
+                    function(block[k]);
+            }
+        };
     };
 
   protected:
@@ -85,7 +157,12 @@ class Relation<Base>
     UnsignedInt offset_list_size_;
     StdVec<DiscreteVariable<UnsignedInt> *> dv_target_neighbor_index_;
     StdVec<DiscreteVariable<UnsignedInt> *> dv_target_particle_offset_;
+    StdVec<DiscreteVariable<int16_t> *> dv_target_neighbor_offset_;
+    StdVec<DiscreteVariable<UnsignedInt> *> dv_target_escape_size_;
+    StdVec<DiscreteVariable<UnsignedInt> *> dv_target_escape_offset_;
+    StdVec<DiscreteVariable<UnsignedInt> *> dv_target_escape_index_;
     StdVec<StdVec<execution::Implementation<Base> *>> registered_computing_kernels_;
+    StdVec<std::string> target_names_;
 
     template <class DataType>
     DiscreteVariable<DataType> *addRelationVariable(const std::string &name, size_t data_size);
@@ -103,6 +180,14 @@ class Relation<Inner<>> : public Relation<Base>
     RealBody *real_body_;
 };
 
+template <>
+class Relation<Inner<Anisotropic>> : public Relation<Inner<>>
+{
+  public:
+    explicit Relation(RealBody &real_body) : Relation<Inner<>>(real_body) {};
+    virtual ~Relation() {};
+};
+
 template <class SourceIdentifier, class TargetIdentifier>
 class Relation<Contact<SourceIdentifier, TargetIdentifier>> : public Relation<Base>
 {
@@ -136,5 +221,17 @@ class Relation<Contact<>> : public Relation<Contact<SPHBody, RealBody>>
         : Relation<Contact<SPHBody, RealBody>>(sph_body, contact_bodies, std::forward<Args>(args)...) {}
     virtual ~Relation() {};
 };
+
+template <class SourceIdentifier, class TargetIdentifier>
+class Relation<Contact<SourceIdentifier, TargetIdentifier, Anisotropic>>
+    : public Relation<Contact<SourceIdentifier, TargetIdentifier>>
+{
+  public:
+    template <typename... Args>
+    Relation(SourceIdentifier &source_identifier, StdVec<TargetIdentifier *> contact_identifiers, Args &&...args)
+        : Relation<Contact<SourceIdentifier, TargetIdentifier>>(
+              source_identifier, contact_identifiers, std::forward<Args>(args)...) {}
+    virtual ~Relation() {};
+};
 } // namespace SPH
 #endif // RELATION_CK_H
\ No newline at end of file
@@ -3,6 +3,9 @@
 
 #include "relation_ck.h"
 
+#include "base_configuration_dynamics.h"
+#include "particle_iterators_ck.h"
+
 namespace SPH
 {
 //=================================================================================================//
@@ -25,6 +28,7 @@ Relation<Base>::Relation(SourceIdentifier &source_identifier,
             name + "NeighborIndex", offset_list_size_));
         dv_target_particle_offset_.push_back(addRelationVariable<UnsignedInt>(
             name + "ParticleOffset", offset_list_size_));
+        target_names_.push_back(name);
     }
     registered_computing_kernels_.resize(contact_identifiers.size());
 }
@@ -40,7 +44,69 @@ template <class ExecutionPolicy, class EncloserType>
 Relation<Base>::NeighborList::NeighborList(
     const ExecutionPolicy &ex_policy, EncloserType &encloser, UnsignedInt target_index)
     : neighbor_index_(encloser.dv_target_neighbor_index_[target_index]->DelegatedData(ex_policy)),
-      particle_offset_(encloser.dv_target_particle_offset_[target_index]->DelegatedData(ex_policy)) {}
+      particle_offset_(encloser.dv_target_particle_offset_[target_index]->DelegatedData(ex_policy)),
+      neighbor_offset_(nullptr), escape_offset_(nullptr), escape_index_(nullptr)
+{
+    if (encloser.isNeighborListCompressed())
+    {
+        neighbor_offset_ = encloser.dv_target_neighbor_offset_[target_index]->DelegatedData(ex_policy);
+        escape_offset_ = encloser.dv_target_escape_offset_[target_index]->DelegatedData(ex_policy);
+        escape_index_ = encloser.dv_target_escape_index_[target_index]->DelegatedData(ex_policy);
+    }
+}
+//=================================================================================================//
+template <class ExecutionPolicy>
+void Relation<Base>::compressNeighborList(const ExecutionPolicy &ex_policy, UnsignedInt total_source_particles,
+                                          UnsignedInt total_neighbors, UnsignedInt target_index)
+{
+    UnsignedInt *neighbor_index = dv_target_neighbor_index_[target_index]->DelegatedData(ex_policy);
+    UnsignedInt *particle_offset = dv_target_particle_offset_[target_index]->DelegatedData(ex_policy);
+    UnsignedInt *escape_size = dv_target_escape_size_[target_index]->DelegatedData(ex_policy);
+    UnsignedInt *escape_offset = dv_target_escape_offset_[target_index]->DelegatedData(ex_policy);
+    particle_for(ex_policy, IndexRange(0, total_source_particles),
+                 [=](size_t i)
+                 {
+                     UnsignedInt count = 0;
+                     for (UnsignedInt n = particle_offset[i]; n != particle_offset[i + 1]; ++n)
+                     {
+                         if (!isCompressible(i, neighbor_index[n]))
+                             count++;
+                     }
+                     escape_size[i] = count;
+                 });
+    UnsignedInt total_escapes = exclusive_scan(ex_policy, escape_size, escape_offset, total_source_particles + 1,
+                                               typename PlusUnsignedInt<ExecutionPolicy>::type());
+
+    DiscreteVariable<int16_t> *dv_neighbor_offset = dv_target_neighbor_offset_[target_index];
+    DiscreteVariable<UnsignedInt> *dv_escape_index = dv_target_escape_index_[target_index];
+    if (total_neighbors + neighbor_block_size_ > dv_neighbor_offset->getDataSize() ||
+        total_escapes > dv_escape_index->getDataSize())
+    {
+        dv_neighbor_offset->reallocateData(ex_policy, total_neighbors + neighbor_block_size_);
+        dv_escape_index->reallocateData(ex_policy, total_escapes);
+        resetComputingKernelUpdated(target_index);
+    }
+
+    int16_t *neighbor_offset = dv_neighbor_offset->DelegatedData(ex_policy);
+    UnsignedInt *escape_index = dv_escape_index->DelegatedData(ex_policy);
+    particle_for(ex_policy, IndexRange(0, total_source_particles),
+                 [=](size_t i)
+                 {
+                     UnsignedInt escape = escape_offset[i];
+                     for (UnsignedInt n = particle_offset[i]; n != particle_offset[i + 1]; ++n)
+                     {
+                         if (!isCompressible(i, neighbor_index[n]))
+                         {
+                             neighbor_offset[n] = neighbor_offset_escape_;
+                             escape_index[escape++] = neighbor_index[n];
+                         }
+                         else
+                         {
+                             neighbor_offset[n] = static_cast<int16_t>(int64_t(neighbor_index[n]) - int64_t(i));
+                         }
+                     }
+                 });
+}
 //=================================================================================================//
 template <class DynamicsIdentifier, class TargetIdentifier>
 template <typename... Args>
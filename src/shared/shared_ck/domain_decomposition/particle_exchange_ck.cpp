@@ -0,0 +1,260 @@
+#include "particle_exchange_ck.h"
+
+#include "base_kernel.h"
+
+namespace SPH
+{
+//=================================================================================================//
+ParticleExchangeCK::ParticleExchangeCK(RealBody &real_body, SlabDecomposition &slab_decomposition,
+                                       SharedMemoryCommunicator &communicator)
+    : particles_(&real_body.getBaseParticles()), slab_decomposition_(slab_decomposition),
+      communicator_(communicator), rank_(communicator.Rank()),
+      halo_width_(real_body.getSPHAdaptation().getKernel()->CutOffRadius()),
+      pos_(particles_->getVariableDataByName<Vecd>("Position")),
+      exchange_variables_(particles_->EvolvingVariables()), particle_data_size_(0),
+      is_halo_(particles_->ParticlesBound(), false)
+{
+    if (slab_decomposition_.NumberOfSlabs() != communicator_.NumberOfRanks())
+    {
+        std::cout << "\n Error: the number of slabs does not match the number of ranks!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    computeParticleDataSize();
+}
+//=================================================================================================//
+void ParticleExchangeCK::computeParticleDataSize()
+{
+    particle_data_size_ = 0;
+    particle_data_size_operation_(exchange_variables_, particle_data_size_);
+}
+//=================================================================================================//
+void ParticleExchangeCK::initialize()
+{
+    StdVec<UnsignedInt> not_owned;
+    for (UnsignedInt i = 0; i != particles_->TotalRealParticles(); ++i)
+    {
+        if (slab_decomposition_.SlabIndex(pos_[i]) != rank_)
+            not_owned.push_back(i);
+    }
+    removeParticles(not_owned);
+    createHaloParticles();
+}
+//=================================================================================================//
+void ParticleExchangeCK::exec()
+{
+    removeHaloParticles();
+    migrateParticles();
+    createHaloParticles();
+}
+//=================================================================================================//
+void ParticleExchangeCK::removeParticles(StdVec<UnsignedInt> &indices)
+{
+    // in descending order so that the last real particle moved in is never one to be removed
+    std::sort(indices.begin(), indices.end(), std::greater<UnsignedInt>());
+    for (UnsignedInt index : indices)
+        particles_->switchToBufferParticle(index);
+}
+//=================================================================================================//
+StdVec<UnsignedInt> ParticleExchangeCK::toIndices(const StdVec<UnsignedInt> &original_ids)
+{
+    UnsignedInt *sorted_id = particles_->ParticleSortedIds();
+    StdVec<UnsignedInt> indices;
+    indices.reserve(original_ids.size());
+    for (UnsignedInt original_id : original_ids)
+        indices.push_back(sorted_id[original_id]);
+    return indices;
+}
+//=================================================================================================//
+void ParticleExchangeCK::removeHaloParticles()
+{
+    StdVec<UnsignedInt> halo_indices = toIndices(received_from_lower_);
+    StdVec<UnsignedInt> halo_from_upper = toIndices(received_from_upper_);
+    halo_indices.insert(halo_indices.end(), halo_from_upper.begin(), halo_from_upper.end());
+    removeParticles(halo_indices);
+
+    for (UnsignedInt original_id : received_from_lower_)
+        is_halo_[original_id] = false;
+    for (UnsignedInt original_id : received_from_upper_)
+        is_halo_[original_id] = false;
+    received_from_lower_.clear();
+    received_from_upper_.clear();
+    sent_to_lower_.clear();
+    sent_to_upper_.clear();
+}
+//=================================================================================================//
+void ParticleExchangeCK::migrateParticles()
+{
+    // particles may need to pass several slabs after rebalancing
+    Real total_misplaced = MaxReal;
+    while (total_misplaced > 0.0)
+    {
+        StdVec<UnsignedInt> to_lower, to_upper;
+        for (UnsignedInt i = 0; i != particles_->TotalRealParticles(); ++i)
+        {
+            size_t slab_index = slab_decomposition_.SlabIndex(pos_[i]);
+            if (slab_index < rank_)
+                to_lower.push_back(i);
+            if (slab_index > rank_)
+                to_upper.push_back(i);
+        }
+
+        ByteBuffer to_lower_buffer, to_upper_buffer, from_lower_buffer, from_upper_buffer;
+        packParticles(to_lower, to_lower_buffer);
+        packParticles(to_upper, to_upper_buffer);
+        StdVec<UnsignedInt> leaving(to_lower);
+        leaving.insert(leaving.end(), to_upper.begin(), to_upper.end());
+        removeParticles(leaving);
+
+        exchangeWithNeighbors(to_lower_buffer, to_upper_buffer, from_lower_buffer, from_upper_buffer);
+        appendParticles(from_lower_buffer);
+        appendParticles(from_upper_buffer);
+
+        size_t misplaced = 0;
+        for (UnsignedInt i = 0; i != particles_->TotalRealParticles(); ++i)
+        {
+            if (slab_decomposition_.SlabIndex(pos_[i]) != rank_)
+                misplaced++;
+        }
+        total_misplaced = communicator_.reduceSum(Real(misplaced));
+    }
+}
+//=================================================================================================//
+void ParticleExchangeCK::createHaloParticles()
+{
+    UnsignedInt *original_id = particles_->ParticleOriginalIds();
+    Real lower_bound = slab_decomposition_.LowerBound(rank_);
+    Real upper_bound = slab_decomposition_.UpperBound(rank_);
+    int axis = slab_decomposition_.Axis();
+    StdVec<UnsignedInt> to_lower, to_upper;
+    for (UnsignedInt i = 0; i != particles_->TotalRealParticles(); ++i)
+    {
+        if (rank_ != 0 && pos_[i][axis] < lower_bound + halo_width_)
+        {
+            to_lower.push_back(i);
+            sent_to_lower_.push_back(original_id[i]);
+        }
+        if (rank_ + 1 != communicator_.NumberOfRanks() && pos_[i][axis] > upper_bound - halo_width_)
+        {
+            to_upper.push_back(i);
+            sent_to_upper_.push_back(original_id[i]);
+        }
+    }
+
+    ByteBuffer to_lower_buffer, to_upper_buffer, from_lower_buffer, from_upper_buffer;
+    packParticles(to_lower, to_lower_buffer);
+    packParticles(to_upper, to_upper_buffer);
+    exchangeWithNeighbors(to_lower_buffer, to_upper_buffer, from_lower_buffer, from_upper_buffer);
+    received_from_lower_ = appendParticles(from_lower_buffer);
+    received_from_upper_ = appendParticles(from_upper_buffer);
+
+    for (UnsignedInt halo_id : received_from_lower_)
+        is_halo_[halo_id] = true;
+    for (UnsignedInt halo_id : received_from_upper_)
+        is_halo_[halo_id] = true;
+}
+//=================================================================================================//
+void ParticleExchangeCK::updateHaloStates()
+{
+    ByteBuffer to_lower_buffer, to_upper_buffer, from_lower_buffer, from_upper_buffer;
+    packParticles(toIndices(sent_to_lower_), to_lower_buffer);
+    packParticles(toIndices(sent_to_upper_), to_upper_buffer);
+    exchangeWithNeighbors(to_lower_buffer, to_upper_buffer, from_lower_buffer, from_upper_buffer);
+    updateParticles(received_from_lower_, from_lower_buffer);
+    updateParticles(received_from_upper_, from_upper_buffer);
+}
+//=================================================================================================//
+void ParticleExchangeCK::rebalance()
+{
+    StdVec<Real> histogram(slab_decomposition_.NumberOfBins(), 0.0);
+    UnsignedInt *original_id = particles_->ParticleOriginalIds();
+    for (UnsignedInt i = 0; i != particles_->TotalRealParticles(); ++i)
+    {
+        if (!is_halo_[original_id[i]])
+            histogram[slab_decomposition_.BinIndex(pos_[i])] += 1.0;
+    }
+    communicator_.reduceSum(histogram);
+    slab_decomposition_.rebalance(histogram);
+}
+//=================================================================================================//
+size_t ParticleExchangeCK::NumberOfOwnedParticles()
+{
+    return particles_->TotalRealParticles() - received_from_lower_.size() - received_from_upper_.size();
+}
+//=================================================================================================//
+void ParticleExchangeCK::packParticles(const StdVec<UnsignedInt> &indices, ByteBuffer &buffer)
+{
+    buffer.reserve(indices.size() * particle_data_size_);
+    for (UnsignedInt index : indices)
+        pack_particle_data_(exchange_variables_, buffer, index);
+}
+//=================================================================================================//
+StdVec<UnsignedInt> ParticleExchangeCK::appendParticles(const ByteBuffer &buffer)
+{
+    size_t number_of_particles = buffer.size() / particle_data_size_;
+    size_t total_real_particles = particles_->TotalRealParticles();
+    if (total_real_particles + number_of_particles > particles_->ParticlesBound())
+    {
+        std::cout << "\n Error: the particle bound is not large enough for the exchanged particles!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+
+    UnsignedInt *original_id = particles_->ParticleOriginalIds();
+    UnsignedInt *sorted_id = particles_->ParticleSortedIds();
+    StdVec<UnsignedInt> original_ids;
+    original_ids.reserve(number_of_particles);
+    size_t offset = 0;
+    for (size_t k = 0; k != number_of_particles; ++k)
+    {
+        size_t index = total_real_particles + k;
+        unpack_particle_data_(exchange_variables_, buffer, offset, index);
+        sorted_id[original_id[index]] = index;
+        original_ids.push_back(original_id[index]);
+    }
+    particles_->incrementTotalRealParticles(number_of_particles);
+    return original_ids;
+}
+//=================================================================================================//
+void ParticleExchangeCK::updateParticles(const StdVec<UnsignedInt> &original_ids, const ByteBuffer &buffer)
+{
+    StdVec<UnsignedInt> indices = toIndices(original_ids);
+    size_t offset = 0;
+    for (UnsignedInt index : indices)
+        unpack_particle_data_(exchange_variables_, buffer, offset, index);
+}
+//=================================================================================================//
+void ParticleExchangeCK::exchangeWithNeighbors(const ByteBuffer &to_lower, const ByteBuffer &to_upper,
+                                               ByteBuffer &from_lower, ByteBuffer &from_upper)
+{
+    size_t number_of_ranks = communicator_.NumberOfRanks();
+    if (rank_ + 1 != number_of_ranks)
+    {
+        uint64_t size = to_upper.size();
+        communicator_.send(rank_ + 1, &size, sizeof(uint64_t));
+        communicator_.send(rank_ + 1, to_upper.data(), size);
+    }
+    if (rank_ != 0)
+    {
+        uint64_t size = 0;
+        communicator_.receive(rank_ - 1, &size, sizeof(uint64_t));
+        from_lower.resize(size);
+        communicator_.receive(rank_ - 1, from_lower.data(), size);
+    }
+
+    if (rank_ != 0)
+    {
+        uint64_t size = to_lower.size();
+        communicator_.send(rank_ - 1, &size, sizeof(uint64_t));
+        communicator_.send(rank_ - 1, to_lower.data(), size);
+    }
+    if (rank_ + 1 != number_of_ranks)
+    {
+        uint64_t size = 0;
+        communicator_.receive(rank_ + 1, &size, sizeof(uint64_t));
+        from_upper.resize(size);
+        communicator_.receive(rank_ + 1, from_upper.data(), size);
+    }
+}
+//=================================================================================================//
+} // namespace SPH
@@ -0,0 +1,146 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	particle_exchange_ck.h
+ * @brief 	Migration and halo exchange of particles between slab-decomposed ranks.
+ * @details	Each rank keeps the particles it owns, i.e. those in its slab,
+ *			and halo copies of the particles owned by the neighboring ranks
+ *			within one cut-off radius from its slab boundaries.
+ *			Both are real particles so that cell-linked list and relation
+ *			are built as usual. Ownership is recorded by original ids,
+ *			so that particle sorting can be carried out freely after exchange.
+ *			The states of halo particles are refreshed from their owners by
+ *			updateHaloStates after each dynamics changing the states
+ *			which are used by neighbors afterwards.
+ *			Note that only host data are exchanged.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef PARTICLE_EXCHANGE_CK_H
+#define PARTICLE_EXCHANGE_CK_H
+
+#include "base_body.h"
+#include "base_particles.hpp"
+#include "shared_memory_communicator.h"
+#include "slab_decomposition.h"
+
+namespace SPH
+{
+class ParticleExchangeCK
+{
+    using ByteBuffer = StdVec<char>;
+
+    struct ParticleDataSize
+    {
+        template <typename DataType>
+        void operator()(DataContainerAddressKeeper<DiscreteVariable<DataType>> &variables, size_t &size)
+        {
+            size += variables.size() * sizeof(DataType);
+        };
+    };
+
+    struct PackParticleData
+    {
+        template <typename DataType>
+        void operator()(DataContainerAddressKeeper<DiscreteVariable<DataType>> &variables,
+                        ByteBuffer &buffer, size_t index)
+        {
+            for (DiscreteVariable<DataType> *variable : variables)
+            {
+                const char *data = reinterpret_cast<const char *>(variable->Data() + index);
+                buffer.insert(buffer.end(), data, data + sizeof(DataType));
+            }
+        };
+    };
+
+    struct UnpackParticleData
+    {
+        template <typename DataType>
+        void operator()(DataContainerAddressKeeper<DiscreteVariable<DataType>> &variables,
+                        const ByteBuffer &buffer, size_t &offset, size_t index)
+        {
+            for (DiscreteVariable<DataType> *variable : variables)
+            {
+                memcpy(static_cast<void *>(variable->Data() + index), buffer.data() + offset, sizeof(DataType));
+                offset += sizeof(DataType);
+            }
+        };
+    };
+
+  public:
+    /** Constructed after all dynamics of the body so that all evolving variables are registered. */
+    ParticleExchangeCK(RealBody &real_body, SlabDecomposition &slab_decomposition,
+                       SharedMemoryCommunicator &communicator);
+    ~ParticleExchangeCK() {};
+    /** Add a variable to be exchanged besides the evolving variables. */
+    template <typename DataType>
+    void addVariable(const std::string &name)
+    {
+        particles_->addVariableToList<DataType>(exchange_variables_, name);
+        computeParticleDataSize();
+    };
+    /** Remove the particles not in the slab of this rank and create the halo. */
+    void initialize();
+    /** Migrate the particles leaving the slab and renew the halo.
+     * Particle sorting, cell-linked list and relation update should be carried out afterwards. */
+    void exec();
+    void updateHaloStates();
+    /** Rebalance the slabs by the present global particle distribution.
+     * The particles are migrated to the new slabs at the next exec. */
+    void rebalance();
+    size_t NumberOfOwnedParticles();
+
+  protected:
+    BaseParticles *particles_;
+    SlabDecomposition &slab_decomposition_;
+    SharedMemoryCommunicator &communicator_;
+    size_t rank_;
+    Real halo_width_;
+    Vecd *pos_;
+    ParticleVariables exchange_variables_;
+    size_t particle_data_size_;
+    StdVec<bool> is_halo_;
+    /** original ids of the halo particles sent to and received from the lower and upper neighbors */
+    StdVec<UnsignedInt> sent_to_lower_, sent_to_upper_;
+    StdVec<UnsignedInt> received_from_lower_, received_from_upper_;
+    OperationOnDataAssemble<ParticleVariables, ParticleDataSize> particle_data_size_operation_;
+    OperationOnDataAssemble<ParticleVariables, PackParticleData> pack_particle_data_;
+    OperationOnDataAssemble<ParticleVariables, UnpackParticleData> unpack_particle_data_;
+
+    void computeParticleDataSize();
+    void removeHaloParticles();
+    void removeParticles(StdVec<UnsignedInt> &indices);
+    void migrateParticles();
+    void createHaloParticles();
+    void packParticles(const StdVec<UnsignedInt> &indices, ByteBuffer &buffer);
+    /** Append received particles as real particles and return their original ids. */
+    StdVec<UnsignedInt> appendParticles(const ByteBuffer &buffer);
+    void updateParticles(const StdVec<UnsignedInt> &original_ids, const ByteBuffer &buffer);
+    StdVec<UnsignedInt> toIndices(const StdVec<UnsignedInt> &original_ids);
+    /** Send to the upper and receive from the lower neighbors first, then the reverse,
+     * so that no cyclic wait can happen in the ring buffers. */
+    void exchangeWithNeighbors(const ByteBuffer &to_lower, const ByteBuffer &to_upper,
+                               ByteBuffer &from_lower, ByteBuffer &from_upper);
+};
+} // namespace SPH
+#endif // PARTICLE_EXCHANGE_CK_H
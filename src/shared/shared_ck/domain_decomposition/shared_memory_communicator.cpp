@@ -0,0 +1,289 @@
+#include "shared_memory_communicator.h"
+
+#include <cstring>
+#include <thread>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace SPH
+{
+//=================================================================================================//
+SharedMemorySegment::SharedMemorySegment(const std::string &name, size_t size)
+    : size_(size), data_(nullptr)
+{
+#ifndef _WIN32
+    std::string segment_name = "/" + name + "_" + std::to_string(getpid());
+    int file_descriptor = shm_open(segment_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (file_descriptor == -1 || ftruncate(file_descriptor, size_) != 0)
+    {
+        std::cout << "\n Error: the shared memory segment '" << segment_name << "' can not be created!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    data_ = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, file_descriptor, 0);
+    close(file_descriptor);
+    shm_unlink(segment_name.c_str());
+    if (data_ == MAP_FAILED)
+    {
+        std::cout << "\n Error: the shared memory segment '" << segment_name << "' can not be mapped!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+#else
+    std::cout << "\n Error: shared memory segments are only supported on POSIX systems!" << std::endl;
+    std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+    exit(1);
+#endif
+}
+//=================================================================================================//
+SharedMemorySegment::~SharedMemorySegment()
+{
+#ifndef _WIN32
+    if (data_ != nullptr)
+        munmap(data_, size_);
+#endif
+}
+//=================================================================================================//
+SharedMemoryRingBuffer::SharedMemoryRingBuffer(void *memory, size_t capacity)
+    : header_(static_cast<Header *>(memory)),
+      buffer_(static_cast<char *>(memory) + sizeof(Header)), capacity_(capacity) {}
+//=================================================================================================//
+void SharedMemoryRingBuffer::initialize()
+{
+    new (header_) Header();
+    header_->head_.store(0);
+    header_->tail_.store(0);
+}
+//=================================================================================================//
+void SharedMemoryRingBuffer::write(const void *data, size_t size)
+{
+    const char *source = static_cast<const char *>(data);
+    uint64_t head = header_->head_.load(std::memory_order_relaxed);
+    while (size != 0)
+    {
+        uint64_t free_size = capacity_ - (head - header_->tail_.load(std::memory_order_acquire));
+        if (free_size == 0)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        uint64_t offset = head % capacity_;
+        uint64_t chunk_size = SMIN(SMIN(uint64_t(size), free_size), capacity_ - offset);
+        std::memcpy(buffer_ + offset, source, chunk_size);
+        head += chunk_size;
+        source += chunk_size;
+        size -= chunk_size;
+        header_->head_.store(head, std::memory_order_release);
+    }
+}
+//=================================================================================================//
+void SharedMemoryRingBuffer::read(void *data, size_t size)
+{
+    char *target = static_cast<char *>(data);
+    uint64_t tail = header_->tail_.load(std::memory_order_relaxed);
+    while (size != 0)
+    {
+        uint64_t available_size = header_->head_.load(std::memory_order_acquire) - tail;
+        if (available_size == 0)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        uint64_t offset = tail % capacity_;
+        uint64_t chunk_size = SMIN(SMIN(uint64_t(size), available_size), capacity_ - offset);
+        std::memcpy(target, buffer_ + offset, chunk_size);
+        tail += chunk_size;
+        target += chunk_size;
+        size -= chunk_size;
+        header_->tail_.store(tail, std::memory_order_release);
+    }
+}
+//=================================================================================================//
+SharedMemoryCommunicator::SharedMemoryCommunicator(
+    size_t number_of_ranks, size_t ring_buffer_capacity, size_t reduce_capacity)
+    : number_of_ranks_(number_of_ranks), rank_(0), reduce_capacity_(reduce_capacity),
+      control_block_(nullptr), reduce_slots_(nullptr),
+      to_upper_(number_of_ranks, nullptr), to_lower_(number_of_ranks, nullptr)
+{
+    size_t control_size = (sizeof(ControlBlock) + 63) / 64 * 64;
+    size_t reduce_size = number_of_ranks * reduce_capacity * sizeof(Real);
+    size_t ring_buffer_size = (SharedMemoryRingBuffer::RequiredMemory(ring_buffer_capacity) + 63) / 64 * 64;
+    size_t number_of_ring_buffers = 2 * (number_of_ranks - 1);
+    SharedMemorySegment *segment = segment_keeper_.createPtr<SharedMemorySegment>(
+        "SPHinXsysCommunicator", control_size + reduce_size + number_of_ring_buffers * ring_buffer_size);
+
+    char *memory = static_cast<char *>(segment->Data());
+    control_block_ = new (memory) ControlBlock();
+    control_block_->barrier_count_.store(0);
+    control_block_->barrier_generation_.store(0);
+    reduce_slots_ = reinterpret_cast<Real *>(memory + control_size);
+
+    char *ring_buffer_memory = memory + control_size + reduce_size;
+    for (size_t i = 0; i + 1 < number_of_ranks; ++i)
+    {
+        to_upper_[i] = ring_buffer_ptrs_.createPtr<SharedMemoryRingBuffer>(ring_buffer_memory, ring_buffer_capacity);
+        to_upper_[i]->initialize();
+        ring_buffer_memory += ring_buffer_size;
+        to_lower_[i + 1] = ring_buffer_ptrs_.createPtr<SharedMemoryRingBuffer>(ring_buffer_memory, ring_buffer_capacity);
+        to_lower_[i + 1]->initialize();
+        ring_buffer_memory += ring_buffer_size;
+    }
+}
+//=================================================================================================//
+size_t SharedMemoryCommunicator::runOnRanks(const std::function<void(size_t)> &rank_task, bool pin_to_cores)
+{
+    size_t number_of_failures = 0;
+#ifndef _WIN32
+    std::cout.flush();
+    StdVec<pid_t> process_ids;
+    for (size_t rank = 0; rank != number_of_ranks_; ++rank)
+    {
+        pid_t process_id = fork();
+        if (process_id == 0)
+        {
+            rank_ = rank;
+            if (pin_to_cores)
+                pinToCores();
+            int exit_status = 0;
+            try
+            {
+                rank_task(rank);
+            }
+            catch (const std::exception &e)
+            {
+                std::cout << "\n Error on rank " << rank << ": " << e.what() << std::endl;
+                exit_status = 1;
+            }
+            std::cout.flush();
+            _exit(exit_status);
+        }
+        process_ids.push_back(process_id);
+    }
+
+    for (pid_t process_id : process_ids)
+    {
+        int status = 0;
+        waitpid(process_id, &status, 0);
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+            number_of_failures++;
+    }
+#else
+    std::cout << "\n Error: running on multiple processes is only supported on POSIX systems!" << std::endl;
+    std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+    exit(1);
+#endif
+    return number_of_failures;
+}
+//=================================================================================================//
+void SharedMemoryCommunicator::pinToCores()
+{
+#ifdef __linux__
+    size_t number_of_cores = std::thread::hardware_concurrency();
+    if (number_of_cores >= number_of_ranks_)
+    {
+        size_t cores_per_rank = number_of_cores / number_of_ranks_;
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        for (size_t k = rank_ * cores_per_rank; k != (rank_ + 1) * cores_per_rank; ++k)
+            CPU_SET(k, &cpu_set);
+        sched_setaffinity(0, sizeof(cpu_set_t), &cpu_set);
+    }
+#endif
+}
+//=================================================================================================//
+void SharedMemoryCommunicator::barrier()
+{
+    uint64_t generation = control_block_->barrier_generation_.load(std::memory_order_acquire);
+    if (control_block_->barrier_count_.fetch_add(1, std::memory_order_acq_rel) + 1 == number_of_ranks_)
+    {
+        control_block_->barrier_count_.store(0, std::memory_order_relaxed);
+        control_block_->barrier_generation_.fetch_add(1, std::memory_order_acq_rel);
+    }
+    else
+    {
+        while (control_block_->barrier_generation_.load(std::memory_order_acquire) == generation)
+            std::this_thread::yield();
+    }
+}
+//=================================================================================================//
+template <typename ReduceFunction>
+Real SharedMemoryCommunicator::allReduce(Real value, const ReduceFunction &reduce_function)
+{
+    reduce_slots_[rank_ * reduce_capacity_] = value;
+    barrier();
+    Real result = reduce_slots_[0];
+    for (size_t k = 1; k != number_of_ranks_; ++k)
+        result = reduce_function(result, reduce_slots_[k * reduce_capacity_]);
+    barrier(); // slots can be reused only after all ranks have read
+    return result;
+}
+//=================================================================================================//
+Real SharedMemoryCommunicator::reduceMin(Real value)
+{
+    return allReduce(value, [](Real a, Real b)
+                     { return SMIN(a, b); });
+}
+//=================================================================================================//
+Real SharedMemoryCommunicator::reduceMax(Real value)
+{
+    return allReduce(value, [](Real a, Real b)
+                     { return SMAX(a, b); });
+}
+//=================================================================================================//
+Real SharedMemoryCommunicator::reduceSum(Real value)
+{
+    return allReduce(value, [](Real a, Real b)
+                     { return a + b; });
+}
+//=================================================================================================//
+void SharedMemoryCommunicator::reduceSum(StdVec<Real> &values)
+{
+    if (values.size() > reduce_capacity_)
+    {
+        std::cout << "\n Error: the size of reduced values exceeds the reduce capacity!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    std::copy(values.begin(), values.end(), reduce_slots_ + rank_ * reduce_capacity_);
+    barrier();
+    for (size_t i = 0; i != values.size(); ++i)
+    {
+        values[i] = reduce_slots_[i];
+        for (size_t k = 1; k != number_of_ranks_; ++k)
+            values[i] += reduce_slots_[k * reduce_capacity_ + i];
+    }
+    barrier();
+}
+//=================================================================================================//
+SharedMemoryRingBuffer &SharedMemoryCommunicator::getRingBuffer(size_t from_rank, size_t to_rank)
+{
+    if (to_rank == from_rank + 1)
+        return *to_upper_[from_rank];
+    if (to_rank + 1 == from_rank)
+        return *to_lower_[from_rank];
+
+    std::cout << "\n Error: rank " << from_rank << " and rank " << to_rank << " are not neighbors!" << std::endl;
+    std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+    exit(1);
+}
+//=================================================================================================//
+void SharedMemoryCommunicator::send(size_t to_rank, const void *data, size_t size)
+{
+    getRingBuffer(rank_, to_rank).write(data, size);
+}
+//=================================================================================================//
+void SharedMemoryCommunicator::receive(size_t from_rank, void *data, size_t size)
+{
+    getRingBuffer(from_rank, rank_).read(data, size);
+}
+//=================================================================================================//
+} // namespace SPH
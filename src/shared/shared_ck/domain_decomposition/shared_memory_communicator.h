@@ -0,0 +1,141 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	shared_memory_communicator.h
+ * @brief 	Communication between processes on a single node
+ *			through POSIX shared memory.
+ * @details	The communicator is created by the parent process before any
+ *			threading is started. It forks one process per rank, which can be
+ *			pinned to a contiguous group of cores, e.g. a NUMA domain.
+ *			The ranks exchange data through single-producer single-consumer
+ *			ring buffers between neighboring ranks, and synchronize with
+ *			a spinning barrier and all-reduce operations in the shared segment.
+ *			No MPI or network is involved.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef SHARED_MEMORY_COMMUNICATOR_H
+#define SHARED_MEMORY_COMMUNICATOR_H
+
+#include "base_data_package.h"
+#include "sphinxsys_containers.h"
+
+#include <atomic>
+#include <functional>
+
+namespace SPH
+{
+/**
+ * @class SharedMemorySegment
+ * @brief A POSIX shared memory segment which is mapped into the memory of
+ * the creating process and inherited by the processes forked afterwards.
+ * The name is unlinked right after mapping, so that no residual remains.
+ */
+class SharedMemorySegment
+{
+  public:
+    SharedMemorySegment(const std::string &name, size_t size);
+    ~SharedMemorySegment();
+    void *Data() { return data_; };
+    size_t Size() { return size_; };
+
+  protected:
+    size_t size_;
+    void *data_;
+};
+
+/**
+ * @class SharedMemoryRingBuffer
+ * @brief Single-producer single-consumer byte ring buffer placed in shared memory.
+ * Head and tail count the total bytes written and read, respectively.
+ * Messages larger than the capacity are streamed through in chunks.
+ */
+class SharedMemoryRingBuffer
+{
+    struct Header
+    {
+        std::atomic<uint64_t> head_;
+        std::atomic<uint64_t> tail_;
+    };
+    static_assert(std::atomic<uint64_t>::is_always_lock_free,
+                  "Lock-free atomics are required for inter-process ring buffers.");
+
+  public:
+    SharedMemoryRingBuffer(void *memory, size_t capacity);
+    ~SharedMemoryRingBuffer() {};
+    static size_t RequiredMemory(size_t capacity) { return sizeof(Header) + capacity; };
+    void initialize();
+    void write(const void *data, size_t size);
+    void read(void *data, size_t size);
+
+  protected:
+    Header *header_;
+    char *buffer_;
+    uint64_t capacity_;
+};
+
+class SharedMemoryCommunicator
+{
+    struct ControlBlock
+    {
+        std::atomic<uint64_t> barrier_count_;
+        std::atomic<uint64_t> barrier_generation_;
+    };
+    UniquePtrKeeper<SharedMemorySegment> segment_keeper_;
+    UniquePtrsKeeper<SharedMemoryRingBuffer> ring_buffer_ptrs_;
+
+  public:
+    /** Constructed in the parent process before any thread is started. */
+    SharedMemoryCommunicator(size_t number_of_ranks, size_t ring_buffer_capacity = 1 << 24,
+                             size_t reduce_capacity = 4096);
+    ~SharedMemoryCommunicator() {};
+    size_t NumberOfRanks() { return number_of_ranks_; };
+    size_t Rank() { return rank_; };
+    /** Fork one process per rank, run the task and wait. Returns the number of failed ranks. */
+    size_t runOnRanks(const std::function<void(size_t)> &rank_task, bool pin_to_cores = true);
+
+    void barrier();
+    Real reduceMin(Real value);
+    Real reduceMax(Real value);
+    Real reduceSum(Real value);
+    void reduceSum(StdVec<Real> &values);
+    /** Only neighboring ranks are connected by ring buffers. */
+    void send(size_t to_rank, const void *data, size_t size);
+    void receive(size_t from_rank, void *data, size_t size);
+
+  protected:
+    size_t number_of_ranks_;
+    size_t rank_;
+    size_t reduce_capacity_;
+    ControlBlock *control_block_;
+    Real *reduce_slots_;
+    /** ring buffers from rank i to its upper (i + 1) and lower (i - 1) neighbors */
+    StdVec<SharedMemoryRingBuffer *> to_upper_, to_lower_;
+
+    SharedMemoryRingBuffer &getRingBuffer(size_t from_rank, size_t to_rank);
+    void pinToCores();
+    template <typename ReduceFunction>
+    Real allReduce(Real value, const ReduceFunction &reduce_function);
+};
+} // namespace SPH
+#endif // SHARED_MEMORY_COMMUNICATOR_H
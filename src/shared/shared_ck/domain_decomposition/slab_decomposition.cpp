@@ -0,0 +1,74 @@
+#include "slab_decomposition.h"
+
+namespace SPH
+{
+//=================================================================================================//
+SlabDecomposition::SlabDecomposition(const BoundingBox &system_domain_bounds, size_t number_of_slabs,
+                                     size_t number_of_bins_per_slab)
+    : SlabDecomposition(system_domain_bounds, number_of_slabs,
+                        getLongestAxis(system_domain_bounds), number_of_bins_per_slab) {}
+//=================================================================================================//
+SlabDecomposition::SlabDecomposition(const BoundingBox &system_domain_bounds, size_t number_of_slabs,
+                                     int axis, size_t number_of_bins_per_slab)
+    : axis_(axis), number_of_slabs_(number_of_slabs),
+      number_of_bins_(number_of_slabs * number_of_bins_per_slab),
+      lower_bound_(system_domain_bounds.first_[axis]),
+      upper_bound_(system_domain_bounds.second_[axis]),
+      bin_size_((upper_bound_ - lower_bound_) / Real(number_of_bins_)),
+      slab_bounds_(number_of_slabs + 1)
+{
+    Real slab_size = (upper_bound_ - lower_bound_) / Real(number_of_slabs_);
+    for (size_t k = 0; k != number_of_slabs_; ++k)
+        slab_bounds_[k] = lower_bound_ + Real(k) * slab_size;
+    slab_bounds_[number_of_slabs_] = upper_bound_;
+}
+//=================================================================================================//
+int SlabDecomposition::getLongestAxis(const BoundingBox &system_domain_bounds)
+{
+    Vecd bound_size = system_domain_bounds.second_ - system_domain_bounds.first_;
+    int longest_axis = 0;
+    for (int k = 1; k != Dimensions; ++k)
+    {
+        if (bound_size[k] > bound_size[longest_axis])
+            longest_axis = k;
+    }
+    return longest_axis;
+}
+//=================================================================================================//
+size_t SlabDecomposition::SlabIndex(const Vecd &position)
+{
+    Real coordinate = position[axis_];
+    auto upper = std::upper_bound(slab_bounds_.begin() + 1, slab_bounds_.end() - 1, coordinate);
+    return upper - (slab_bounds_.begin() + 1);
+}
+//=================================================================================================//
+size_t SlabDecomposition::BinIndex(const Vecd &position)
+{
+    int bin_index = (int)floor((position[axis_] - lower_bound_) / bin_size_);
+    return SMIN(size_t(SMAX(bin_index, 0)), number_of_bins_ - 1);
+}
+//=================================================================================================//
+void SlabDecomposition::rebalance(const StdVec<Real> &particle_histogram)
+{
+    Real total_particles = std::accumulate(particle_histogram.begin(), particle_histogram.end(), Real(0));
+    Real target_particles = total_particles / Real(number_of_slabs_);
+    Real accumulated_particles = 0.0;
+    size_t slab_index = 1;
+    for (size_t k = 0; k != number_of_bins_ && slab_index != number_of_slabs_; ++k)
+    {
+        Real bin_particles = particle_histogram[k];
+        while (slab_index != number_of_slabs_ &&
+               accumulated_particles + bin_particles >= Real(slab_index) * target_particles)
+        {
+            // interpolate linearly within the bin
+            Real fraction = bin_particles > 0.0
+                                ? (Real(slab_index) * target_particles - accumulated_particles) / bin_particles
+                                : 0.0;
+            slab_bounds_[slab_index] = lower_bound_ + (Real(k) + fraction) * bin_size_;
+            slab_index++;
+        }
+        accumulated_particles += bin_particles;
+    }
+}
+//=================================================================================================//
+} // namespace SPH
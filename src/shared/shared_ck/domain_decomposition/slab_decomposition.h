@@ -0,0 +1,71 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	slab_decomposition.h
+ * @brief 	Spatial decomposition of the system domain bounds into slabs.
+ * @details	The slabs are normal to one axis, by default the longest one of the
+ *			system domain. Each slab is owned by one rank. The slab boundaries
+ *			are rebalanced from a particle-count histogram along the axis
+ *			so that all ranks own approximately the same number of particles.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef SLAB_DECOMPOSITION_H
+#define SLAB_DECOMPOSITION_H
+
+#include "base_data_package.h"
+#include "sphinxsys_containers.h"
+
+namespace SPH
+{
+class SlabDecomposition
+{
+  public:
+    SlabDecomposition(const BoundingBox &system_domain_bounds, size_t number_of_slabs,
+                      size_t number_of_bins_per_slab = 64);
+    SlabDecomposition(const BoundingBox &system_domain_bounds, size_t number_of_slabs,
+                      int axis, size_t number_of_bins_per_slab);
+    ~SlabDecomposition() {};
+
+    int Axis() { return axis_; };
+    size_t NumberOfSlabs() { return number_of_slabs_; };
+    Real LowerBound(size_t slab_index) { return slab_bounds_[slab_index]; };
+    Real UpperBound(size_t slab_index) { return slab_bounds_[slab_index + 1]; };
+    /** Positions outside of the domain are assigned to the first or last slab. */
+    size_t SlabIndex(const Vecd &position);
+    size_t NumberOfBins() { return number_of_bins_; };
+    size_t BinIndex(const Vecd &position);
+    /** The histogram gives the number of particles in each bin of the whole domain. */
+    void rebalance(const StdVec<Real> &particle_histogram);
+
+  protected:
+    int axis_;
+    size_t number_of_slabs_;
+    size_t number_of_bins_;
+    Real lower_bound_, upper_bound_, bin_size_;
+    StdVec<Real> slab_bounds_;
+
+    int getLongestAxis(const BoundingBox &system_domain_bounds);
+};
+} // namespace SPH
+#endif // SLAB_DECOMPOSITION_H
@@ -30,5 +30,6 @@
 
 #include "all_shared_physical_dynamics_ck.h"
 #include "io_all_ck.h"
+#include "particle_exchange_ck.h"
 #include "sphinxsys.h"
 #endif // SPHINXSYS_CK_H
@@ -0,0 +1,351 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	io_vtk_grid_ck.h
+ * @brief 	Write particle variables resampled on a Cartesian grid.
+ * @details The grid points gather from the particles of all recorded bodies
+ *			found by the cell linked lists of the bodies,
+ *			and the variables are given by Shepard interpolation.
+ *			The total weight is also written, so that the grid points away from the bodies,
+ *			which have zero weight, can be masked in post-processing.
+ *			The result is written as VTK ImageData with raw binary appended data.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef IO_VTK_GRID_CK_H
+#define IO_VTK_GRID_CK_H
+
+#include "io_base.h"
+
+#include "base_body.h"
+#include "cell_linked_list.hpp"
+#include "execution_policy.h"
+#include "io_environment.h"
+#include "kernel_tabulated_ck.h"
+#include "particle_iterators.h"
+
+namespace SPH
+{
+template <class ExecutionPolicy>
+class BodyStatesRecordingToVtiCK : public BodyStatesRecording
+{
+    template <typename DataType>
+    struct GridVariable
+    {
+        std::string name_;
+        StdVec<DiscreteVariable<DataType> *> body_variables_; // nullptr for the bodies without the variable
+        StdVec<DataType> values_;
+        StdVec<Real> weights_;
+    };
+
+  public:
+    BodyStatesRecordingToVtiCK(SPHSystem &sph_system, const BoundingBox &grid_bounds,
+                               Real grid_spacing, const std::string &grid_name = "GridStates")
+        : BodyStatesRecording(sph_system), grid_name_(grid_name),
+          origin_(grid_bounds.first_), grid_spacing_(grid_spacing),
+          number_of_grid_points_(
+              ((grid_bounds.second_ - grid_bounds.first_).array() / grid_spacing).floor().template cast<int>() +
+              Arrayi::Ones()),
+          total_grid_points_(number_of_grid_points_.prod()),
+          is_body_recorded_(bodies_.size(), false)
+    {
+        grid_positions_.resize(total_grid_points_);
+        for (size_t k = 0; k != total_grid_points_; ++k)
+        {
+            grid_positions_[k] = origin_ + grid_spacing_ * GridIndex(k).template cast<Real>().matrix();
+        }
+        total_weights_.resize(total_grid_points_, 0.0);
+
+        for (SPHBody *body : bodies_)
+        {
+            kernels_.push_back(KernelTabulatedCK(*body->getSPHAdaptation().getKernel()));
+        }
+    };
+    virtual ~BodyStatesRecordingToVtiCK() {};
+
+    template <typename DataType>
+    void addToWrite(SPHBody &sph_body, const std::string &name)
+    {
+        auto body_iterator = std::find(bodies_.begin(), bodies_.end(), &sph_body);
+        if (body_iterator == bodies_.end())
+        {
+            std::cout << "\n Error: the body:" << sph_body.getName()
+                      << " is not in the recording list" << std::endl;
+            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+            exit(1);
+        }
+        size_t body_index = body_iterator - bodies_.begin();
+        is_body_recorded_[body_index] = true;
+
+        StdVec<GridVariable<DataType>> &grid_variables = getGridVariables<DataType>();
+        auto variable_iterator = std::find_if(grid_variables.begin(), grid_variables.end(),
+                                              [&](const GridVariable<DataType> &variable)
+                                              { return variable.name_ == name; });
+        if (variable_iterator == grid_variables.end())
+        {
+            grid_variables.push_back(GridVariable<DataType>{
+                name, StdVec<DiscreteVariable<DataType> *>(bodies_.size(), nullptr),
+                StdVec<DataType>(total_grid_points_, ZeroData<DataType>::value),
+                StdVec<Real>(total_grid_points_, 0.0)});
+            variable_iterator = grid_variables.end() - 1;
+        }
+        variable_iterator->body_variables_[body_index] =
+            sph_body.getBaseParticles().template getVariableByName<DataType>(name);
+    };
+
+    template <typename DataType>
+    DataType *getGridValues(const std::string &name)
+    {
+        for (GridVariable<DataType> &variable : getGridVariables<DataType>())
+        {
+            if (variable.name_ == name)
+                return variable.values_.data();
+        }
+        return nullptr;
+    };
+    Real *getTotalWeights() { return total_weights_.data(); };
+    Vecd *getGridPositions() { return grid_positions_.data(); };
+    size_t TotalGridPoints() { return total_grid_points_; };
+
+  protected:
+    std::string grid_name_;
+    Vecd origin_;
+    Real grid_spacing_;
+    Arrayi number_of_grid_points_;
+    size_t total_grid_points_;
+    StdVec<Vecd> grid_positions_;
+    StdVec<Real> total_weights_;
+    StdVec<bool> is_body_recorded_;
+    StdVec<KernelTabulatedCK> kernels_;
+    StdVec<GridVariable<Real>> real_variables_;
+    StdVec<GridVariable<Vecd>> vector_variables_;
+
+    Arrayi GridIndex(size_t linear_index)
+    {
+        Arrayi grid_index = Arrayi::Zero();
+        for (int d = 0; d != Dimensions; ++d)
+        {
+            grid_index[d] = linear_index % number_of_grid_points_[d];
+            linear_index /= number_of_grid_points_[d];
+        }
+        return grid_index;
+    };
+
+    template <typename DataType>
+    StdVec<GridVariable<DataType>> &getGridVariables()
+    {
+        static_assert(std::is_same_v<DataType, Real> || std::is_same_v<DataType, Vecd>,
+                      "Only Real and Vecd variables can be resampled on the grid.");
+        if constexpr (std::is_same_v<DataType, Real>)
+            return real_variables_;
+        else
+            return vector_variables_;
+    };
+
+    template <typename DataType>
+    void resetGridVariables()
+    {
+        for (GridVariable<DataType> &variable : getGridVariables<DataType>())
+        {
+            std::fill(variable.values_.begin(), variable.values_.end(), ZeroData<DataType>::value);
+            std::fill(variable.weights_.begin(), variable.weights_.end(), Real(0));
+        }
+    };
+
+    template <typename DataType>
+    StdVec<StdVec<DataType *>> prepareBodyData()
+    {
+        StdVec<StdVec<DataType *>> body_data;
+        for (GridVariable<DataType> &variable : getGridVariables<DataType>())
+        {
+            StdVec<DataType *> data(bodies_.size(), nullptr);
+            for (size_t b = 0; b != bodies_.size(); ++b)
+            {
+                if (variable.body_variables_[b] != nullptr)
+                {
+                    variable.body_variables_[b]->prepareForOutput(ExecutionPolicy{});
+                    data[b] = variable.body_variables_[b]->Data();
+                }
+            }
+            body_data.push_back(data);
+        }
+        return body_data;
+    };
+
+    template <typename DataType>
+    void normalizeGridVariables()
+    {
+        for (GridVariable<DataType> &variable : getGridVariables<DataType>())
+        {
+            for (size_t k = 0; k != total_grid_points_; ++k)
+            {
+                if (variable.weights_[k] > Eps)
+                    variable.values_[k] /= variable.weights_[k];
+            }
+        }
+    };
+
+    /** The grid points are gathered on the host in parallel as the data are needed there for writing. */
+    void resampleToGrid()
+    {
+        std::fill(total_weights_.begin(), total_weights_.end(), Real(0));
+        resetGridVariables<Real>();
+        resetGridVariables<Vecd>();
+        StdVec<StdVec<Real *>> real_data = prepareBodyData<Real>();
+        StdVec<StdVec<Vecd *>> vector_data = prepareBodyData<Vecd>();
+
+        for (size_t b = 0; b != bodies_.size(); ++b)
+        {
+            if (!is_body_recorded_[b])
+                continue;
+
+            BaseParticles &particles = bodies_[b]->getBaseParticles();
+            particles.dvParticlePosition()->prepareForOutput(ExecutionPolicy{});
+            DiscreteVariable<Real> *dv_Vol = particles.template getVariableByName<Real>("VolumetricMeasure");
+            dv_Vol->prepareForOutput(ExecutionPolicy{});
+            CellLinkedList &cell_linked_list =
+                DynamicCast<CellLinkedList>(this, DynamicCast<RealBody>(this, bodies_[b])->getCellLinkedList());
+            cell_linked_list.dvParticleIndex()->prepareForOutput(ExecutionPolicy{});
+            cell_linked_list.dvCellOffset()->prepareForOutput(ExecutionPolicy{});
+
+            NeighborSearch neighbor_search = cell_linked_list.createNeighborSearch(execution::ParallelPolicy());
+            KernelTabulatedCK &kernel = kernels_[b];
+            Real cut_radius_sqr = kernel.CutOffRadiusSqr();
+            Vecd *pos = particles.ParticlePositions();
+            Real *Vol = dv_Vol->Data();
+            Vecd *grid_pos = grid_positions_.data();
+
+            particle_for(execution::ParallelPolicy(), IndexRange(0, total_grid_points_),
+                         [&](size_t k)
+                         {
+                             neighbor_search.forEachSearch(
+                                 k, grid_pos,
+                                 [&](size_t j)
+                                 {
+                                     Vecd displacement = grid_pos[k] - pos[j];
+                                     if (displacement.squaredNorm() < cut_radius_sqr)
+                                     {
+                                         Real weight = kernel.W(displacement) * Vol[j];
+                                         total_weights_[k] += weight;
+                                         for (size_t v = 0; v != real_variables_.size(); ++v)
+                                         {
+                                             if (real_data[v][b] != nullptr)
+                                             {
+                                                 real_variables_[v].values_[k] += weight * real_data[v][b][j];
+                                                 real_variables_[v].weights_[k] += weight;
+                                             }
+                                         }
+                                         for (size_t v = 0; v != vector_variables_.size(); ++v)
+                                         {
+                                             if (vector_data[v][b] != nullptr)
+                                             {
+                                                 vector_variables_[v].values_[k] += weight * vector_data[v][b][j];
+                                                 vector_variables_[v].weights_[k] += weight;
+                                             }
+                                         }
+                                     }
+                                 });
+                         });
+        }
+        normalizeGridVariables<Real>();
+        normalizeGridVariables<Vecd>();
+    };
+
+    template <typename DataType>
+    void writeDataArrayHeaders(std::ofstream &out_file, size_t &offset, size_t components)
+    {
+        for (GridVariable<DataType> &variable : getGridVariables<DataType>())
+        {
+            writeDataArrayHeader(out_file, variable.name_, offset, components);
+        }
+    };
+
+    void writeDataArrayHeader(std::ofstream &out_file, const std::string &name, size_t &offset, size_t components)
+    {
+        out_file << "    <DataArray type=\"" << (sizeof(Real) == 4 ? "Float32" : "Float64")
+                 << "\" Name=\"" << name << "\" NumberOfComponents=\"" << components
+                 << "\" format=\"appended\" offset=\"" << offset << "\"/>\n";
+        offset += sizeof(uint64_t) + total_grid_points_ * components * sizeof(Real);
+    };
+
+    void writeDataBlock(std::ofstream &out_file, const Real *data, size_t components)
+    {
+        uint64_t number_of_bytes = total_grid_points_ * components * sizeof(Real);
+        out_file.write(reinterpret_cast<const char *>(&number_of_bytes), sizeof(uint64_t));
+        out_file.write(reinterpret_cast<const char *>(data), number_of_bytes);
+    };
+
+    virtual void writeWithFileName(const std::string &sequence) override
+    {
+        if (!state_recording_)
+            return;
+
+        resampleToGrid();
+
+        std::string filefullpath = io_environment_.output_folder_ + "/" + grid_name_ + "_" + sequence + ".vti";
+        std::ofstream out_file(filefullpath.c_str(), std::ios::trunc | std::ios::binary);
+
+        Vec3d origin = upgradeToVec3d(origin_);
+        std::stringstream extent;
+        for (int d = 0; d != 3; ++d)
+        {
+            extent << "0 " << (d < Dimensions ? number_of_grid_points_[d] - 1 : 0) << (d != 2 ? " " : "");
+        }
+        out_file << "<?xml version=\"1.0\"?>\n";
+        out_file << "<VTKFile type=\"ImageData\" version=\"1.0\" byte_order=\"LittleEndian\" header_type=\"UInt64\">\n";
+        out_file << " <ImageData WholeExtent=\"" << extent.str() << "\" Origin=\""
+                 << origin[0] << " " << origin[1] << " " << origin[2] << "\" Spacing=\""
+                 << grid_spacing_ << " " << grid_spacing_ << " " << grid_spacing_ << "\">\n";
+        out_file << "  <Piece Extent=\"" << extent.str() << "\">\n";
+        out_file << "   <PointData>\n";
+        size_t offset = 0;
+        writeDataArrayHeader(out_file, "TotalWeight", offset, 1);
+        writeDataArrayHeaders<Real>(out_file, offset, 1);
+        writeDataArrayHeaders<Vecd>(out_file, offset, 3);
+        out_file << "   </PointData>\n";
+        out_file << "  </Piece>\n";
+        out_file << " </ImageData>\n";
+        out_file << " <AppendedData encoding=\"raw\">\n_";
+
+        writeDataBlock(out_file, total_weights_.data(), 1);
+        for (GridVariable<Real> &variable : real_variables_)
+        {
+            writeDataBlock(out_file, variable.values_.data(), 1);
+        }
+        StdVec<Vec3d> vectors(total_grid_points_);
+        for (GridVariable<Vecd> &variable : vector_variables_)
+        {
+            for (size_t k = 0; k != total_grid_points_; ++k)
+            {
+                vectors[k] = upgradeToVec3d(variable.values_[k]);
+            }
+            writeDataBlock(out_file, vectors[0].data(), 3);
+        }
+
+        out_file << "\n </AppendedData>\n";
+        out_file << "</VTKFile>\n";
+        out_file.close();
+    };
+};
+} // namespace SPH
+#endif // IO_VTK_GRID_CK_H
@@ -7,4 +7,9 @@ Neighbor<>::NeighborCriterion::NeighborCriterion(Neighbor<> &neighbor)
     : source_pos_(neighbor.source_pos_), target_pos_(neighbor.target_pos_),
       cut_radius_square_(neighbor.getKernel().CutOffRadiusSqr()) {}
 //=================================================================================================//
+Neighbor<Anisotropic>::NeighborCriterion::NeighborCriterion(Neighbor<Anisotropic> &neighbor)
+    : source_pos_(neighbor.source_pos_), target_pos_(neighbor.target_pos_),
+      source_transform_(neighbor.source_transform_), target_transform_(neighbor.target_transform_),
+      cut_radius_square_(neighbor.getKernel().CutOffRadiusSqr()) {}
+//=================================================================================================//
 } // namespace SPH
@@ -36,6 +36,8 @@
 
 namespace SPH
 {
+class Anisotropic;
+
 template <typename... T>
 class Neighbor;
 
@@ -80,5 +82,80 @@ class Neighbor<>
     Vecd *source_pos_;
     Vecd *target_pos_;
 };
+
+/**
+ * Interaction kernels not assuming a unit e_ij declare
+ * `static constexpr bool anisotropy_aware = true;`
+ * so that they can be used with an anisotropic neighborhood.
+ */
+template <class T, class = void>
+struct is_anisotropy_aware : std::false_type
+{
+};
+
+template <class T>
+struct is_anisotropy_aware<T, std::void_t<decltype(T::anisotropy_aware)>>
+    : std::integral_constant<bool, T::anisotropy_aware>
+{
+};
+
+/**
+ * @class Neighbor<Anisotropic>
+ * @brief Pair interaction with the isotropic kernel evaluated on the displacement
+ * mapped by the average of the per-particle transform tensors of the pair.
+ * Note that e_ij gives the kernel gradient direction in physical space and is not a unit vector.
+ * Therefore, only interaction kernels which are anisotropy aware are allowed with it.
+ */
+template <>
+class Neighbor<Anisotropic> : public Neighbor<>
+{
+  public:
+    template <class ExecutionPolicy>
+    Neighbor(const ExecutionPolicy &ex_policy,
+             SPHAdaptation *sph_adaptation, SPHAdaptation *contact_adaptation,
+             DiscreteVariable<Vecd> *dv_pos, DiscreteVariable<Vecd> *dv_target_pos);
+
+    inline Matd transform_ij(size_t i, size_t j) const { return 0.5 * (source_transform_[i] + target_transform_[j]); };
+    inline Vecd isotropic_r_ij(size_t i, size_t j) const { return transform_ij(i, j) * vec_r_ij(i, j); };
+    inline Real W_ij(size_t i, size_t j) const
+    {
+        Matd transform = transform_ij(i, j);
+        return transform.determinant() * kernel_.W(Vecd(transform * vec_r_ij(i, j)));
+    };
+    inline Real dW_ij(size_t i, size_t j) const
+    {
+        Matd transform = transform_ij(i, j);
+        return transform.determinant() * kernel_.dW(Vecd(transform * vec_r_ij(i, j)));
+    };
+
+    inline Vecd e_ij(size_t i, size_t j) const
+    {
+        Matd transform = transform_ij(i, j);
+        Vecd isotropic_displacement = transform * vec_r_ij(i, j);
+        return transform.transpose() * isotropic_displacement / (isotropic_displacement.norm() + TinyReal);
+    };
+
+    class NeighborCriterion
+    {
+      public:
+        NeighborCriterion(Neighbor<Anisotropic> &neighbor);
+        bool operator()(UnsignedInt target_index, UnsignedInt source_index) const
+        {
+            Matd transform = 0.5 * (source_transform_[source_index] + target_transform_[target_index]);
+            return (transform * (source_pos_[source_index] - target_pos_[target_index])).squaredNorm() < cut_radius_square_;
+        };
+
+      protected:
+        Vecd *source_pos_;
+        Vecd *target_pos_;
+        Matd *source_transform_;
+        Matd *target_transform_;
+        Real cut_radius_square_;
+    };
+
+  protected:
+    Matd *source_transform_;
+    Matd *target_transform_;
+};
 } // namespace SPH
 #endif // NEIGHBORHOOD_CK_H
\ No newline at end of file
@@ -3,6 +3,8 @@
 
 #include "neighborhood_ck.h"
 
+#include "adaptation.h"
+
 namespace SPH
 {
 //=================================================================================================//
@@ -21,5 +23,17 @@ Neighbor<>::Neighbor(const ExecutionPolicy &ex_policy,
     }
 }
 //=================================================================================================//
+template <class ExecutionPolicy>
+Neighbor<Anisotropic>::Neighbor(const ExecutionPolicy &ex_policy,
+                                SPHAdaptation *sph_adaptation, SPHAdaptation *contact_adaptation,
+                                DiscreteVariable<Vecd> *dv_pos, DiscreteVariable<Vecd> *dv_contact_pos)
+    : Neighbor<>(ex_policy, sph_adaptation, contact_adaptation, dv_pos, dv_contact_pos),
+      source_transform_(DynamicCast<AnisotropicAdaptation>(this, sph_adaptation)
+                            ->dvAnisotropicTransform()
+                            ->DelegatedData(ex_policy)),
+      target_transform_(DynamicCast<AnisotropicAdaptation>(this, contact_adaptation)
+                            ->dvAnisotropicTransform()
+                            ->DelegatedData(ex_policy)) {}
+//=================================================================================================//
 } // namespace SPH
 #endif // NEIGHBORHOOD_CK_HPP
@@ -40,7 +40,9 @@
 #include "interaction_algorithms_ck.hpp"
 #include "particle_functors_ck.h"
 #include "particle_sort_ck.hpp"
+#include "relax_stepping_ck.hpp"
 #include "simple_algorithms_ck.h"
+#include "step_graph_ck.h"
 #include "all_continum_dynamics.h"
 
 #endif // ALL_SHARED_PHYSICAL_DYNAMICS_CK_H
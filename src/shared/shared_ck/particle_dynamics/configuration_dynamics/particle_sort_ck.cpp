@@ -28,4 +28,36 @@ void QuickSort::sort(const ParallelPolicy &ex_policy, BaseParticles *particles)
     tbb::parallel_for(quick_sort_particle_range_, quick_sort_particle_body_);
 }
 //=================================================================================================//
+bool IncrementalSort::sort(const ParallelPolicy &ex_policy, BaseParticles *particles, UnsignedInt max_displaced)
+{
+    UnsignedInt total_real_particles = particles->TotalRealParticles();
+    sorted_run_.clear();
+    displaced_.clear();
+
+    UnsignedInt last_in_run = 0;
+    for (UnsignedInt i = 0; i != total_real_particles; ++i)
+    {
+        bool is_locally_ordered = (i == 0 || sequence_[i - 1] <= sequence_[i]) &&
+                                  (i + 1 == total_real_particles || sequence_[i] <= sequence_[i + 1]);
+        if (is_locally_ordered && sequence_[i] >= last_in_run)
+        {
+            sorted_run_.push_back(i);
+            last_in_run = sequence_[i];
+        }
+        else
+        {
+            displaced_.push_back(i);
+            if (displaced_.size() > max_displaced)
+                return false;
+        }
+    }
+
+    auto compare = [&](size_t a, size_t b)
+    { return sequence_[a] < sequence_[b]; };
+    std::stable_sort(displaced_.begin(), displaced_.end(), compare);
+    std::merge(sorted_run_.begin(), sorted_run_.end(), displaced_.begin(), displaced_.end(),
+               index_permutation_, compare);
+    return true;
+}
+//=================================================================================================//
 } // namespace SPH
\ No newline at end of file
@@ -93,6 +93,28 @@ class QuickSort
         quick_sort_particle_body_;
 };
 
+/**
+ * @class IncrementalSort
+ * @brief Sorting of a nearly sorted sequence on host.
+ * The particles locally in order and not smaller than the last kept one form a sorted run,
+ * the other, displaced, particles are sorted and merged into the run.
+ */
+class IncrementalSort
+{
+  public:
+    template <class ExecutionPolicy>
+    explicit IncrementalSort(const ExecutionPolicy &ex_policy,
+                             DiscreteVariable<UnsignedInt> *dv_sequence,
+                             DiscreteVariable<UnsignedInt> *dv_index_permutation);
+    /** Returns false, and the permutation should not be used, if too many particles are displaced. */
+    bool sort(const ParallelPolicy &ex_policy, BaseParticles *particles, UnsignedInt max_displaced);
+
+  protected:
+    UnsignedInt *sequence_;
+    UnsignedInt *index_permutation_;
+    IndexVector sorted_run_, displaced_;
+};
+
 template <class ExecutionPolicy>
 class ParticleSortCK : public LocalDynamics, public BaseDynamics<void>
 {
@@ -109,6 +131,13 @@ class ParticleSortCK : public LocalDynamics, public BaseDynamics<void>
                         ParticleSortCK<ExecutionPolicy> &encloser);
         void prepareSequence(UnsignedInt index_i);
         void updateSortedID(UnsignedInt index_i);
+        /** Whether the cell sequence decreases from this particle to the next one. */
+        bool isOutOfOrder(UnsignedInt index_i, UnsignedInt total_real_particles)
+        {
+            return index_i + 1 < total_real_particles &&
+                   mesh_.transferMeshIndexToMortonOrder(mesh_.CellIndexFromPosition(pos_[index_i])) >
+                       mesh_.transferMeshIndexToMortonOrder(mesh_.CellIndexFromPosition(pos_[index_i + 1]));
+        };
 
       protected:
         Mesh mesh_;
@@ -150,10 +179,44 @@ class ParticleSortCK : public LocalDynamics, public BaseDynamics<void>
 
     StdVec<BodyPartByParticle *> body_parts_by_particle_;
     StdVec<DiscreteVariable<UnsignedInt> *> dv_particle_lists_, dv_original_id_lists_;
+    StdVec<size_t> number_of_taggings_; /**< to renew the kernels after a body part is re-tagged */
     using UpdateBodyPartParticleImplementation =
         Implementation<ExecutionPolicy, LocalDynamicsType, UpdateBodyPartByParticle>;
     UniquePtrsKeeper<UpdateBodyPartParticleImplementation> update_body_part_by_particle_implementation_ptrs_;
     StdVec<UpdateBodyPartParticleImplementation *> update_body_part_by_particle_implementations_;
+
+    void prepareSequence();
+    void updateSortedParticles();
+};
+
+/**
+ * @class AdaptiveParticleSortCK
+ * @brief Particle sort triggered by a locality monitor, i.e. the fraction of particles
+ * whose cell sequence is larger than that of the next particle.
+ * Nearly sorted particles are sorted incrementally on host.
+ * It is cheap to call often, e.g. at every configuration update.
+ */
+template <class ExecutionPolicy>
+class AdaptiveParticleSortCK : public ParticleSortCK<ExecutionPolicy>
+{
+  public:
+    explicit AdaptiveParticleSortCK(RealBody &real_body, Real sort_threshold = 0.01,
+                                    Real incremental_threshold = 0.05);
+    virtual ~AdaptiveParticleSortCK() {};
+    virtual void exec(Real dt = 0.0) override;
+    Real Disorder() { return disorder_; };
+    size_t NumberOfSorts() { return number_of_sorts_; };
+    size_t NumberOfIncrementalSorts() { return number_of_incremental_sorts_; };
+
+  protected:
+    Real sort_threshold_;        /**< disorder above which the particles are sorted */
+    Real incremental_threshold_; /**< disorder below which an incremental sort is tried first */
+    Real disorder_;
+    size_t number_of_sorts_;
+    size_t number_of_incremental_sorts_;
+    IncrementalSort incremental_sort_;
+
+    Real evaluateDisorder();
 };
 } // namespace SPH
 #endif // PARTICLE_SORT_H
@@ -47,6 +47,13 @@ QuickSort::QuickSort(const ExecutionPolicy &ex_policy,
       quick_sort_particle_body_() {}
 //=================================================================================================//
 template <class ExecutionPolicy>
+IncrementalSort::IncrementalSort(const ExecutionPolicy &ex_policy,
+                                 DiscreteVariable<UnsignedInt> *dv_sequence,
+                                 DiscreteVariable<UnsignedInt> *dv_index_permutation)
+    : sequence_(dv_sequence->DelegatedData(ex_policy)),
+      index_permutation_(dv_index_permutation->DelegatedData(ex_policy)) {}
+//=================================================================================================//
+template <class ExecutionPolicy>
 ParticleSortCK<ExecutionPolicy>::ParticleSortCK(RealBody &real_body)
     : LocalDynamics(real_body), BaseDynamics<void>(),
       ex_policy_(ExecutionPolicy{}),
@@ -67,13 +74,9 @@ ParticleSortCK<ExecutionPolicy>::ParticleSortCK(RealBody &real_body)
     body_parts_by_particle_ = real_body.getBodyPartsByParticle();
     for (size_t i = 0; i != body_parts_by_particle_.size(); ++i)
     {
-        DiscreteVariable<UnsignedInt> *dv_particle_list =
-            body_parts_by_particle_[i]->dvParticleList();
-        dv_particle_lists_.push_back(dv_particle_list);
-        DiscreteVariable<UnsignedInt> *original_id_list =
-            particles_->addUniqueDiscreteVariableFrom<UnsignedInt>(
-                dv_particle_list->Name() + "Initial", dv_particle_list);
-        dv_original_id_lists_.push_back(original_id_list);
+        dv_particle_lists_.push_back(body_parts_by_particle_[i]->dvParticleList());
+        dv_original_id_lists_.push_back(body_parts_by_particle_[i]->dvOriginalIDList());
+        number_of_taggings_.push_back(body_parts_by_particle_[i]->NumberOfTaggings());
     }
 
     for (size_t i = 0; i != body_parts_by_particle_.size(); ++i)
@@ -112,16 +115,20 @@ void ParticleSortCK<ExecutionPolicy>::ComputingKernel::
 }
 //=================================================================================================//
 template <class ExecutionPolicy>
-void ParticleSortCK<ExecutionPolicy>::exec(Real dt)
+void ParticleSortCK<ExecutionPolicy>::prepareSequence()
 {
-    UnsignedInt total_real_particles = particles_->TotalRealParticles();
     ComputingKernel *computing_kernel = kernel_implementation_.getComputingKernel();
-
-    particle_for(ex_policy_, IndexRange(0, total_real_particles),
+    particle_for(ex_policy_, IndexRange(0, particles_->TotalRealParticles()),
                  [=](size_t i)
                  { computing_kernel->prepareSequence(i); });
+}
+//=================================================================================================//
+template <class ExecutionPolicy>
+void ParticleSortCK<ExecutionPolicy>::updateSortedParticles()
+{
+    UnsignedInt total_real_particles = particles_->TotalRealParticles();
+    ComputingKernel *computing_kernel = kernel_implementation_.getComputingKernel();
 
-    sort_method_.sort(ex_policy_, particles_);
     update_variables_to_sort_(particles_->EvolvingVariables(), ex_policy_, total_real_particles, dv_index_permutation_);
 
     particle_for(ex_policy_, IndexRange(0, total_real_particles),
@@ -130,6 +137,13 @@ void ParticleSortCK<ExecutionPolicy>::exec(Real dt)
 
     for (size_t k = 0; k != body_parts_by_particle_.size(); ++k)
     {
+        // the particle lists may have been reallocated by re-tagging
+        if (number_of_taggings_[k] != body_parts_by_particle_[k]->NumberOfTaggings())
+        {
+            update_body_part_by_particle_implementations_[k]->resetUpdated();
+            number_of_taggings_[k] = body_parts_by_particle_[k]->NumberOfTaggings();
+        }
+
         UnsignedInt total_particles = body_parts_by_particle_[k]->svRangeSize()->getValue();
         UpdateBodyPartByParticle *update_body_part_by_particle =
             update_body_part_by_particle_implementations_[k]->getComputingKernel(k);
@@ -141,6 +155,14 @@ void ParticleSortCK<ExecutionPolicy>::exec(Real dt)
 }
 //=================================================================================================//
 template <class ExecutionPolicy>
+void ParticleSortCK<ExecutionPolicy>::exec(Real dt)
+{
+    prepareSequence();
+    sort_method_.sort(ex_policy_, particles_);
+    updateSortedParticles();
+}
+//=================================================================================================//
+template <class ExecutionPolicy>
 template <class EncloserType>
 ParticleSortCK<ExecutionPolicy>::UpdateBodyPartByParticle::
     UpdateBodyPartByParticle(const ExecutionPolicy &ex_policy,
@@ -156,5 +178,51 @@ void ParticleSortCK<ExecutionPolicy>::UpdateBodyPartByParticle::
     particle_list_[index_i] = sorted_id_[original_id_list_[index_i]];
 }
 //=================================================================================================//
+template <class ExecutionPolicy>
+AdaptiveParticleSortCK<ExecutionPolicy>::AdaptiveParticleSortCK(
+    RealBody &real_body, Real sort_threshold, Real incremental_threshold)
+    : ParticleSortCK<ExecutionPolicy>(real_body),
+      sort_threshold_(sort_threshold), incremental_threshold_(incremental_threshold),
+      disorder_(0), number_of_sorts_(0), number_of_incremental_sorts_(0),
+      incremental_sort_(this->ex_policy_, this->dv_sequence_, this->dv_index_permutation_) {}
+//=================================================================================================//
+template <class ExecutionPolicy>
+Real AdaptiveParticleSortCK<ExecutionPolicy>::evaluateDisorder()
+{
+    UnsignedInt total_real_particles = this->particles_->TotalRealParticles();
+    auto *computing_kernel = this->kernel_implementation_.getComputingKernel();
+    UnsignedInt number_of_out_of_order = particle_reduce<ReduceSum<UnsignedInt>>(
+        LoopRangeCK<ExecutionPolicy, SPHBody>(this->sph_body_), UnsignedInt(0),
+        [=](size_t i) -> UnsignedInt
+        { return computing_kernel->isOutOfOrder(i, total_real_particles) ? 1 : 0; });
+    return Real(number_of_out_of_order) / Real(total_real_particles + 1);
+}
+//=================================================================================================//
+template <class ExecutionPolicy>
+void AdaptiveParticleSortCK<ExecutionPolicy>::exec(Real dt)
+{
+    disorder_ = evaluateDisorder();
+    if (disorder_ <= sort_threshold_)
+        return;
+
+    this->prepareSequence();
+    bool is_sorted = false;
+    if constexpr (!std::is_base_of_v<DeviceExecution<>, ExecutionPolicy>)
+    {
+        if (disorder_ <= incremental_threshold_)
+        {
+            UnsignedInt max_displaced = UnsignedInt(4.0 * incremental_threshold_ * this->particles_->TotalRealParticles());
+            is_sorted = incremental_sort_.sort(ParallelPolicy{}, this->particles_, max_displaced);
+            if (is_sorted)
+                number_of_incremental_sorts_++;
+        }
+    }
+    if (!is_sorted)
+        this->sort_method_.sort(this->ex_policy_, this->particles_);
+
+    this->updateSortedParticles();
+    number_of_sorts_++;
+}
+//=================================================================================================//
 } // namespace SPH
 #endif // PARTICLE_SORT_HPP
\ No newline at end of file
@@ -45,6 +45,8 @@ template <class ExecutionPolicy, typename... Parameters>
 class UpdateRelation<ExecutionPolicy, Inner<Parameters...>>
     : public Interaction<Inner<Parameters...>>, public BaseDynamics<void>
 {
+    using NeighborCriterion = typename Interaction<Inner<Parameters...>>::InteractKernel::NeighborCriterion;
+
   public:
     UpdateRelation(Relation<Inner<Parameters...>> &inner_relation);
     virtual ~UpdateRelation() {};
@@ -61,8 +63,8 @@ class UpdateRelation<ExecutionPolicy, Inner<Parameters...>>
         void updateNeighborList(UnsignedInt index_i);
 
       protected:
+        NeighborCriterion neighbor_criterion_;
         NeighborSearch neighbor_search_;
-        Real grid_spacing_squared_;
     };
     typedef UpdateRelation<ExecutionPolicy, Inner<Parameters...>> LocalDynamicsType;
     using KernelImplementation = Implementation<ExecutionPolicy, LocalDynamicsType, InteractKernel>;
@@ -22,9 +22,8 @@ template <class EncloserType>
 UpdateRelation<ExecutionPolicy, Inner<Parameters...>>::InteractKernel::InteractKernel(
     const ExecutionPolicy &ex_policy, EncloserType &encloser)
     : Interaction<Inner<Parameters...>>::InteractKernel(ex_policy, encloser),
-      neighbor_search_(encloser.cell_linked_list_.createNeighborSearch(ex_policy)),
-      grid_spacing_squared_(
-          pow(encloser.cell_linked_list_.getMesh().GridSpacing(), 2)) {}
+      neighbor_criterion_(*this),
+      neighbor_search_(encloser.cell_linked_list_.createNeighborSearch(ex_policy)) {}
 //=================================================================================================//
 template <class ExecutionPolicy, typename... Parameters>
 void UpdateRelation<ExecutionPolicy, Inner<Parameters...>>::
@@ -36,12 +35,8 @@ void UpdateRelation<ExecutionPolicy, Inner<Parameters...>>::
         index_i, this->source_pos_,
         [&](size_t index_j)
         {
-            if (index_i != index_j)
-            {
-                if ((this->source_pos_[index_i] - this->target_pos_[index_j])
-                        .squaredNorm() < grid_spacing_squared_)
-                    neighbor_count++;
-            }
+            if (index_i != index_j && neighbor_criterion_(index_j, index_i))
+                neighbor_count++;
         });
     this->neighbor_index_[index_i] = neighbor_count;
 }
@@ -55,14 +50,10 @@ void UpdateRelation<ExecutionPolicy, Inner<Parameters...>>::
         index_i, this->source_pos_,
         [&](size_t index_j)
         {
-            if (index_i != index_j)
+            if (index_i != index_j && neighbor_criterion_(index_j, index_i))
             {
-                if ((this->source_pos_[index_i] - this->target_pos_[index_j])
-                        .squaredNorm() < grid_spacing_squared_)
-                {
-                    this->neighbor_index_[this->particle_offset_[index_i] + neighbor_count] = index_j;
-                    neighbor_count++;
-                }
+                this->neighbor_index_[this->particle_offset_[index_i] + neighbor_count] = index_j;
+                neighbor_count++;
             }
         });
 }
@@ -97,6 +88,12 @@ void UpdateRelation<ExecutionPolicy, Inner<Parameters...>>::exec(Real dt)
                  IndexRange(0, total_real_particles),
                  [=](size_t i)
                  { computing_kernel->updateNeighborList(i); });
+
+    if (this->inner_relation_.isNeighborListCompressed())
+    {
+        this->inner_relation_.compressNeighborList(
+            ex_policy_, total_real_particles, current_neighbor_index_size);
+    }
 }
 //=================================================================================================//
 template <class ExecutionPolicy, typename... Parameters>
@@ -191,6 +188,12 @@ void UpdateRelation<ExecutionPolicy, Contact<Parameters...>>::exec(Real dt)
                      IndexRange(0, total_real_particles),
                      [=](size_t i)
                      { computing_kernel->updateNeighborList(i); });
+
+        if (this->contact_relation_.isNeighborListCompressed())
+        {
+            this->contact_relation_.compressNeighborList(
+                ex_policy_, total_real_particles, current_neighbor_index_size, k);
+        }
     }
 }
 //=================================================================================================//
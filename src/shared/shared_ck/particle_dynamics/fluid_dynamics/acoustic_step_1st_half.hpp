@@ -89,15 +89,16 @@ void AcousticStep1stHalf<Inner<OneLevel, RiemannSolverType, KernelCorrectionType
 {
     Vecd force = Vecd::Zero();
     Real rho_dissipation(0);
-    for (UnsignedInt n = this->FirstNeighbor(index_i); n != this->LastNeighbor(index_i); ++n)
-    {
-        UnsignedInt index_j = this->neighbor_index_[n];
-        Real dW_ijV_j = this->dW_ij(index_i, index_j) * Vol_[index_j];
-        Vecd e_ij = this->e_ij(index_i, index_j);
+    this->forEachNeighbor(
+        index_i,
+        [&](UnsignedInt index_j)
+        {
+            Real dW_ijV_j = this->dW_ij(index_i, index_j) * Vol_[index_j];
+            Vecd e_ij = this->e_ij(index_i, index_j);
 
-        force -= (p_[index_i] * correction_(index_j) + p_[index_j] * correction_(index_i)) * dW_ijV_j * e_ij;
-        rho_dissipation += riemann_solver_.DissipativeUJump(p_[index_i] - p_[index_j]) * dW_ijV_j;
-    }
+            force -= (p_[index_i] * correction_(index_j) + p_[index_j] * correction_(index_i)) * dW_ijV_j * e_ij;
+            rho_dissipation += riemann_solver_.DissipativeUJump(p_[index_i] - p_[index_j]) * dW_ijV_j;
+        });
     force_[index_i] += force * Vol_[index_i];
     drho_dt_[index_i] = rho_dissipation * rho_[index_i];
 }
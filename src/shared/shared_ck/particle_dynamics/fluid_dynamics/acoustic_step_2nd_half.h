@@ -91,6 +91,8 @@ class AcousticStep2ndHalf<Inner<OneLevel, RiemannSolverType, KernelCorrectionTyp
   protected:
     template <typename...>
     friend class FSI::PressureForceFromFluid;
+    template <typename...>
+    friend class FSI::PressureAndViscousForceFromFluid;
 
     KernelCorrectionType kernel_correction_;
     FluidType &fluid_;
@@ -53,16 +53,17 @@ void AcousticStep2ndHalf<Inner<OneLevel, RiemannSolverType, KernelCorrectionType
 {
     Real density_change_rate(0);
     Vecd p_dissipation = Vecd::Zero();
-    for (UnsignedInt n = this->FirstNeighbor(index_i); n != this->LastNeighbor(index_i); ++n)
-    {
-        UnsignedInt index_j = this->neighbor_index_[n];
-        Real dW_ijV_j = this->dW_ij(index_i, index_j) * Vol_[index_j];
-        Vecd corrected_e_ij = correction_(index_i) * this->e_ij(index_i, index_j);
+    this->forEachNeighbor(
+        index_i,
+        [&](UnsignedInt index_j)
+        {
+            Real dW_ijV_j = this->dW_ij(index_i, index_j) * Vol_[index_j];
+            Vecd corrected_e_ij = correction_(index_i) * this->e_ij(index_i, index_j);
 
-        Real u_jump = (vel_[index_i] - vel_[index_j]).dot(corrected_e_ij);
-        density_change_rate += u_jump * dW_ijV_j;
-        p_dissipation += riemann_solver_.DissipativePJump(u_jump) * dW_ijV_j * corrected_e_ij;
-    }
+            Real u_jump = (vel_[index_i] - vel_[index_j]).dot(corrected_e_ij);
+            density_change_rate += u_jump * dW_ijV_j;
+            p_dissipation += riemann_solver_.DissipativePJump(u_jump) * dW_ijV_j * corrected_e_ij;
+        });
     drho_dt_[index_i] += density_change_rate * rho_[index_i];
     force_[index_i] = p_dissipation * Vol_[index_i];
 }
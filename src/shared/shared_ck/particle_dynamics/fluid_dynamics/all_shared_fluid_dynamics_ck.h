@@ -36,6 +36,9 @@
 #include "density_regularization.hpp"
 #include "all_fluid_boundary_condition_ck.h"
 #include "fluid_time_step_ck.hpp"
+#include "implicit_viscous_force.hpp"
+#include "pressure_projection_ck.hpp"
+#include "shape_confinement_ck.hpp"
 #include "transport_velocity_correction_ck.hpp"
 #include "viscous_force.hpp"
 
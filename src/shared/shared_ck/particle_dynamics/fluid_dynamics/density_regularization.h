@@ -61,7 +61,7 @@ class Regularization<Internal>
                         Regularization<Internal> &encloser,
                         ComputingKernelType &computing_kernel){};
 
-        Real operator()(Real &rho_sum) { return rho_sum; };
+        Real operator()(size_t index_i, Real &rho_sum) { return rho_sum; };
     };
 };
 
@@ -80,13 +80,48 @@ class Regularization<FreeSurface>
                         ComputingKernelType &computing_kernel)
             : rho0_(computing_kernel.InitialDensity()){};
 
-        Real operator()(Real &rho_sum) { return SMAX(rho_sum, rho0_); };
+        Real operator()(size_t index_i, Real &rho_sum) { return SMAX(rho_sum, rho0_); };
 
       protected:
         Real rho0_;
     };
 };
 
+/**
+ * @brief Free-surface regularization restricted to the smeared surface layer
+ * given by the cached free-surface state, the interior particles keep the summation density.
+ */
+template <>
+class Regularization<SmearedSurface>
+{
+  public:
+    Regularization(BaseParticles *particles)
+        : dv_smeared_surface_(particles->getVariableByName<int>("SmearedSurface")) {};
+
+    class ComputingKernel
+    {
+      public:
+        template <class ExecutionPolicy, class ComputingKernelType>
+        ComputingKernel(const ExecutionPolicy &ex_policy,
+                        Regularization<SmearedSurface> &encloser,
+                        ComputingKernelType &computing_kernel)
+            : rho0_(computing_kernel.InitialDensity()),
+              smeared_surface_(encloser.dv_smeared_surface_->DelegatedData(ex_policy)){};
+
+        Real operator()(size_t index_i, Real &rho_sum)
+        {
+            return smeared_surface_[index_i] != 0 ? SMAX(rho_sum, rho0_) : rho_sum;
+        };
+
+      protected:
+        Real rho0_;
+        int *smeared_surface_;
+    };
+
+  protected:
+    DiscreteVariable<int> *dv_smeared_surface_;
+};
+
 template <typename... RelationTypes>
 class DensityRegularization;
 
@@ -191,6 +226,7 @@ class DensityRegularization<Contact<Parameters...>>
 
 using DensityRegularizationComplex = DensityRegularization<Inner<WithUpdate, Internal, AllParticles>, Contact<>>;
 using DensityRegularizationComplexFreeSurface = DensityRegularization<Inner<WithUpdate, FreeSurface, AllParticles>, Contact<>>;
+using DensityRegularizationComplexSmearedSurface = DensityRegularization<Inner<WithUpdate, SmearedSurface, AllParticles>, Contact<>>;
 using DensityRegularizationComplexInternalPressureBoundary = DensityRegularization<Inner<WithUpdate, Internal, ExcludeBufferParticles>, Contact<>>;
 
 } // namespace fluid_dynamics
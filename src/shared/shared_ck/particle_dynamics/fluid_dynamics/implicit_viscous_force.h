@@ -0,0 +1,183 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	implicit_viscous_force.h
+ * @brief 	Viscous force from an implicit viscous step.
+ * @details The velocity after the viscous step over the advection time step dt is given by
+ *			m_i v_i - dt F_i(v) = m_i v_i^n, with F_i(v) the same discretization as ViscousForceCK.
+ *			The system is symmetric and solved by the matrix-free conjugate gradient method.
+ *			The viscous force is then m_i (v_i - v_i^n) / dt, used as a force prior,
+ *			so that the viscous constraint of the advection time step is not required,
+ *			i.e. AdvectionTimeStepCK can be used instead of AdvectionViscousTimeStepCK.
+ *			The velocity of the wall particles is given and only contributes to the diagonal
+ *			and the right-hand side of the system.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef IMPLICIT_VISCOUS_FORCE_H
+#define IMPLICIT_VISCOUS_FORCE_H
+
+#include "conjugate_gradient_ck.h"
+#include "viscous_force.h"
+
+namespace SPH
+{
+namespace fluid_dynamics
+{
+template <typename... RelationTypes>
+class ImplicitViscousOperatorCK;
+
+template <typename ViscosityType, class KernelCorrectionType, typename... Parameters>
+class ImplicitViscousOperatorCK<Inner<ViscosityType, KernelCorrectionType, Parameters...>>
+    : public ViscousForceCK<Base, ViscosityType, KernelCorrectionType, Inner<Parameters...>>
+{
+    using BaseViscousForceType = ViscousForceCK<Base, ViscosityType, KernelCorrectionType, Inner<Parameters...>>;
+
+  public:
+    using DataType = Vecd;
+    explicit ImplicitViscousOperatorCK(Relation<Inner<Parameters...>> &inner_relation);
+    virtual ~ImplicitViscousOperatorCK() {};
+    DiscreteVariable<Vecd> *dvSolution() { return dv_implicit_vel_; };
+
+    class OperatorKernel : public BaseViscousForceType::InteractKernel,
+                           public ForcePriorCK::UpdateKernel
+    {
+      public:
+        template <class ExecutionPolicy, class EncloserType>
+        OperatorKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser);
+
+        void initialize(size_t index_i, Real dt = 0.0)
+        {
+            implicit_vel_[index_i] = this->vel_[index_i];
+            wall_coefficient_[index_i] = 0.0;
+            wall_source_[index_i] = Vecd::Zero();
+        };
+        Real diagonal(size_t index_i, Real dt);
+        Vecd product(size_t index_i, Vecd *field, Real dt);
+        Vecd rhs(size_t index_i, Real dt)
+        {
+            return mass_[index_i] * this->vel_[index_i] + dt * wall_source_[index_i];
+        };
+        void update(size_t index_i, Real dt);
+
+      protected:
+        Real *mass_, *wall_coefficient_;
+        Vecd *implicit_vel_, *wall_source_;
+
+        /** The non-negative pair coefficient of F_i = -sum_j k_ij (v_i - v_j). */
+        Real coefficient(size_t index_i, size_t index_j);
+    };
+
+  protected:
+    DiscreteVariable<Real> *dv_mass_, *dv_wall_coefficient_;
+    DiscreteVariable<Vecd> *dv_implicit_vel_, *dv_wall_source_;
+};
+
+template <typename ViscosityType, class KernelCorrectionType, typename... Parameters>
+class ImplicitViscousOperatorCK<Contact<Wall, ViscosityType, KernelCorrectionType, Parameters...>>
+    : public ViscousForceCK<Base, ViscosityType, KernelCorrectionType, Contact<Parameters...>>,
+      public Interaction<Wall>
+{
+    using BaseViscousForceType = ViscousForceCK<Base, ViscosityType, KernelCorrectionType, Contact<Parameters...>>;
+
+  public:
+    explicit ImplicitViscousOperatorCK(Relation<Contact<Parameters...>> &contact_relation);
+    virtual ~ImplicitViscousOperatorCK() {};
+
+    class InteractKernel : public BaseViscousForceType::InteractKernel
+    {
+      public:
+        template <class ExecutionPolicy, class EncloserType>
+        InteractKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser, size_t contact_index);
+        /** Add the wall terms to the diagonal and the right-hand side. */
+        void interact(size_t index_i, Real dt = 0.0);
+
+      protected:
+        Real *wall_Vol_, *wall_coefficient_;
+        Vecd *wall_vel_ave_, *wall_source_;
+    };
+
+  protected:
+    DiscreteVariable<Real> *dv_wall_coefficient_;
+    DiscreteVariable<Vecd> *dv_wall_source_;
+};
+
+template <class ExecutionPolicy, typename... InteractionTypes>
+class ImplicitViscousForceCK;
+
+template <class ExecutionPolicy, class ViscosityType, class KernelCorrectionType>
+class ImplicitViscousForceCK<ExecutionPolicy, Inner<ViscosityType, KernelCorrectionType>>
+    : public BaseDynamics<void>
+{
+    using InnerOperatorType = ImplicitViscousOperatorCK<Inner<ViscosityType, KernelCorrectionType>>;
+    using OperatorKernel = typename InnerOperatorType::OperatorKernel;
+
+  public:
+    explicit ImplicitViscousForceCK(Relation<Inner<>> &inner_relation,
+                                    Real tolerance = 1.0e-6, UnsignedInt max_iterations = 100);
+    virtual ~ImplicitViscousForceCK() {};
+    virtual void exec(Real dt = 0.0) override;
+    UnsignedInt NumberOfIterations() { return conjugate_gradient_.NumberOfIterations(); };
+    Real RelativeResidual() { return conjugate_gradient_.RelativeResidual(); };
+
+  protected:
+    SPHBody &sph_body_;
+    InnerOperatorType inner_operator_;
+    ConjugateGradientCK<ExecutionPolicy, InnerOperatorType> conjugate_gradient_;
+
+    virtual void addWallContribution(Real dt) {};
+};
+
+template <class ExecutionPolicy, class ViscosityType, class KernelCorrectionType>
+class ImplicitViscousForceCK<ExecutionPolicy, Inner<ViscosityType, KernelCorrectionType>,
+                             Contact<Wall, ViscosityType, KernelCorrectionType>>
+    : public ImplicitViscousForceCK<ExecutionPolicy, Inner<ViscosityType, KernelCorrectionType>>
+{
+    using BaseImplicitViscousForceType = ImplicitViscousForceCK<ExecutionPolicy, Inner<ViscosityType, KernelCorrectionType>>;
+    using WallOperatorType = ImplicitViscousOperatorCK<Contact<Wall, ViscosityType, KernelCorrectionType>>;
+    using InteractKernel = typename WallOperatorType::InteractKernel;
+    using KernelImplementation = Implementation<ExecutionPolicy, WallOperatorType, InteractKernel>;
+
+  public:
+    ImplicitViscousForceCK(Relation<Inner<>> &inner_relation, Relation<Contact<>> &wall_contact_relation,
+                           Real tolerance = 1.0e-6, UnsignedInt max_iterations = 100);
+    virtual ~ImplicitViscousForceCK() {};
+
+  protected:
+    WallOperatorType wall_operator_;
+    UniquePtrsKeeper<KernelImplementation> contact_kernel_implementation_ptrs_;
+    StdVec<KernelImplementation *> contact_kernel_implementation_;
+
+    virtual void addWallContribution(Real dt) override;
+};
+
+template <class ExecutionPolicy>
+using ImplicitViscousForceInnerCK =
+    ImplicitViscousForceCK<ExecutionPolicy, Inner<Viscosity, NoKernelCorrectionCK>>;
+template <class ExecutionPolicy>
+using ImplicitViscousForceWithWallCK =
+    ImplicitViscousForceCK<ExecutionPolicy, Inner<Viscosity, NoKernelCorrectionCK>,
+                           Contact<Wall, Viscosity, NoKernelCorrectionCK>>;
+} // namespace fluid_dynamics
+} // namespace SPH
+#endif // IMPLICIT_VISCOUS_FORCE_H
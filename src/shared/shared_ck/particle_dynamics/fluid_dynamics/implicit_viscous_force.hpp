@@ -0,0 +1,174 @@
+#ifndef IMPLICIT_VISCOUS_FORCE_HPP
+#define IMPLICIT_VISCOUS_FORCE_HPP
+
+#include "implicit_viscous_force.h"
+
+#include "conjugate_gradient_ck.hpp"
+#include "force_prior_ck.hpp"
+#include "viscous_force.hpp"
+
+namespace SPH
+{
+namespace fluid_dynamics
+{
+//=================================================================================================//
+template <typename ViscosityType, class KernelCorrectionType, typename... Parameters>
+ImplicitViscousOperatorCK<Inner<ViscosityType, KernelCorrectionType, Parameters...>>::
+    ImplicitViscousOperatorCK(Relation<Inner<Parameters...>> &inner_relation)
+    : BaseViscousForceType(inner_relation),
+      dv_mass_(this->particles_->template getVariableByName<Real>("Mass")),
+      dv_wall_coefficient_(this->particles_->template registerStateVariableOnly<Real>("ViscousWallCoefficient")),
+      dv_implicit_vel_(this->particles_->template registerStateVariableOnly<Vecd>("ImplicitViscousVelocity")),
+      dv_wall_source_(this->particles_->template registerStateVariableOnly<Vecd>("ViscousWallSource")) {}
+//=================================================================================================//
+template <typename ViscosityType, class KernelCorrectionType, typename... Parameters>
+template <class ExecutionPolicy, class EncloserType>
+ImplicitViscousOperatorCK<Inner<ViscosityType, KernelCorrectionType, Parameters...>>::OperatorKernel::
+    OperatorKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser)
+    : BaseViscousForceType::InteractKernel(ex_policy, encloser),
+      ForcePriorCK::UpdateKernel(ex_policy, encloser),
+      mass_(encloser.dv_mass_->DelegatedData(ex_policy)),
+      wall_coefficient_(encloser.dv_wall_coefficient_->DelegatedData(ex_policy)),
+      implicit_vel_(encloser.dv_implicit_vel_->DelegatedData(ex_policy)),
+      wall_source_(encloser.dv_wall_source_->DelegatedData(ex_policy)) {}
+//=================================================================================================//
+template <typename ViscosityType, class KernelCorrectionType, typename... Parameters>
+Real ImplicitViscousOperatorCK<Inner<ViscosityType, KernelCorrectionType, Parameters...>>::
+    OperatorKernel::coefficient(size_t index_i, size_t index_j)
+{
+    Vecd e_ij = this->e_ij(index_i, index_j);
+    Vecd vec_r_ij = this->vec_r_ij(index_i, index_j);
+    return -vec_r_ij.dot((this->correction_(index_i) + this->correction_(index_j)) * e_ij) *
+           harmonic_average(this->viscosity_(index_i), this->viscosity_(index_j)) *
+           this->dW_ij(index_i, index_j) * this->Vol_[index_i] * this->Vol_[index_j] /
+           (vec_r_ij.squaredNorm() + 0.01 * this->smoothing_length_sq_);
+}
+//=================================================================================================//
+template <typename ViscosityType, class KernelCorrectionType, typename... Parameters>
+Real ImplicitViscousOperatorCK<Inner<ViscosityType, KernelCorrectionType, Parameters...>>::
+    OperatorKernel::diagonal(size_t index_i, Real dt)
+{
+    Real sum = wall_coefficient_[index_i];
+    for (UnsignedInt n = this->FirstNeighbor(index_i); n != this->LastNeighbor(index_i); ++n)
+    {
+        sum += coefficient(index_i, this->neighbor_index_[n]);
+    }
+    return mass_[index_i] + dt * sum;
+}
+//=================================================================================================//
+template <typename ViscosityType, class KernelCorrectionType, typename... Parameters>
+Vecd ImplicitViscousOperatorCK<Inner<ViscosityType, KernelCorrectionType, Parameters...>>::
+    OperatorKernel::product(size_t index_i, Vecd *field, Real dt)
+{
+    Vecd sum = wall_coefficient_[index_i] * field[index_i];
+    for (UnsignedInt n = this->FirstNeighbor(index_i); n != this->LastNeighbor(index_i); ++n)
+    {
+        UnsignedInt index_j = this->neighbor_index_[n];
+        sum += coefficient(index_i, index_j) * (field[index_i] - field[index_j]);
+    }
+    return mass_[index_i] * field[index_i] + dt * sum;
+}
+//=================================================================================================//
+template <typename ViscosityType, class KernelCorrectionType, typename... Parameters>
+void ImplicitViscousOperatorCK<Inner<ViscosityType, KernelCorrectionType, Parameters...>>::
+    OperatorKernel::update(size_t index_i, Real dt)
+{
+    this->viscous_force_[index_i] = mass_[index_i] * (implicit_vel_[index_i] - this->vel_[index_i]) / dt;
+    ForcePriorCK::UpdateKernel::update(index_i, dt);
+}
+//=================================================================================================//
+template <typename ViscosityType, class KernelCorrectionType, typename... Parameters>
+ImplicitViscousOperatorCK<Contact<Wall, ViscosityType, KernelCorrectionType, Parameters...>>::
+    ImplicitViscousOperatorCK(Relation<Contact<Parameters...>> &contact_relation)
+    : BaseViscousForceType(contact_relation), Interaction<Wall>(contact_relation),
+      dv_wall_coefficient_(this->particles_->template getVariableByName<Real>("ViscousWallCoefficient")),
+      dv_wall_source_(this->particles_->template getVariableByName<Vecd>("ViscousWallSource")) {}
+//=================================================================================================//
+template <typename ViscosityType, class KernelCorrectionType, typename... Parameters>
+template <class ExecutionPolicy, class EncloserType>
+ImplicitViscousOperatorCK<Contact<Wall, ViscosityType, KernelCorrectionType, Parameters...>>::InteractKernel::
+    InteractKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser, size_t contact_index)
+    : BaseViscousForceType::InteractKernel(ex_policy, encloser, contact_index),
+      wall_Vol_(encloser.dv_wall_Vol_[contact_index]->DelegatedData(ex_policy)),
+      wall_coefficient_(encloser.dv_wall_coefficient_->DelegatedData(ex_policy)),
+      wall_vel_ave_(encloser.dv_wall_vel_ave_[contact_index]->DelegatedData(ex_policy)),
+      wall_source_(encloser.dv_wall_source_->DelegatedData(ex_policy)) {}
+//=================================================================================================//
+template <typename ViscosityType, class KernelCorrectionType, typename... Parameters>
+void ImplicitViscousOperatorCK<Contact<Wall, ViscosityType, KernelCorrectionType, Parameters...>>::
+    InteractKernel::interact(size_t index_i, Real dt)
+{
+    Real coefficient_sum = 0.0;
+    Vecd source = Vecd::Zero();
+    for (UnsignedInt n = this->FirstNeighbor(index_i); n != this->LastNeighbor(index_i); ++n)
+    {
+        UnsignedInt index_j = this->neighbor_index_[n];
+        Vecd e_ij = this->e_ij(index_i, index_j);
+        Vecd vec_r_ij = this->vec_r_ij(index_i, index_j);
+        Real coefficient = -4.0 * vec_r_ij.dot(this->correction_(index_i) * e_ij) *
+                           this->viscosity_(index_i) * this->dW_ij(index_i, index_j) *
+                           this->Vol_[index_i] * this->wall_Vol_[index_j] /
+                           (vec_r_ij.squaredNorm() + 0.01 * this->smoothing_length_sq_);
+        coefficient_sum += coefficient;
+        source += coefficient * this->wall_vel_ave_[index_j];
+    }
+    wall_coefficient_[index_i] += coefficient_sum;
+    wall_source_[index_i] += source;
+}
+//=================================================================================================//
+template <class ExecutionPolicy, class ViscosityType, class KernelCorrectionType>
+ImplicitViscousForceCK<ExecutionPolicy, Inner<ViscosityType, KernelCorrectionType>>::
+    ImplicitViscousForceCK(Relation<Inner<>> &inner_relation, Real tolerance, UnsignedInt max_iterations)
+    : BaseDynamics<void>(), sph_body_(inner_relation.getSPHBody()),
+      inner_operator_(inner_relation),
+      conjugate_gradient_(inner_operator_, tolerance, max_iterations) {}
+//=================================================================================================//
+template <class ExecutionPolicy, class ViscosityType, class KernelCorrectionType>
+void ImplicitViscousForceCK<ExecutionPolicy, Inner<ViscosityType, KernelCorrectionType>>::exec(Real dt)
+{
+    this->setUpdated(sph_body_);
+    OperatorKernel *operator_kernel = conjugate_gradient_.getOperatorKernel();
+    particle_for(LoopRangeCK<ExecutionPolicy, SPHBody>(sph_body_),
+                 [=](size_t i)
+                 { operator_kernel->initialize(i); });
+
+    addWallContribution(dt);
+    conjugate_gradient_.exec(dt);
+
+    particle_for(LoopRangeCK<ExecutionPolicy, SPHBody>(sph_body_),
+                 [=](size_t i)
+                 { operator_kernel->update(i, dt); });
+}
+//=================================================================================================//
+template <class ExecutionPolicy, class ViscosityType, class KernelCorrectionType>
+ImplicitViscousForceCK<ExecutionPolicy, Inner<ViscosityType, KernelCorrectionType>,
+                       Contact<Wall, ViscosityType, KernelCorrectionType>>::
+    ImplicitViscousForceCK(Relation<Inner<>> &inner_relation, Relation<Contact<>> &wall_contact_relation,
+                           Real tolerance, UnsignedInt max_iterations)
+    : BaseImplicitViscousForceType(inner_relation, tolerance, max_iterations),
+      wall_operator_(wall_contact_relation)
+{
+    for (size_t k = 0; k != wall_contact_relation.getContactBodies().size(); ++k)
+    {
+        contact_kernel_implementation_.push_back(
+            contact_kernel_implementation_ptrs_.template createPtr<KernelImplementation>(wall_operator_));
+        wall_operator_.registerComputingKernel(contact_kernel_implementation_.back(), k);
+    }
+}
+//=================================================================================================//
+template <class ExecutionPolicy, class ViscosityType, class KernelCorrectionType>
+void ImplicitViscousForceCK<ExecutionPolicy, Inner<ViscosityType, KernelCorrectionType>,
+                            Contact<Wall, ViscosityType, KernelCorrectionType>>::addWallContribution(Real dt)
+{
+    for (size_t k = 0; k != contact_kernel_implementation_.size(); ++k)
+    {
+        InteractKernel *interact_kernel = contact_kernel_implementation_[k]->getComputingKernel(k);
+        particle_for(LoopRangeCK<ExecutionPolicy, SPHBody>(this->sph_body_),
+                     [=](size_t i)
+                     { interact_kernel->interact(i, dt); });
+    }
+}
+//=================================================================================================//
+} // namespace fluid_dynamics
+} // namespace SPH
+#endif // IMPLICIT_VISCOUS_FORCE_HPP
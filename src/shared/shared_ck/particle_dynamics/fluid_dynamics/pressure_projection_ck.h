@@ -0,0 +1,203 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	pressure_projection_ck.h
+ * @brief 	Pressure projection of incompressible SPH with the advection time step.
+ * @details The velocity is first predicted with the force prior.
+ *			The pressure is then solved from the Poisson equation
+ *			sum_j A_ij (p_i - p_j) = -V_i div(v*)_i / dt with the conjugate gradient method,
+ *			in which A_ij is the symmetric SPH Laplacian of Morris.
+ *			The free-surface particles, i.e. those with the position divergence
+ *			from the surface indication below the threshold, have zero pressure.
+ *			Note that the surface indicator is not used as it also marks the particles
+ *			near the surface, which should be left with the pressure to support the surface layer. The wall pressure is extrapolated with the Neumann condition
+ *			given by the prior and wall accelerations.
+ *			Finally, the velocity is corrected by the pressure force,
+ *			which is also kept as the force for the time step estimation.
+ *			The displacement is accumulated as the acoustic steps, so that the projection
+ *			is used between AdvectionStepSetup and AdvectionStepClose with the advection time step.
+ *			The density is not changed.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef PRESSURE_PROJECTION_CK_H
+#define PRESSURE_PROJECTION_CK_H
+
+#include "base_fluid_dynamics.h"
+#include "conjugate_gradient_ck.h"
+#include "interaction_ck.hpp"
+
+namespace SPH
+{
+namespace fluid_dynamics
+{
+template <typename... RelationTypes>
+class PressurePoissonOperatorCK;
+
+template <typename... Parameters>
+class PressurePoissonOperatorCK<Inner<Parameters...>> : public Interaction<Inner<Parameters...>>
+{
+    using BaseInteraction = Interaction<Inner<Parameters...>>;
+
+  public:
+    using DataType = Real;
+    explicit PressurePoissonOperatorCK(Relation<Inner<Parameters...>> &inner_relation);
+    virtual ~PressurePoissonOperatorCK() {};
+    DiscreteVariable<Real> *dvSolution() { return dv_p_; };
+    DiscreteVariable<Real> *dvSource() { return dv_source_; };
+
+    class OperatorKernel : public BaseInteraction::InteractKernel
+    {
+      public:
+        template <class ExecutionPolicy, class EncloserType>
+        OperatorKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser);
+
+        bool isFreeSurface(size_t index_i) { return pos_div_[index_i] < threshold_by_dimensions_; };
+        void predict(size_t index_i, Real dt)
+        {
+            vel_[index_i] += force_prior_[index_i] / mass_[index_i] * dt;
+        };
+        /** The source term from the divergence of the predicted velocity. */
+        void initialize(size_t index_i, Real dt);
+        Real diagonal(size_t index_i, Real dt);
+        Real product(size_t index_i, Real *field, Real dt);
+        Real rhs(size_t index_i, Real dt) { return isFreeSurface(index_i) ? Real(0) : source_[index_i]; };
+        void computePressureForce(size_t index_i);
+        void update(size_t index_i, Real dt)
+        {
+            vel_[index_i] += force_[index_i] / mass_[index_i] * dt;
+            dpos_[index_i] += vel_[index_i] * dt;
+        };
+
+      protected:
+        Real *Vol_, *rho_, *mass_, *p_, *source_, *pos_div_;
+        Vecd *vel_, *force_, *force_prior_, *dpos_;
+        Real threshold_by_dimensions_, smoothing_length_sq_;
+
+        Real coefficient(size_t index_i, size_t index_j);
+    };
+
+  protected:
+    DiscreteVariable<Real> *dv_Vol_, *dv_rho_, *dv_mass_, *dv_p_, *dv_source_, *dv_pos_div_;
+    DiscreteVariable<Vecd> *dv_vel_, *dv_force_, *dv_force_prior_, *dv_dpos_;
+    Real threshold_by_dimensions_, smoothing_length_sq_;
+};
+
+template <typename... Parameters>
+class PressurePoissonOperatorCK<Contact<Wall, Parameters...>>
+    : public Interaction<Contact<Parameters...>>, public Interaction<Wall>
+{
+    using BaseInteraction = Interaction<Contact<Parameters...>>;
+
+  public:
+    explicit PressurePoissonOperatorCK(Relation<Contact<Parameters...>> &wall_contact_relation);
+    virtual ~PressurePoissonOperatorCK() {};
+
+    class InteractKernel : public BaseInteraction::InteractKernel
+    {
+      public:
+        template <class ExecutionPolicy, class EncloserType>
+        InteractKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser, UnsignedInt contact_index);
+        /** Add the wall terms of the divergence and the Neumann condition to the source term. */
+        void interact(size_t index_i, Real dt);
+        void addPressureForce(size_t index_i);
+
+      protected:
+        Real *Vol_, *rho_, *mass_, *p_, *source_;
+        Vecd *vel_, *force_, *force_prior_;
+        Real *wall_Vol_;
+        Vecd *wall_vel_ave_, *wall_acc_ave_;
+        Real smoothing_length_sq_;
+
+        /** The difference of the fluid and wall pressures from the Neumann condition. */
+        Real pressureJump(size_t index_i, size_t index_j)
+        {
+            return rho_[index_i] * (force_prior_[index_i] / mass_[index_i] - wall_acc_ave_[index_j])
+                                       .dot(this->vec_r_ij(index_i, index_j));
+        };
+    };
+
+  protected:
+    DiscreteVariable<Real> *dv_Vol_, *dv_rho_, *dv_mass_, *dv_p_, *dv_source_;
+    DiscreteVariable<Vecd> *dv_vel_, *dv_force_, *dv_force_prior_;
+    Real smoothing_length_sq_;
+};
+
+template <class ExecutionPolicy, typename... InteractionTypes>
+class PressureProjectionCK;
+
+template <class ExecutionPolicy>
+class PressureProjectionCK<ExecutionPolicy, Inner<>> : public BaseDynamics<void>
+{
+    using InnerOperatorType = PressurePoissonOperatorCK<Inner<>>;
+    using OperatorKernel = typename InnerOperatorType::OperatorKernel;
+
+  public:
+    explicit PressureProjectionCK(Relation<Inner<>> &inner_relation,
+                                  Real tolerance = 1.0e-6, UnsignedInt max_iterations = 500);
+    virtual ~PressureProjectionCK() {};
+    virtual void exec(Real dt = 0.0) override;
+    UnsignedInt NumberOfIterations() { return conjugate_gradient_.NumberOfIterations(); };
+    Real RelativeResidual() { return conjugate_gradient_.RelativeResidual(); };
+
+  protected:
+    SPHBody &sph_body_;
+    InnerOperatorType inner_operator_;
+    ConjugateGradientCK<ExecutionPolicy, InnerOperatorType> conjugate_gradient_;
+
+    virtual void addWallSource(Real dt) {};
+    virtual void addWallPressureForce() {};
+    /** Without free surface, the pressure is given up to a constant
+     * and the source term is made compatible by removing its mean. */
+    void makeSourceCompatible(OperatorKernel *operator_kernel);
+};
+
+template <class ExecutionPolicy>
+class PressureProjectionCK<ExecutionPolicy, Inner<>, Contact<Wall>>
+    : public PressureProjectionCK<ExecutionPolicy, Inner<>>
+{
+    using WallOperatorType = PressurePoissonOperatorCK<Contact<Wall>>;
+    using InteractKernel = typename WallOperatorType::InteractKernel;
+    using KernelImplementation = Implementation<ExecutionPolicy, WallOperatorType, InteractKernel>;
+
+  public:
+    PressureProjectionCK(Relation<Inner<>> &inner_relation, Relation<Contact<>> &wall_contact_relation,
+                         Real tolerance = 1.0e-6, UnsignedInt max_iterations = 500);
+    virtual ~PressureProjectionCK() {};
+
+  protected:
+    WallOperatorType wall_operator_;
+    UniquePtrsKeeper<KernelImplementation> contact_kernel_implementation_ptrs_;
+    StdVec<KernelImplementation *> contact_kernel_implementation_;
+
+    virtual void addWallSource(Real dt) override;
+    virtual void addWallPressureForce() override;
+};
+
+template <class ExecutionPolicy>
+using PressureProjectionInnerCK = PressureProjectionCK<ExecutionPolicy, Inner<>>;
+template <class ExecutionPolicy>
+using PressureProjectionWithWallCK = PressureProjectionCK<ExecutionPolicy, Inner<>, Contact<Wall>>;
+} // namespace fluid_dynamics
+} // namespace SPH
+#endif // PRESSURE_PROJECTION_CK_H
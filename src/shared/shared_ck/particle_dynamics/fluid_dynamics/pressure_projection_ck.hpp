@@ -0,0 +1,281 @@
+#ifndef PRESSURE_PROJECTION_CK_HPP
+#define PRESSURE_PROJECTION_CK_HPP
+
+#include "pressure_projection_ck.h"
+
+#include "conjugate_gradient_ck.hpp"
+
+namespace SPH
+{
+namespace fluid_dynamics
+{
+//=================================================================================================//
+template <typename... Parameters>
+PressurePoissonOperatorCK<Inner<Parameters...>>::
+    PressurePoissonOperatorCK(Relation<Inner<Parameters...>> &inner_relation)
+    : BaseInteraction(inner_relation),
+      dv_Vol_(this->particles_->template getVariableByName<Real>("VolumetricMeasure")),
+      dv_rho_(this->particles_->template getVariableByName<Real>("Density")),
+      dv_mass_(this->particles_->template getVariableByName<Real>("Mass")),
+      dv_p_(this->particles_->template registerStateVariableOnly<Real>("Pressure")),
+      dv_source_(this->particles_->template registerStateVariableOnly<Real>("ProjectionSource")),
+      dv_pos_div_(this->particles_->template registerStateVariableOnly<Real>("PositionDivergence")),
+      dv_vel_(this->particles_->template registerStateVariableOnly<Vecd>("Velocity")),
+      dv_force_(this->particles_->template registerStateVariableOnly<Vecd>("Force")),
+      dv_force_prior_(this->particles_->template registerStateVariableOnly<Vecd>("ForcePrior")),
+      dv_dpos_(this->particles_->template getVariableByName<Vecd>("Displacement")),
+      threshold_by_dimensions_(0.75 * Dimensions),
+      smoothing_length_sq_(pow(this->sph_body_.getSPHAdaptation().ReferenceSmoothingLength(), 2)) {}
+//=================================================================================================//
+template <typename... Parameters>
+template <class ExecutionPolicy, class EncloserType>
+PressurePoissonOperatorCK<Inner<Parameters...>>::OperatorKernel::
+    OperatorKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser)
+    : BaseInteraction::InteractKernel(ex_policy, encloser),
+      Vol_(encloser.dv_Vol_->DelegatedData(ex_policy)),
+      rho_(encloser.dv_rho_->DelegatedData(ex_policy)),
+      mass_(encloser.dv_mass_->DelegatedData(ex_policy)),
+      p_(encloser.dv_p_->DelegatedData(ex_policy)),
+      source_(encloser.dv_source_->DelegatedData(ex_policy)),
+      pos_div_(encloser.dv_pos_div_->DelegatedData(ex_policy)),
+      vel_(encloser.dv_vel_->DelegatedData(ex_policy)),
+      force_(encloser.dv_force_->DelegatedData(ex_policy)),
+      force_prior_(encloser.dv_force_prior_->DelegatedData(ex_policy)),
+      dpos_(encloser.dv_dpos_->DelegatedData(ex_policy)),
+      threshold_by_dimensions_(encloser.threshold_by_dimensions_),
+      smoothing_length_sq_(encloser.smoothing_length_sq_) {}
+//=================================================================================================//
+template <typename... Parameters>
+Real PressurePoissonOperatorCK<Inner<Parameters...>>::
+    OperatorKernel::coefficient(size_t index_i, size_t index_j)
+{
+    Vecd vec_r_ij = this->vec_r_ij(index_i, index_j);
+    return -2.0 * vec_r_ij.norm() * this->dW_ij(index_i, index_j) * Vol_[index_i] * Vol_[index_j] /
+           (0.5 * (rho_[index_i] + rho_[index_j]) *
+            (vec_r_ij.squaredNorm() + 0.01 * smoothing_length_sq_));
+}
+//=================================================================================================//
+template <typename... Parameters>
+void PressurePoissonOperatorCK<Inner<Parameters...>>::
+    OperatorKernel::initialize(size_t index_i, Real dt)
+{
+    Real divergence = 0.0;
+    for (UnsignedInt n = this->FirstNeighbor(index_i); n != this->LastNeighbor(index_i); ++n)
+    {
+        UnsignedInt index_j = this->neighbor_index_[n];
+        divergence += (vel_[index_i] - vel_[index_j]).dot(this->e_ij(index_i, index_j)) *
+                      this->dW_ij(index_i, index_j) * Vol_[index_j];
+    }
+    source_[index_i] = Vol_[index_i] * divergence / dt;
+}
+//=================================================================================================//
+template <typename... Parameters>
+Real PressurePoissonOperatorCK<Inner<Parameters...>>::
+    OperatorKernel::diagonal(size_t index_i, Real dt)
+{
+    Real sum = 0.0;
+    for (UnsignedInt n = this->FirstNeighbor(index_i); n != this->LastNeighbor(index_i); ++n)
+    {
+        sum += coefficient(index_i, this->neighbor_index_[n]);
+    }
+    return sum + TinyReal;
+}
+//=================================================================================================//
+template <typename... Parameters>
+Real PressurePoissonOperatorCK<Inner<Parameters...>>::
+    OperatorKernel::product(size_t index_i, Real *field, Real dt)
+{
+    Real sum = 0.0;
+    if (isFreeSurface(index_i))
+    {
+        for (UnsignedInt n = this->FirstNeighbor(index_i); n != this->LastNeighbor(index_i); ++n)
+        {
+            sum += coefficient(index_i, this->neighbor_index_[n]);
+        }
+        return (sum + TinyReal) * field[index_i];
+    }
+
+    for (UnsignedInt n = this->FirstNeighbor(index_i); n != this->LastNeighbor(index_i); ++n)
+    {
+        UnsignedInt index_j = this->neighbor_index_[n];
+        Real field_j = isFreeSurface(index_j) ? Real(0) : field[index_j];
+        sum += coefficient(index_i, index_j) * (field[index_i] - field_j);
+    }
+    return sum + TinyReal * field[index_i];
+}
+//=================================================================================================//
+template <typename... Parameters>
+void PressurePoissonOperatorCK<Inner<Parameters...>>::
+    OperatorKernel::computePressureForce(size_t index_i)
+{
+    Vecd force = Vecd::Zero();
+    for (UnsignedInt n = this->FirstNeighbor(index_i); n != this->LastNeighbor(index_i); ++n)
+    {
+        UnsignedInt index_j = this->neighbor_index_[n];
+        force -= (p_[index_i] + p_[index_j]) * this->dW_ij(index_i, index_j) * Vol_[index_j] *
+                 this->e_ij(index_i, index_j);
+    }
+    force_[index_i] = force * Vol_[index_i];
+}
+//=================================================================================================//
+template <typename... Parameters>
+PressurePoissonOperatorCK<Contact<Wall, Parameters...>>::
+    PressurePoissonOperatorCK(Relation<Contact<Parameters...>> &wall_contact_relation)
+    : BaseInteraction(wall_contact_relation), Interaction<Wall>(wall_contact_relation),
+      dv_Vol_(this->particles_->template getVariableByName<Real>("VolumetricMeasure")),
+      dv_rho_(this->particles_->template getVariableByName<Real>("Density")),
+      dv_mass_(this->particles_->template getVariableByName<Real>("Mass")),
+      dv_p_(this->particles_->template getVariableByName<Real>("Pressure")),
+      dv_source_(this->particles_->template getVariableByName<Real>("ProjectionSource")),
+      dv_vel_(this->particles_->template getVariableByName<Vecd>("Velocity")),
+      dv_force_(this->particles_->template getVariableByName<Vecd>("Force")),
+      dv_force_prior_(this->particles_->template getVariableByName<Vecd>("ForcePrior")),
+      smoothing_length_sq_(pow(this->sph_body_.getSPHAdaptation().ReferenceSmoothingLength(), 2)) {}
+//=================================================================================================//
+template <typename... Parameters>
+template <class ExecutionPolicy, class EncloserType>
+PressurePoissonOperatorCK<Contact<Wall, Parameters...>>::InteractKernel::
+    InteractKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser, UnsignedInt contact_index)
+    : BaseInteraction::InteractKernel(ex_policy, encloser, contact_index),
+      Vol_(encloser.dv_Vol_->DelegatedData(ex_policy)),
+      rho_(encloser.dv_rho_->DelegatedData(ex_policy)),
+      mass_(encloser.dv_mass_->DelegatedData(ex_policy)),
+      p_(encloser.dv_p_->DelegatedData(ex_policy)),
+      source_(encloser.dv_source_->DelegatedData(ex_policy)),
+      vel_(encloser.dv_vel_->DelegatedData(ex_policy)),
+      force_(encloser.dv_force_->DelegatedData(ex_policy)),
+      force_prior_(encloser.dv_force_prior_->DelegatedData(ex_policy)),
+      wall_Vol_(encloser.dv_wall_Vol_[contact_index]->DelegatedData(ex_policy)),
+      wall_vel_ave_(encloser.dv_wall_vel_ave_[contact_index]->DelegatedData(ex_policy)),
+      wall_acc_ave_(encloser.dv_wall_acc_ave_[contact_index]->DelegatedData(ex_policy)),
+      smoothing_length_sq_(encloser.smoothing_length_sq_) {}
+//=================================================================================================//
+template <typename... Parameters>
+void PressurePoissonOperatorCK<Contact<Wall, Parameters...>>::
+    InteractKernel::interact(size_t index_i, Real dt)
+{
+    // the wall velocity is compared with the velocity before the prediction
+    Vecd vel_i = vel_[index_i] - force_prior_[index_i] / mass_[index_i] * dt;
+    Real divergence = 0.0;
+    Real neumann_source = 0.0;
+    for (UnsignedInt n = this->FirstNeighbor(index_i); n != this->LastNeighbor(index_i); ++n)
+    {
+        UnsignedInt index_j = this->neighbor_index_[n];
+        Real dW_ij = this->dW_ij(index_i, index_j);
+        Vecd vec_r_ij = this->vec_r_ij(index_i, index_j);
+        divergence += (vel_i - wall_vel_ave_[index_j]).dot(this->e_ij(index_i, index_j)) *
+                      dW_ij * wall_Vol_[index_j];
+        Real coefficient = -2.0 * vec_r_ij.norm() * dW_ij * Vol_[index_i] * wall_Vol_[index_j] /
+                           (rho_[index_i] * (vec_r_ij.squaredNorm() + 0.01 * smoothing_length_sq_));
+        neumann_source += coefficient * pressureJump(index_i, index_j);
+    }
+    source_[index_i] += Vol_[index_i] * divergence / dt - neumann_source;
+}
+//=================================================================================================//
+template <typename... Parameters>
+void PressurePoissonOperatorCK<Contact<Wall, Parameters...>>::
+    InteractKernel::addPressureForce(size_t index_i)
+{
+    Vecd force = Vecd::Zero();
+    for (UnsignedInt n = this->FirstNeighbor(index_i); n != this->LastNeighbor(index_i); ++n)
+    {
+        UnsignedInt index_j = this->neighbor_index_[n];
+        Real p_j = p_[index_i] - pressureJump(index_i, index_j);
+        force -= (p_[index_i] + p_j) * this->dW_ij(index_i, index_j) * wall_Vol_[index_j] *
+                 this->e_ij(index_i, index_j);
+    }
+    force_[index_i] += force * Vol_[index_i];
+}
+//=================================================================================================//
+template <class ExecutionPolicy>
+PressureProjectionCK<ExecutionPolicy, Inner<>>::
+    PressureProjectionCK(Relation<Inner<>> &inner_relation, Real tolerance, UnsignedInt max_iterations)
+    : BaseDynamics<void>(), sph_body_(inner_relation.getSPHBody()),
+      inner_operator_(inner_relation),
+      conjugate_gradient_(inner_operator_, tolerance, max_iterations) {}
+//=================================================================================================//
+template <class ExecutionPolicy>
+void PressureProjectionCK<ExecutionPolicy, Inner<>>::exec(Real dt)
+{
+    this->setUpdated(sph_body_);
+    OperatorKernel *operator_kernel = conjugate_gradient_.getOperatorKernel();
+    particle_for(LoopRangeCK<ExecutionPolicy, SPHBody>(sph_body_),
+                 [=](size_t i)
+                 { operator_kernel->predict(i, dt); });
+    particle_for(LoopRangeCK<ExecutionPolicy, SPHBody>(sph_body_),
+                 [=](size_t i)
+                 { operator_kernel->initialize(i, dt); });
+
+    addWallSource(dt);
+    makeSourceCompatible(operator_kernel);
+    conjugate_gradient_.exec(dt);
+
+    particle_for(LoopRangeCK<ExecutionPolicy, SPHBody>(sph_body_),
+                 [=](size_t i)
+                 { operator_kernel->computePressureForce(i); });
+    addWallPressureForce();
+    particle_for(LoopRangeCK<ExecutionPolicy, SPHBody>(sph_body_),
+                 [=](size_t i)
+                 { operator_kernel->update(i, dt); });
+}
+//=================================================================================================//
+template <class ExecutionPolicy>
+void PressureProjectionCK<ExecutionPolicy, Inner<>>::makeSourceCompatible(OperatorKernel *operator_kernel)
+{
+    Real *source = inner_operator_.dvSource()->DelegatedData(ExecutionPolicy{});
+    Vec2d sum = particle_reduce<ReduceSum<Vec2d>>(
+        LoopRangeCK<ExecutionPolicy, SPHBody>(sph_body_), ZeroData<Vec2d>::value,
+        [=](size_t i) -> Vec2d
+        { return operator_kernel->isFreeSurface(i) ? Vec2d(0.0, 1.0) : Vec2d(source[i], 0.0); });
+
+    if (sum[1] < 0.5)
+    {
+        Real mean_source = sum[0] / Real(sph_body_.getBaseParticles().TotalRealParticles());
+        particle_for(LoopRangeCK<ExecutionPolicy, SPHBody>(sph_body_),
+                     [=](size_t i)
+                     { source[i] -= mean_source; });
+    }
+}
+//=================================================================================================//
+template <class ExecutionPolicy>
+PressureProjectionCK<ExecutionPolicy, Inner<>, Contact<Wall>>::
+    PressureProjectionCK(Relation<Inner<>> &inner_relation, Relation<Contact<>> &wall_contact_relation,
+                         Real tolerance, UnsignedInt max_iterations)
+    : PressureProjectionCK<ExecutionPolicy, Inner<>>(inner_relation, tolerance, max_iterations),
+      wall_operator_(wall_contact_relation)
+{
+    for (size_t k = 0; k != wall_contact_relation.getContactBodies().size(); ++k)
+    {
+        contact_kernel_implementation_.push_back(
+            contact_kernel_implementation_ptrs_.template createPtr<KernelImplementation>(wall_operator_));
+        wall_operator_.registerComputingKernel(contact_kernel_implementation_.back(), k);
+    }
+}
+//=================================================================================================//
+template <class ExecutionPolicy>
+void PressureProjectionCK<ExecutionPolicy, Inner<>, Contact<Wall>>::addWallSource(Real dt)
+{
+    for (size_t k = 0; k != contact_kernel_implementation_.size(); ++k)
+    {
+        InteractKernel *interact_kernel = contact_kernel_implementation_[k]->getComputingKernel(k);
+        particle_for(LoopRangeCK<ExecutionPolicy, SPHBody>(this->sph_body_),
+                     [=](size_t i)
+                     { interact_kernel->interact(i, dt); });
+    }
+}
+//=================================================================================================//
+template <class ExecutionPolicy>
+void PressureProjectionCK<ExecutionPolicy, Inner<>, Contact<Wall>>::addWallPressureForce()
+{
+    for (size_t k = 0; k != contact_kernel_implementation_.size(); ++k)
+    {
+        InteractKernel *interact_kernel = contact_kernel_implementation_[k]->getComputingKernel(k);
+        particle_for(LoopRangeCK<ExecutionPolicy, SPHBody>(this->sph_body_),
+                     [=](size_t i)
+                     { interact_kernel->addPressureForce(i); });
+    }
+}
+//=================================================================================================//
+} // namespace fluid_dynamics
+} // namespace SPH
+#endif // PRESSURE_PROJECTION_CK_HPP
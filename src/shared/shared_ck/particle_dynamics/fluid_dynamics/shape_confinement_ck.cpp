@@ -0,0 +1,38 @@
+#include "shape_confinement_ck.h"
+
+namespace SPH
+{
+namespace fluid_dynamics
+{
+//=================================================================================================//
+StaticConfinementDensityCK::
+    StaticConfinementDensityCK(NearShapeSurface &near_surface, KernelIntegralTable &kernel_integral_table)
+    : BaseLocalDynamics<BodyPartByCell>(near_surface),
+      kernel_integral_table_(kernel_integral_table),
+      rho0_(sph_body_.getBaseMaterial().ReferenceDensity()),
+      inv_sigma0_(1.0 / sph_body_.getSPHAdaptation().LatticeNumberDensity()),
+      dv_mass_(particles_->getVariableByName<Real>("Mass")),
+      dv_rho_sum_(particles_->registerStateVariableOnly<Real>("DensitySummation")),
+      dv_pos_(particles_->getVariableByName<Vecd>("Position")) {}
+//=================================================================================================//
+StaticConfinementIntegration1stHalfCK::
+    StaticConfinementIntegration1stHalfCK(NearShapeSurface &near_surface, KernelIntegralTable &kernel_integral_table)
+    : BaseLocalDynamics<BodyPartByCell>(near_surface),
+      kernel_integral_table_(kernel_integral_table),
+      dv_rho_(particles_->getVariableByName<Real>("Density")),
+      dv_p_(particles_->registerStateVariableOnly<Real>("Pressure")),
+      dv_mass_(particles_->getVariableByName<Real>("Mass")),
+      dv_pos_(particles_->getVariableByName<Vecd>("Position")),
+      dv_force_(particles_->registerStateVariableOnly<Vecd>("Force")) {}
+//=================================================================================================//
+StaticConfinementIntegration2ndHalfCK::
+    StaticConfinementIntegration2ndHalfCK(NearShapeSurface &near_surface, KernelIntegralTable &kernel_integral_table)
+    : BaseLocalDynamics<BodyPartByCell>(near_surface),
+      kernel_integral_table_(kernel_integral_table),
+      dv_rho_(particles_->getVariableByName<Real>("Density")),
+      dv_drho_dt_(particles_->registerStateVariableOnly<Real>("DensityChangeRate")),
+      dv_pos_(particles_->getVariableByName<Vecd>("Position")),
+      dv_vel_(particles_->registerStateVariableOnly<Vecd>("Velocity")) {}
+//=================================================================================================//
+} // namespace fluid_dynamics
+} // namespace SPH
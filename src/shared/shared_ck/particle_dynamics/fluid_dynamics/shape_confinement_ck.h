@@ -0,0 +1,159 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	shape_confinement_ck.h
+ * @brief 	Static confinement condition in computing kernels.
+ * @details The kernel integral and its gradient are interpolated from the table
+ *			computed once in the cells near the shape surface, so that the level set is not probed
+ *			in the computing kernels. The dynamics are used as post processes
+ *			of the density regularization and the acoustic steps, i.e. between their interaction and update.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef SHAPE_CONFINEMENT_CK_H
+#define SHAPE_CONFINEMENT_CK_H
+
+#include "base_fluid_dynamics.h"
+#include "shape_confinement.h"
+#include "simple_algorithms_ck.h"
+
+namespace SPH
+{
+namespace fluid_dynamics
+{
+class StaticConfinementDensityCK : public BaseLocalDynamics<BodyPartByCell>
+{
+  public:
+    StaticConfinementDensityCK(NearShapeSurface &near_surface, KernelIntegralTable &kernel_integral_table);
+    virtual ~StaticConfinementDensityCK() {};
+
+    class UpdateKernel
+    {
+      public:
+        template <class ExecutionPolicy, class EncloserType>
+        UpdateKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser);
+        void update(size_t index_i, Real dt = 0.0)
+        {
+            Real inv_Vol_0_i = rho0_ / mass_[index_i];
+            rho_sum_[index_i] +=
+                kernel_integral_table_.KernelIntegral(pos_[index_i]) * inv_Vol_0_i * rho0_ * inv_sigma0_;
+        };
+
+      protected:
+        Real rho0_, inv_sigma0_;
+        Real *mass_, *rho_sum_;
+        Vecd *pos_;
+        KernelIntegralTable::ComputingKernel kernel_integral_table_;
+    };
+
+  protected:
+    KernelIntegralTable &kernel_integral_table_;
+    Real rho0_, inv_sigma0_;
+    DiscreteVariable<Real> *dv_mass_, *dv_rho_sum_;
+    DiscreteVariable<Vecd> *dv_pos_;
+};
+
+class StaticConfinementIntegration1stHalfCK : public BaseLocalDynamics<BodyPartByCell>
+{
+  public:
+    StaticConfinementIntegration1stHalfCK(NearShapeSurface &near_surface, KernelIntegralTable &kernel_integral_table);
+    virtual ~StaticConfinementIntegration1stHalfCK() {};
+
+    class UpdateKernel
+    {
+      public:
+        template <class ExecutionPolicy, class EncloserType>
+        UpdateKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser);
+        void update(size_t index_i, Real dt = 0.0)
+        {
+            Vecd kernel_gradient = kernel_integral_table_.KernelGradientIntegral(pos_[index_i]);
+            force_[index_i] -= 2.0 * mass_[index_i] * p_[index_i] * kernel_gradient / rho_[index_i];
+        };
+
+      protected:
+        Real *rho_, *p_, *mass_;
+        Vecd *pos_, *force_;
+        KernelIntegralTable::ComputingKernel kernel_integral_table_;
+    };
+
+  protected:
+    KernelIntegralTable &kernel_integral_table_;
+    DiscreteVariable<Real> *dv_rho_, *dv_p_, *dv_mass_;
+    DiscreteVariable<Vecd> *dv_pos_, *dv_force_;
+};
+
+class StaticConfinementIntegration2ndHalfCK : public BaseLocalDynamics<BodyPartByCell>
+{
+  public:
+    StaticConfinementIntegration2ndHalfCK(NearShapeSurface &near_surface, KernelIntegralTable &kernel_integral_table);
+    virtual ~StaticConfinementIntegration2ndHalfCK() {};
+
+    class UpdateKernel
+    {
+      public:
+        template <class ExecutionPolicy, class EncloserType>
+        UpdateKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser);
+        void update(size_t index_i, Real dt = 0.0)
+        {
+            Vecd kernel_gradient = kernel_integral_table_.KernelGradientIntegral(pos_[index_i]);
+            Vecd vel_j_in_wall = -vel_[index_i];
+            drho_dt_[index_i] += rho_[index_i] * (vel_[index_i] - vel_j_in_wall).dot(kernel_gradient);
+        };
+
+      protected:
+        Real *rho_, *drho_dt_;
+        Vecd *pos_, *vel_;
+        KernelIntegralTable::ComputingKernel kernel_integral_table_;
+    };
+
+  protected:
+    KernelIntegralTable &kernel_integral_table_;
+    DiscreteVariable<Real> *dv_rho_, *dv_drho_dt_;
+    DiscreteVariable<Vecd> *dv_pos_, *dv_vel_;
+};
+
+/**
+ * @class StaticConfinementCK
+ * @brief Static confined boundary condition for complex structures in computing kernels.
+ */
+template <class ExecutionPolicy>
+class StaticConfinementCK
+{
+    KernelIntegralTable kernel_integral_table_;
+
+  public:
+    StateDynamics<ExecutionPolicy, StaticConfinementDensityCK> density_summation_;
+    StateDynamics<ExecutionPolicy, StaticConfinementIntegration1stHalfCK> pressure_relaxation_;
+    StateDynamics<ExecutionPolicy, StaticConfinementIntegration2ndHalfCK> density_relaxation_;
+
+    explicit StaticConfinementCK(NearShapeSurface &near_surface, int sub_cell_number = 8)
+        : kernel_integral_table_(near_surface, sub_cell_number),
+          density_summation_(near_surface, kernel_integral_table_),
+          pressure_relaxation_(near_surface, kernel_integral_table_),
+          density_relaxation_(near_surface, kernel_integral_table_) {};
+    virtual ~StaticConfinementCK() {};
+    KernelIntegralTable &getKernelIntegralTable() { return kernel_integral_table_; };
+};
+} // namespace fluid_dynamics
+} // namespace SPH
+#endif // SHAPE_CONFINEMENT_CK_H
@@ -0,0 +1,41 @@
+#ifndef SHAPE_CONFINEMENT_CK_HPP
+#define SHAPE_CONFINEMENT_CK_HPP
+
+#include "shape_confinement_ck.h"
+
+namespace SPH
+{
+namespace fluid_dynamics
+{
+//=================================================================================================//
+template <class ExecutionPolicy, class EncloserType>
+StaticConfinementDensityCK::UpdateKernel::
+    UpdateKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser)
+    : rho0_(encloser.rho0_), inv_sigma0_(encloser.inv_sigma0_),
+      mass_(encloser.dv_mass_->DelegatedData(ex_policy)),
+      rho_sum_(encloser.dv_rho_sum_->DelegatedData(ex_policy)),
+      pos_(encloser.dv_pos_->DelegatedData(ex_policy)),
+      kernel_integral_table_(ex_policy, encloser.kernel_integral_table_) {}
+//=================================================================================================//
+template <class ExecutionPolicy, class EncloserType>
+StaticConfinementIntegration1stHalfCK::UpdateKernel::
+    UpdateKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser)
+    : rho_(encloser.dv_rho_->DelegatedData(ex_policy)),
+      p_(encloser.dv_p_->DelegatedData(ex_policy)),
+      mass_(encloser.dv_mass_->DelegatedData(ex_policy)),
+      pos_(encloser.dv_pos_->DelegatedData(ex_policy)),
+      force_(encloser.dv_force_->DelegatedData(ex_policy)),
+      kernel_integral_table_(ex_policy, encloser.kernel_integral_table_) {}
+//=================================================================================================//
+template <class ExecutionPolicy, class EncloserType>
+StaticConfinementIntegration2ndHalfCK::UpdateKernel::
+    UpdateKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser)
+    : rho_(encloser.dv_rho_->DelegatedData(ex_policy)),
+      drho_dt_(encloser.dv_drho_dt_->DelegatedData(ex_policy)),
+      pos_(encloser.dv_pos_->DelegatedData(ex_policy)),
+      vel_(encloser.dv_vel_->DelegatedData(ex_policy)),
+      kernel_integral_table_(ex_policy, encloser.kernel_integral_table_) {}
+//=================================================================================================//
+} // namespace fluid_dynamics
+} // namespace SPH
+#endif // SHAPE_CONFINEMENT_CK_HPP
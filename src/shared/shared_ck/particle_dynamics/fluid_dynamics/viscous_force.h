@@ -74,6 +74,8 @@ class ViscousForceCK<Base, ViscosityType, KernelCorrectionType, RelationType<Par
   protected:
     template <typename...>
     friend class FSI::ViscousForceFromFluid;
+    template <typename...>
+    friend class FSI::PressureAndViscousForceFromFluid;
     using ViscosityModel = ViscosityType;
 
     ViscosityType &viscosity_model_;
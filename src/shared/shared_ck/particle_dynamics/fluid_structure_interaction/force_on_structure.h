@@ -148,6 +148,61 @@ class PressureForceFromFluid<Contact<WithUpdate, AcousticStep2ndHalfType, Parame
 };
 template <typename AcousticStep2ndHalfType>
 using PressureForceOnStructure = PressureForceFromFluid<Contact<WithUpdate, AcousticStep2ndHalfType>>;
+
+/**
+ * @class PressureAndViscousForceFromFluid
+ * @brief The pressure and viscous forces from the fluid evaluated in a single pass over the contact neighbors.
+ * The fluid states and the average velocity and acceleration of the structure are gathered once for both forces,
+ * and the total is accumulated into the force prior as "ForceFromFluid".
+ * The two parts are also kept as "PressureForceFromFluid" and "ViscousForceFromFluid" for output,
+ * therefore, this class replaces, and should not be used together with, the two separate ones.
+ * The kernel correction of the acoustic step is used for both parts.
+ * Particles without fluid neighbors, i.e. those not wetted, are skipped with zero force.
+ */
+template <typename...>
+class PressureAndViscousForceFromFluid;
+
+template <class AcousticStep2ndHalfType, typename ViscousForceType, typename... Parameters>
+class PressureAndViscousForceFromFluid<Contact<WithUpdate, AcousticStep2ndHalfType, ViscousForceType, Parameters...>>
+    : public ForceFromFluid<decltype(AcousticStep2ndHalfType::kernel_correction_), Parameters...>
+{
+    using RiemannSolverType = decltype(AcousticStep2ndHalfType::riemann_solver_);
+    using FluidType = typename RiemannSolverType::SourceFluid;
+    using ViscosityType = typename ViscousForceType::ViscosityModel;
+    using ViscosityKernel = typename ViscosityType::ComputingKernel;
+    using BaseForceFromFluid = ForceFromFluid<decltype(AcousticStep2ndHalfType::kernel_correction_), Parameters...>;
+
+  public:
+    template <class ContactRelationType>
+    explicit PressureAndViscousForceFromFluid(ContactRelationType &contact_relation);
+    virtual ~PressureAndViscousForceFromFluid(){};
+
+    class InteractKernel : public BaseForceFromFluid::InteractKernel
+    {
+      public:
+        template <class ExecutionPolicy, class EncloserType>
+        InteractKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser, UnsignedInt contact_index);
+        void interact(size_t index_i, Real dt = 0.0);
+
+      protected:
+        Vecd *acc_ave_, *n_, *pressure_force_, *viscous_force_;
+        RiemannSolverType riemann_solver_;
+        ViscosityKernel viscosity_;
+        Real smoothing_length_sq_;
+        Real *contact_rho_, *contact_mass_, *contact_p_;
+        Vecd *contact_force_prior_;
+    };
+
+  protected:
+    DiscreteVariable<Vecd> *dv_acc_ave_, *dv_n_, *dv_pressure_force_, *dv_viscous_force_;
+    StdVec<RiemannSolverType> contact_riemann_solver_;
+    StdVec<ViscosityType *> contact_viscosity_model_;
+    StdVec<Real> contact_smoothing_length_sq_;
+    StdVec<DiscreteVariable<Real> *> dv_contact_rho_, dv_contact_mass_, dv_contact_p_;
+    StdVec<DiscreteVariable<Vecd> *> dv_contact_force_prior_;
+};
+template <typename AcousticStep2ndHalfType, typename ViscousForceType>
+using FluidForceOnStructure = PressureAndViscousForceFromFluid<Contact<WithUpdate, AcousticStep2ndHalfType, ViscousForceType>>;
 } // namespace FSI
 } // namespace SPH
 #endif // FORCE_ON_STRUCTURE_H
\ No newline at end of file
@@ -136,6 +136,86 @@ void PressureForceFromFluid<Contact<WithUpdate, AcousticStep2ndHalfType, Paramet
     this->force_from_fluid_[index_i] = force * this->Vol_[index_i];
 }
 //=================================================================================================//
+template <class AcousticStep2ndHalfType, typename ViscousForceType, typename... Parameters>
+template <class ContactRelationType>
+PressureAndViscousForceFromFluid<Contact<WithUpdate, AcousticStep2ndHalfType, ViscousForceType, Parameters...>>::
+    PressureAndViscousForceFromFluid(ContactRelationType &contact_relation)
+    : BaseForceFromFluid(contact_relation, "ForceFromFluid"),
+      dv_acc_ave_(this->solid_.AverageAccelerationVariable(this->particles_)),
+      dv_n_(this->particles_->template getVariableByName<Vecd>("NormalDirection")),
+      dv_pressure_force_(this->particles_->template registerStateVariableOnly<Vecd>("PressureForceFromFluid")),
+      dv_viscous_force_(this->particles_->template registerStateVariableOnly<Vecd>("ViscousForceFromFluid"))
+{
+    for (size_t k = 0; k != this->contact_particles_.size(); ++k)
+    {
+        FluidType &contact_fluid_k = DynamicCast<FluidType>(this, this->contact_particles_[k]->getBaseMaterial());
+        contact_riemann_solver_.push_back(RiemannSolverType(contact_fluid_k, contact_fluid_k));
+        ViscosityType *viscosity_model_k = DynamicCast<ViscosityType>(this, &this->contact_particles_[k]->getBaseMaterial());
+        contact_viscosity_model_.push_back(viscosity_model_k);
+        contact_smoothing_length_sq_.push_back(pow(this->contact_bodies_[k]->getSPHAdaptation().ReferenceSmoothingLength(), 2));
+        dv_contact_rho_.push_back(this->contact_particles_[k]->template getVariableByName<Real>("Density"));
+        dv_contact_mass_.push_back(this->contact_particles_[k]->template getVariableByName<Real>("Mass"));
+        dv_contact_p_.push_back(this->contact_particles_[k]->template getVariableByName<Real>("Pressure"));
+        dv_contact_force_prior_.push_back(this->contact_particles_[k]->template getVariableByName<Vecd>("ForcePrior"));
+    }
+}
+//=================================================================================================//
+template <class AcousticStep2ndHalfType, typename ViscousForceType, typename... Parameters>
+template <class ExecutionPolicy, class EncloserType>
+PressureAndViscousForceFromFluid<Contact<WithUpdate, AcousticStep2ndHalfType, ViscousForceType, Parameters...>>::
+    InteractKernel::InteractKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser, UnsignedInt contact_index)
+    : BaseForceFromFluid::InteractKernel(ex_policy, encloser, contact_index),
+      acc_ave_(encloser.dv_acc_ave_->DelegatedData(ex_policy)),
+      n_(encloser.dv_n_->DelegatedData(ex_policy)),
+      pressure_force_(encloser.dv_pressure_force_->DelegatedData(ex_policy)),
+      viscous_force_(encloser.dv_viscous_force_->DelegatedData(ex_policy)),
+      riemann_solver_(encloser.contact_riemann_solver_[contact_index]),
+      viscosity_(ex_policy, *encloser.contact_viscosity_model_[contact_index]),
+      smoothing_length_sq_(encloser.contact_smoothing_length_sq_[contact_index]),
+      contact_rho_(encloser.dv_contact_rho_[contact_index]->DelegatedData(ex_policy)),
+      contact_mass_(encloser.dv_contact_mass_[contact_index]->DelegatedData(ex_policy)),
+      contact_p_(encloser.dv_contact_p_[contact_index]->DelegatedData(ex_policy)),
+      contact_force_prior_(encloser.dv_contact_force_prior_[contact_index]->DelegatedData(ex_policy)) {}
+//=================================================================================================//
+template <class AcousticStep2ndHalfType, typename ViscousForceType, typename... Parameters>
+void PressureAndViscousForceFromFluid<Contact<WithUpdate, AcousticStep2ndHalfType, ViscousForceType, Parameters...>>::
+    InteractKernel::interact(size_t index_i, Real dt)
+{
+    Vecd pressure_force = Vecd::Zero();
+    Vecd viscous_force = Vecd::Zero();
+    if (this->FirstNeighbor(index_i) != this->LastNeighbor(index_i))
+    {
+        const Vecd vel_ave_i = this->vel_ave_[index_i];
+        const Vecd acc_ave_i = acc_ave_[index_i];
+        const Vecd n_i = n_[index_i];
+        for (UnsignedInt n = this->FirstNeighbor(index_i); n != this->LastNeighbor(index_i); ++n)
+        {
+            UnsignedInt index_j = this->neighbor_index_[n];
+            Vecd e_ij = this->e_ij(index_i, index_j);
+            Vecd vec_r_ij = this->vec_r_ij(index_i, index_j);
+            Real r_ij = vec_r_ij.norm();
+            Real dW_ijV_j = this->dW_ij(index_i, index_j) * this->contact_Vol_[index_j];
+            Vecd corrected_e_ij = this->contact_correction_(index_j) * e_ij;
+            Vecd vel_j = this->contact_vel_[index_j];
+            Real p_j = contact_p_[index_j];
+
+            Real face_wall_external_acceleration =
+                (contact_force_prior_[index_j] / contact_mass_[index_j] - acc_ave_i).dot(e_ij);
+            Real p_j_in_wall = p_j + contact_rho_[index_j] * r_ij * SMAX(Real(0), face_wall_external_acceleration);
+            Real u_jump = 2.0 * (vel_j - vel_ave_i).dot(n_i);
+            pressure_force -= (riemann_solver_.DissipativePJump(u_jump) * n_i +
+                               (p_j_in_wall + p_j) * corrected_e_ij) *
+                              dW_ijV_j;
+
+            Vecd vel_derivative = (vel_ave_i - vel_j) / (r_ij * r_ij + 0.01 * smoothing_length_sq_);
+            viscous_force += vec_r_ij.dot(corrected_e_ij) * viscosity_(index_j) * vel_derivative * dW_ijV_j;
+        }
+    }
+    pressure_force_[index_i] = pressure_force * this->Vol_[index_i];
+    viscous_force_[index_i] = viscous_force * this->Vol_[index_i];
+    this->force_from_fluid_[index_i] = pressure_force_[index_i] + viscous_force_[index_i];
+}
+//=================================================================================================//
 } // namespace FSI
 } // namespace SPH
 #endif // FORCE_ON_STRUCTURE_HPP
\ No newline at end of file
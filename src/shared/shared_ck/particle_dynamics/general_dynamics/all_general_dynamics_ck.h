@@ -30,6 +30,7 @@
 #pragma once
 
 #include "all_surface_indication_ck.h"
+#include "conjugate_gradient_ck.hpp"
 #include "force_prior_ck.hpp"
 #include "general_constraint_ck.h"
 #include "general_gradient.hpp"
@@ -0,0 +1,82 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	conjugate_gradient_ck.h
+ * @brief 	Matrix-free preconditioned conjugate gradient solver for particle operators.
+ * @details The linear system A x = b is given by a local dynamics, the linear operator,
+ *			whose OperatorKernel evaluates the diagonal of A, the product of A
+ *			with a particle field and the right-hand side b, all for a single particle.
+ *			The matrix is never assembled; the products are evaluated with the neighbor lists.
+ *			The operator should be symmetric positive definite
+ *			and the Jacobi preconditioner is used.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef CONJUGATE_GRADIENT_CK_H
+#define CONJUGATE_GRADIENT_CK_H
+
+#include "base_general_dynamics.h"
+#include "implementation.h"
+
+namespace SPH
+{
+/**
+ * @class ConjugateGradientCK
+ * @brief Solve the linear system given by the linear operator for its solution variable,
+ * which gives the initial guess and is updated in place.
+ * The iteration stops when the residual norm is below the tolerance relative to
+ * the norm of the right-hand side, or when the maximum number of iterations is reached.
+ */
+template <class ExecutionPolicy, class LinearOperatorType>
+class ConjugateGradientCK : public BaseDynamics<void>
+{
+    using DataType = typename LinearOperatorType::DataType;
+    using OperatorKernel = typename LinearOperatorType::OperatorKernel;
+
+  public:
+    ConjugateGradientCK(LinearOperatorType &linear_operator, Real tolerance = 1.0e-6,
+                        UnsignedInt max_iterations = 100);
+    virtual ~ConjugateGradientCK() {};
+    virtual void exec(Real dt = 0.0) override;
+    OperatorKernel *getOperatorKernel() { return operator_implementation_.getComputingKernel(); };
+    /** The number of iterations and the relative residual of the last solve. */
+    UnsignedInt NumberOfIterations() { return number_of_iterations_; };
+    Real RelativeResidual() { return relative_residual_; };
+
+  protected:
+    LinearOperatorType &linear_operator_;
+    SPHBody &sph_body_;
+    Implementation<ExecutionPolicy, LinearOperatorType, OperatorKernel> operator_implementation_;
+    DiscreteVariable<DataType> *dv_solution_, *dv_residual_, *dv_direction_, *dv_product_;
+    DiscreteVariable<Real> *dv_diagonal_;
+    Real tolerance_;
+    UnsignedInt max_iterations_;
+    UnsignedInt number_of_iterations_;
+    Real relative_residual_;
+
+    static Real innerProduct(const Real &a, const Real &b) { return a * b; };
+    template <typename EigenType>
+    static Real innerProduct(const EigenType &a, const EigenType &b) { return a.dot(b); };
+};
+} // namespace SPH
+#endif // CONJUGATE_GRADIENT_CK_H
@@ -0,0 +1,98 @@
+#ifndef CONJUGATE_GRADIENT_CK_HPP
+#define CONJUGATE_GRADIENT_CK_HPP
+
+#include "conjugate_gradient_ck.h"
+
+#include "particle_iterators_ck.h"
+
+namespace SPH
+{
+//=================================================================================================//
+template <class ExecutionPolicy, class LinearOperatorType>
+ConjugateGradientCK<ExecutionPolicy, LinearOperatorType>::
+    ConjugateGradientCK(LinearOperatorType &linear_operator, Real tolerance, UnsignedInt max_iterations)
+    : BaseDynamics<void>(), linear_operator_(linear_operator),
+      sph_body_(linear_operator.getSPHBody()),
+      operator_implementation_(linear_operator),
+      dv_solution_(linear_operator.dvSolution()),
+      dv_residual_(sph_body_.getBaseParticles().template registerStateVariableOnly<DataType>(
+          dv_solution_->Name() + "Residual")),
+      dv_direction_(sph_body_.getBaseParticles().template registerStateVariableOnly<DataType>(
+          dv_solution_->Name() + "Direction")),
+      dv_product_(sph_body_.getBaseParticles().template registerStateVariableOnly<DataType>(
+          dv_solution_->Name() + "Product")),
+      dv_diagonal_(sph_body_.getBaseParticles().template registerStateVariableOnly<Real>(
+          dv_solution_->Name() + "Diagonal")),
+      tolerance_(tolerance), max_iterations_(max_iterations),
+      number_of_iterations_(0), relative_residual_(0)
+{
+    linear_operator_.registerComputingKernel(&operator_implementation_);
+}
+//=================================================================================================//
+template <class ExecutionPolicy, class LinearOperatorType>
+void ConjugateGradientCK<ExecutionPolicy, LinearOperatorType>::exec(Real dt)
+{
+    ExecutionPolicy ex_policy;
+    OperatorKernel *operator_kernel = operator_implementation_.getComputingKernel();
+    DataType *x = dv_solution_->DelegatedData(ex_policy);
+    DataType *r = dv_residual_->DelegatedData(ex_policy);
+    DataType *p = dv_direction_->DelegatedData(ex_policy);
+    DataType *q = dv_product_->DelegatedData(ex_policy);
+    Real *diagonal = dv_diagonal_->DelegatedData(ex_policy);
+    LoopRangeCK<ExecutionPolicy, SPHBody> loop_range(sph_body_);
+
+    // the preconditioned residual r/D is not stored but recomputed when needed
+    Vec3d initial = particle_reduce<ReduceSum<Vec3d>>(
+        loop_range, ZeroData<Vec3d>::value,
+        [=](size_t i) -> Vec3d
+        {
+            diagonal[i] = operator_kernel->diagonal(i, dt);
+            DataType b = operator_kernel->rhs(i, dt);
+            r[i] = b - operator_kernel->product(i, x, dt);
+            p[i] = r[i] / diagonal[i];
+            return Vec3d(innerProduct(r[i], p[i]), innerProduct(r[i], r[i]), innerProduct(b, b));
+        });
+    Real rz = initial[0];
+    Real rr = initial[1];
+    Real tolerance_sq = tolerance_ * tolerance_ * initial[2];
+
+    number_of_iterations_ = 0;
+    while (rr > tolerance_sq && number_of_iterations_ < max_iterations_)
+    {
+        Real pq = particle_reduce<ReduceSum<Real>>(
+            loop_range, Real(0),
+            [=](size_t i) -> Real
+            {
+                q[i] = operator_kernel->product(i, p, dt);
+                return innerProduct(p[i], q[i]);
+            });
+        if (pq <= 0.0)
+            break; // not positive definite or already converged to round-off
+
+        Real alpha = rz / pq;
+        Vec2d updated = particle_reduce<ReduceSum<Vec2d>>(
+            loop_range, ZeroData<Vec2d>::value,
+            [=](size_t i) -> Vec2d
+            {
+                x[i] += alpha * p[i];
+                r[i] -= alpha * q[i];
+                Real r_sq = innerProduct(r[i], r[i]);
+                return Vec2d(r_sq / diagonal[i], r_sq);
+            });
+        Real beta = updated[0] / rz;
+        rz = updated[0];
+        rr = updated[1];
+        number_of_iterations_++;
+
+        if (rr > tolerance_sq)
+        {
+            particle_for(loop_range,
+                         [=](size_t i)
+                         { p[i] = r[i] / diagonal[i] + beta * p[i]; });
+        }
+    }
+    relative_residual_ = std::sqrt(rr / (initial[2] + TinyReal));
+}
+//=================================================================================================//
+} // namespace SPH
+#endif // CONJUGATE_GRADIENT_CK_HPP
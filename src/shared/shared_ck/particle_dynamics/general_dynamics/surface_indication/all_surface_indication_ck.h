@@ -31,6 +31,7 @@
  */
 
 
+#include "free_surface_state_ck.hpp"
 #include "surface_indication_ck.hpp"
 
 
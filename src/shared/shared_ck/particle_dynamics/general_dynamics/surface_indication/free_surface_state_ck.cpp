@@ -0,0 +1,24 @@
+#include "free_surface_state_ck.h"
+
+namespace SPH
+{
+namespace fluid_dynamics
+{
+//=================================================================================================//
+SurfaceEvaluationDisplacementCK::SurfaceEvaluationDisplacementCK(SPHBody &sph_body)
+    : LocalDynamicsReduce<ReduceMax>(sph_body),
+      dv_pos_(particles_->getVariableByName<Vecd>("Position")),
+      dv_evaluation_pos_(particles_->getVariableByName<Vecd>("SurfaceEvaluationPosition"))
+{
+    quantity_name_ = "SurfaceEvaluationDisplacement";
+}
+//=================================================================================================//
+FreeSurfaceTensionForceCK::FreeSurfaceTensionForceCK(SPHBody &sph_body, Real surface_tension_coeff)
+    : LocalDynamics(sph_body), ForcePriorCK(particles_, "FreeSurfaceTensionForce"),
+      surface_tension_coeff_(surface_tension_coeff),
+      dv_Vol_(particles_->getVariableByName<Real>("VolumetricMeasure")),
+      dv_curvature_(particles_->getVariableByName<Real>("FreeSurfaceCurvature")),
+      dv_color_gradient_(particles_->getVariableByName<Vecd>("ColorGradient")) {}
+//=================================================================================================//
+} // namespace fluid_dynamics
+} // namespace SPH
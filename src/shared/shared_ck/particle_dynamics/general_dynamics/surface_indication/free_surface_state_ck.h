@@ -0,0 +1,254 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2025 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file    free_surface_state_ck.h
+ * @brief   Cached free-surface state: indicator, colour-gradient normal and curvature
+ *          computed in two fused particle passes.
+ * @details The first pass accumulates the position divergence and the colour gradient,
+ *          the second pass determines the spatial-temporal indicator, the normal and the curvature.
+ *          Between full evaluations, only the particles in the smeared surface layer
+ *          of the last full evaluation are evaluated. A full evaluation is triggered
+ *          when the maximum displacement since the last one exceeds a skin distance,
+ *          in the same spirit of Verlet-list skins.
+ *          The results are shared by the density regularization,
+ *          bulk-particle scopes of transport-velocity correction and the surface tension force.
+ * @author  Xiangyu Hu
+ */
+
+#ifndef FREE_SURFACE_STATE_CK_H
+#define FREE_SURFACE_STATE_CK_H
+
+#include "base_fluid_dynamics.h"
+#include "base_general_dynamics.h"
+#include "force_prior_ck.h"
+#include "interaction_algorithms_ck.hpp"
+#include "interaction_ck.hpp"
+#include "simple_algorithms_ck.h"
+
+namespace SPH
+{
+namespace fluid_dynamics
+{
+template <typename... RelationTypes>
+class FreeSurfaceStateCK;
+
+template <template <typename...> class RelationType, typename... Parameters>
+class FreeSurfaceStateCK<Base, RelationType<Parameters...>>
+    : public Interaction<RelationType<Parameters...>>
+{
+  public:
+    template <class BaseRelationType>
+    explicit FreeSurfaceStateCK(BaseRelationType &base_relation);
+    virtual ~FreeSurfaceStateCK() {};
+
+    class InteractKernel : public Interaction<RelationType<Parameters...>>::InteractKernel
+    {
+      public:
+        template <class ExecutionPolicy, typename... Args>
+        InteractKernel(const ExecutionPolicy &ex_policy,
+                       FreeSurfaceStateCK<Base, RelationType<Parameters...>> &encloser,
+                       Args &&...args);
+
+      protected:
+        UnsignedInt *full_evaluation_;
+        int *smeared_surface_;
+        Real *pos_div_, *Vol_;
+        Vecd *color_gradient_;
+        Real threshold_by_dimensions_;
+        Real smoothing_length_;
+
+        bool isEvaluated(size_t index_i) { return *full_evaluation_ != 0 || smeared_surface_[index_i] != 0; };
+    };
+
+  protected:
+    SingularVariable<UnsignedInt> *sv_full_evaluation_;
+    DiscreteVariable<int> *dv_smeared_surface_;
+    DiscreteVariable<Real> *dv_pos_div_, *dv_Vol_;
+    DiscreteVariable<Vecd> *dv_color_gradient_;
+    Real threshold_by_dimensions_;
+    Real smoothing_length_;
+};
+
+template <typename... Parameters>
+class FreeSurfaceStateCK<Inner<WithUpdate, Parameters...>>
+    : public FreeSurfaceStateCK<Base, Inner<Parameters...>>
+{
+    using BaseStateKernel = typename FreeSurfaceStateCK<Base, Inner<Parameters...>>::InteractKernel;
+
+  public:
+    explicit FreeSurfaceStateCK(Relation<Inner<Parameters...>> &inner_relation);
+    virtual ~FreeSurfaceStateCK() {};
+
+    class InteractKernel : public BaseStateKernel
+    {
+      public:
+        template <class ExecutionPolicy>
+        InteractKernel(const ExecutionPolicy &ex_policy,
+                       FreeSurfaceStateCK<Inner<WithUpdate, Parameters...>> &encloser);
+        void interact(size_t index_i, Real dt = 0.0);
+    };
+
+    class UpdateKernel : public BaseStateKernel
+    {
+      public:
+        template <class ExecutionPolicy>
+        UpdateKernel(const ExecutionPolicy &ex_policy,
+                     FreeSurfaceStateCK<Inner<WithUpdate, Parameters...>> &encloser);
+        void update(size_t index_i, Real dt = 0.0);
+
+      protected:
+        int *indicator_, *previous_surface_indicator_;
+        Vecd *pos_, *evaluation_pos_, *surface_normal_;
+        Real *curvature_;
+
+        Vecd unitNormal(size_t index_i) { return this->color_gradient_[index_i] / (this->color_gradient_[index_i].norm() + TinyReal); };
+    };
+
+  protected:
+    DiscreteVariable<int> *dv_indicator_, *dv_previous_surface_indicator_;
+    DiscreteVariable<Vecd> *dv_pos_, *dv_evaluation_pos_, *dv_surface_normal_;
+    DiscreteVariable<Real> *dv_curvature_;
+};
+
+template <typename... Parameters>
+class FreeSurfaceStateCK<Contact<Parameters...>>
+    : public FreeSurfaceStateCK<Base, Contact<Parameters...>>
+{
+  public:
+    explicit FreeSurfaceStateCK(Relation<Contact<Parameters...>> &contact_relation);
+    virtual ~FreeSurfaceStateCK() {};
+
+    class InteractKernel : public FreeSurfaceStateCK<Base, Contact<Parameters...>>::InteractKernel
+    {
+      public:
+        template <class ExecutionPolicy>
+        InteractKernel(const ExecutionPolicy &ex_policy,
+                       FreeSurfaceStateCK<Contact<Parameters...>> &encloser,
+                       size_t contact_index);
+        void interact(size_t index_i, Real dt = 0.0);
+
+      protected:
+        Real *contact_Vol_;
+    };
+
+  protected:
+    StdVec<DiscreteVariable<Real> *> dv_contact_Vol_;
+};
+
+using FreeSurfaceStateInnerCK = FreeSurfaceStateCK<Inner<WithUpdate>>;
+using FreeSurfaceStateComplexCK = FreeSurfaceStateCK<Inner<WithUpdate>, Contact<>>;
+
+/**
+ * @class SurfaceEvaluationDisplacementCK
+ * @brief The maximum particle displacement since the last full free-surface evaluation.
+ */
+class SurfaceEvaluationDisplacementCK : public LocalDynamicsReduce<ReduceMax>
+{
+  public:
+    explicit SurfaceEvaluationDisplacementCK(SPHBody &sph_body);
+    virtual ~SurfaceEvaluationDisplacementCK() {};
+
+    class ReduceKernel
+    {
+      public:
+        template <class ExecutionPolicy, class EncloserType>
+        ReduceKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser);
+        Real reduce(size_t index_i, Real dt = 0.0)
+        {
+            return (pos_[index_i] - evaluation_pos_[index_i]).norm();
+        };
+
+      protected:
+        Vecd *pos_, *evaluation_pos_;
+    };
+
+  protected:
+    DiscreteVariable<Vecd> *dv_pos_, *dv_evaluation_pos_;
+};
+
+/**
+ * @class CachedFreeSurfaceStateCK
+ * @brief Runs the free-surface state with the displacement test.
+ * Note that it should be constructed before the dynamics sharing its results.
+ */
+template <class ExecutionPolicy, typename... InteractionTypes>
+class CachedFreeSurfaceStateCK : public BaseDynamics<void>
+{
+  public:
+    template <class InnerRelationType, typename... ContactRelationTypes>
+    CachedFreeSurfaceStateCK(InnerRelationType &inner_relation, ContactRelationTypes &...contact_relations);
+    virtual ~CachedFreeSurfaceStateCK() {};
+    virtual void exec(Real dt = 0.0) override;
+    void setSkinDistance(Real skin_distance) { skin_distance_ = skin_distance; };
+    size_t NumberOfFullEvaluations() { return number_of_full_evaluations_; };
+
+  protected:
+    InteractionDynamicsCK<ExecutionPolicy, FreeSurfaceStateCK<InteractionTypes...>> free_surface_state_;
+    ReduceDynamicsCK<ExecutionPolicy, SurfaceEvaluationDisplacementCK> evaluation_displacement_;
+    SingularVariable<UnsignedInt> *sv_full_evaluation_;
+    Real skin_distance_;
+    bool is_evaluated_;
+    size_t number_of_full_evaluations_;
+};
+
+template <class ExecutionPolicy>
+using CachedFreeSurfaceStateInnerCK = CachedFreeSurfaceStateCK<ExecutionPolicy, Inner<WithUpdate>>;
+template <class ExecutionPolicy>
+using CachedFreeSurfaceStateComplexCK = CachedFreeSurfaceStateCK<ExecutionPolicy, Inner<WithUpdate>, Contact<>>;
+
+/**
+ * @class FreeSurfaceTensionForceCK
+ * @brief Continuum surface force with the cached colour gradient and curvature.
+ */
+class FreeSurfaceTensionForceCK : public LocalDynamics, public ForcePriorCK
+{
+  public:
+    FreeSurfaceTensionForceCK(SPHBody &sph_body, Real surface_tension_coeff);
+    virtual ~FreeSurfaceTensionForceCK() {};
+
+    class UpdateKernel : public ForcePriorCK::UpdateKernel
+    {
+      public:
+        template <class ExecutionPolicy, class EncloserType>
+        UpdateKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser);
+        void update(size_t index_i, Real dt = 0.0)
+        {
+            this->current_force_[index_i] =
+                -surface_tension_coeff_ * curvature_[index_i] * color_gradient_[index_i] * Vol_[index_i];
+            ForcePriorCK::UpdateKernel::update(index_i, dt);
+        };
+
+      protected:
+        Real surface_tension_coeff_;
+        Real *Vol_, *curvature_;
+        Vecd *color_gradient_;
+    };
+
+  protected:
+    Real surface_tension_coeff_;
+    DiscreteVariable<Real> *dv_Vol_, *dv_curvature_;
+    DiscreteVariable<Vecd> *dv_color_gradient_;
+};
+} // namespace fluid_dynamics
+} // namespace SPH
+#endif // FREE_SURFACE_STATE_CK_H
@@ -0,0 +1,242 @@
+#ifndef FREE_SURFACE_STATE_CK_HPP
+#define FREE_SURFACE_STATE_CK_HPP
+
+#include "free_surface_state_ck.h"
+
+#include "base_particles.hpp"
+#include "force_prior_ck.hpp"
+
+namespace SPH
+{
+namespace fluid_dynamics
+{
+//=================================================================================================//
+template <template <typename...> class RelationType, typename... Parameters>
+template <class BaseRelationType>
+FreeSurfaceStateCK<Base, RelationType<Parameters...>>::FreeSurfaceStateCK(BaseRelationType &base_relation)
+    : Interaction<RelationType<Parameters...>>(base_relation),
+      sv_full_evaluation_(this->particles_->template registerSingularVariable<UnsignedInt>("FullSurfaceEvaluation", 1)),
+      dv_smeared_surface_(this->particles_->template registerStateVariableOnly<int>("SmearedSurface", 1)),
+      dv_pos_div_(this->particles_->template registerStateVariableOnly<Real>("PositionDivergence")),
+      dv_Vol_(this->particles_->template getVariableByName<Real>("VolumetricMeasure")),
+      dv_color_gradient_(this->particles_->template registerStateVariableOnly<Vecd>("ColorGradient")),
+      threshold_by_dimensions_(0.75 * Dimensions),
+      smoothing_length_(this->sph_body_.getSPHAdaptation().ReferenceSmoothingLength()) {}
+//=================================================================================================//
+template <template <typename...> class RelationType, typename... Parameters>
+template <class ExecutionPolicy, typename... Args>
+FreeSurfaceStateCK<Base, RelationType<Parameters...>>::InteractKernel::
+    InteractKernel(const ExecutionPolicy &ex_policy,
+                   FreeSurfaceStateCK<Base, RelationType<Parameters...>> &encloser,
+                   Args &&...args)
+    : Interaction<RelationType<Parameters...>>::InteractKernel(ex_policy, encloser, std::forward<Args>(args)...),
+      full_evaluation_(encloser.sv_full_evaluation_->DelegatedData(ex_policy)),
+      smeared_surface_(encloser.dv_smeared_surface_->DelegatedData(ex_policy)),
+      pos_div_(encloser.dv_pos_div_->DelegatedData(ex_policy)),
+      Vol_(encloser.dv_Vol_->DelegatedData(ex_policy)),
+      color_gradient_(encloser.dv_color_gradient_->DelegatedData(ex_policy)),
+      threshold_by_dimensions_(encloser.threshold_by_dimensions_),
+      smoothing_length_(encloser.smoothing_length_) {}
+//=================================================================================================//
+template <typename... Parameters>
+FreeSurfaceStateCK<Inner<WithUpdate, Parameters...>>::
+    FreeSurfaceStateCK(Relation<Inner<Parameters...>> &inner_relation)
+    : FreeSurfaceStateCK<Base, Inner<Parameters...>>(inner_relation),
+      dv_indicator_(this->particles_->template registerStateVariableOnly<int>("Indicator")),
+      dv_previous_surface_indicator_(this->particles_->template registerStateVariableOnly<int>("PreviousSurfaceIndicator")),
+      dv_pos_(this->particles_->template getVariableByName<Vecd>("Position")),
+      dv_evaluation_pos_(this->particles_->template registerStateVariableOnly<Vecd>("SurfaceEvaluationPosition")),
+      dv_surface_normal_(this->particles_->template registerStateVariableOnly<Vecd>("FreeSurfaceNormal")),
+      dv_curvature_(this->particles_->template registerStateVariableOnly<Real>("FreeSurfaceCurvature"))
+{
+    this->particles_->template addEvolvingVariable<int>("SmearedSurface");
+    this->particles_->template addEvolvingVariable<int>("PreviousSurfaceIndicator");
+    this->particles_->template addEvolvingVariable<Vecd>("SurfaceEvaluationPosition");
+}
+//=================================================================================================//
+template <typename... Parameters>
+template <class ExecutionPolicy>
+FreeSurfaceStateCK<Inner<WithUpdate, Parameters...>>::InteractKernel::
+    InteractKernel(const ExecutionPolicy &ex_policy,
+                   FreeSurfaceStateCK<Inner<WithUpdate, Parameters...>> &encloser)
+    : BaseStateKernel(ex_policy, encloser) {}
+//=================================================================================================//
+template <typename... Parameters>
+void FreeSurfaceStateCK<Inner<WithUpdate, Parameters...>>::InteractKernel::interact(size_t index_i, Real dt)
+{
+    if (!this->isEvaluated(index_i))
+    {
+        this->pos_div_[index_i] = 2.0 * this->threshold_by_dimensions_;
+        this->color_gradient_[index_i] = Vecd::Zero();
+        return;
+    }
+
+    Real pos_div = 0.0;
+    Vecd color_gradient = Vecd::Zero();
+    for (UnsignedInt n = this->FirstNeighbor(index_i); n != this->LastNeighbor(index_i); ++n)
+    {
+        UnsignedInt index_j = this->neighbor_index_[n];
+        Vecd vec_r_ij = this->vec_r_ij(index_i, index_j);
+        Real dW_ijV_j = this->dW_ij(index_i, index_j) * this->Vol_[index_j];
+        pos_div -= dW_ijV_j * vec_r_ij.norm();
+        color_gradient -= dW_ijV_j * this->e_ij(index_i, index_j);
+    }
+    this->pos_div_[index_i] = pos_div;
+    this->color_gradient_[index_i] = color_gradient;
+}
+//=================================================================================================//
+template <typename... Parameters>
+template <class ExecutionPolicy>
+FreeSurfaceStateCK<Inner<WithUpdate, Parameters...>>::UpdateKernel::
+    UpdateKernel(const ExecutionPolicy &ex_policy,
+                 FreeSurfaceStateCK<Inner<WithUpdate, Parameters...>> &encloser)
+    : BaseStateKernel(ex_policy, encloser),
+      indicator_(encloser.dv_indicator_->DelegatedData(ex_policy)),
+      previous_surface_indicator_(encloser.dv_previous_surface_indicator_->DelegatedData(ex_policy)),
+      pos_(encloser.dv_pos_->DelegatedData(ex_policy)),
+      evaluation_pos_(encloser.dv_evaluation_pos_->DelegatedData(ex_policy)),
+      surface_normal_(encloser.dv_surface_normal_->DelegatedData(ex_policy)),
+      curvature_(encloser.dv_curvature_->DelegatedData(ex_policy)) {}
+//=================================================================================================//
+template <typename... Parameters>
+void FreeSurfaceStateCK<Inner<WithUpdate, Parameters...>>::UpdateKernel::update(size_t index_i, Real dt)
+{
+    bool is_full_evaluation = *this->full_evaluation_ != 0;
+    if (is_full_evaluation)
+        evaluation_pos_[index_i] = pos_[index_i];
+
+    if (!this->isEvaluated(index_i))
+    {
+        indicator_[index_i] = 0;
+        previous_surface_indicator_[index_i] = 0;
+        surface_normal_[index_i] = Vecd::Zero();
+        curvature_[index_i] = 0.0;
+        return;
+    }
+
+    Real threshold = this->threshold_by_dimensions_;
+    Vecd normal_i = unitNormal(index_i);
+    bool is_very_near_surface = false;
+    bool is_near_previous_surface = false;
+    bool is_near_truncated_support = false;
+    Real normal_divergence = 0.0;
+    Real truncated_pos_div = 0.0;
+    for (UnsignedInt n = this->FirstNeighbor(index_i); n != this->LastNeighbor(index_i); ++n)
+    {
+        UnsignedInt index_j = this->neighbor_index_[n];
+        is_near_previous_surface = is_near_previous_surface || previous_surface_indicator_[index_j] == 1;
+        if (this->pos_div_[index_j] < threshold)
+        {
+            Vecd vec_r_ij = this->vec_r_ij(index_i, index_j);
+            Real r_ij = vec_r_ij.norm();
+            is_very_near_surface = is_very_near_surface || r_ij < this->smoothing_length_;
+            is_near_truncated_support = true;
+
+            // divergence of the normals of the particles with truncated kernel support
+            Real dW_ijV_j = this->dW_ij(index_i, index_j) * this->Vol_[index_j];
+            normal_divergence += dW_ijV_j * (unitNormal(index_j) - normal_i).dot(this->e_ij(index_i, index_j));
+            truncated_pos_div -= dW_ijV_j * r_ij;
+        }
+    }
+
+    // isolated particles, i.e. with neither surface nor previous surface neighbors, are not identified as surface ones
+    if (this->pos_div_[index_i] < threshold && !is_very_near_surface && !is_near_previous_surface)
+        this->pos_div_[index_i] = 2.0 * threshold;
+    is_near_truncated_support = is_near_truncated_support || this->pos_div_[index_i] < threshold;
+
+    int indicator = 1;
+    if (this->pos_div_[index_i] > threshold && !is_very_near_surface)
+        indicator = 0;
+    indicator_[index_i] = indicator;
+    previous_surface_indicator_[index_i] = indicator;
+
+    surface_normal_[index_i] = indicator == 1 ? normal_i : Vecd::Zero();
+    curvature_[index_i] = indicator == 1 ? Real(Dimensions) * normal_divergence / (truncated_pos_div + TinyReal) : 0.0;
+
+    // the smeared surface layer is only renewed by full evaluations
+    if (is_full_evaluation)
+        this->smeared_surface_[index_i] = indicator == 1 || is_near_truncated_support;
+}
+//=================================================================================================//
+template <typename... Parameters>
+FreeSurfaceStateCK<Contact<Parameters...>>::
+    FreeSurfaceStateCK(Relation<Contact<Parameters...>> &contact_relation)
+    : FreeSurfaceStateCK<Base, Contact<Parameters...>>(contact_relation)
+{
+    for (size_t k = 0; k != this->contact_particles_.size(); ++k)
+    {
+        dv_contact_Vol_.push_back(
+            this->contact_particles_[k]->template getVariableByName<Real>("VolumetricMeasure"));
+    }
+}
+//=================================================================================================//
+template <typename... Parameters>
+template <class ExecutionPolicy>
+FreeSurfaceStateCK<Contact<Parameters...>>::InteractKernel::
+    InteractKernel(const ExecutionPolicy &ex_policy,
+                   FreeSurfaceStateCK<Contact<Parameters...>> &encloser,
+                   size_t contact_index)
+    : FreeSurfaceStateCK<Base, Contact<Parameters...>>::InteractKernel(ex_policy, encloser, contact_index),
+      contact_Vol_(encloser.dv_contact_Vol_[contact_index]->DelegatedData(ex_policy)) {}
+//=================================================================================================//
+template <typename... Parameters>
+void FreeSurfaceStateCK<Contact<Parameters...>>::InteractKernel::interact(size_t index_i, Real dt)
+{
+    if (!this->isEvaluated(index_i))
+        return;
+
+    Real pos_div = 0.0;
+    Vecd color_gradient = Vecd::Zero();
+    for (UnsignedInt n = this->FirstNeighbor(index_i); n != this->LastNeighbor(index_i); ++n)
+    {
+        UnsignedInt index_j = this->neighbor_index_[n];
+        Real dW_ijV_j = this->dW_ij(index_i, index_j) * contact_Vol_[index_j];
+        pos_div -= dW_ijV_j * this->vec_r_ij(index_i, index_j).norm();
+        color_gradient -= dW_ijV_j * this->e_ij(index_i, index_j);
+    }
+    this->pos_div_[index_i] += pos_div;
+    this->color_gradient_[index_i] += color_gradient;
+}
+//=================================================================================================//
+template <class ExecutionPolicy, class EncloserType>
+SurfaceEvaluationDisplacementCK::ReduceKernel::
+    ReduceKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser)
+    : pos_(encloser.dv_pos_->DelegatedData(ex_policy)),
+      evaluation_pos_(encloser.dv_evaluation_pos_->DelegatedData(ex_policy)) {}
+//=================================================================================================//
+template <class ExecutionPolicy, typename... InteractionTypes>
+template <class InnerRelationType, typename... ContactRelationTypes>
+CachedFreeSurfaceStateCK<ExecutionPolicy, InteractionTypes...>::
+    CachedFreeSurfaceStateCK(InnerRelationType &inner_relation, ContactRelationTypes &...contact_relations)
+    : BaseDynamics<void>(),
+      free_surface_state_(inner_relation, contact_relations...),
+      evaluation_displacement_(inner_relation.getSPHBody()),
+      sv_full_evaluation_(inner_relation.getSPHBody().getBaseParticles()
+                              .template getSingularVariableByName<UnsignedInt>("FullSurfaceEvaluation")),
+      skin_distance_(0.25 * inner_relation.getSPHBody().getSPHAdaptation().ReferenceSmoothingLength()),
+      is_evaluated_(false), number_of_full_evaluations_(0) {}
+//=================================================================================================//
+template <class ExecutionPolicy, typename... InteractionTypes>
+void CachedFreeSurfaceStateCK<ExecutionPolicy, InteractionTypes...>::exec(Real dt)
+{
+    bool is_full_evaluation = !is_evaluated_ || evaluation_displacement_.exec() > skin_distance_;
+    sv_full_evaluation_->setValue(is_full_evaluation ? 1 : 0);
+    free_surface_state_.exec(dt);
+
+    is_evaluated_ = true;
+    if (is_full_evaluation)
+        number_of_full_evaluations_++;
+}
+//=================================================================================================//
+template <class ExecutionPolicy, class EncloserType>
+FreeSurfaceTensionForceCK::UpdateKernel::
+    UpdateKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser)
+    : ForcePriorCK::UpdateKernel(ex_policy, encloser),
+      surface_tension_coeff_(encloser.surface_tension_coeff_),
+      Vol_(encloser.dv_Vol_->DelegatedData(ex_policy)),
+      curvature_(encloser.dv_curvature_->DelegatedData(ex_policy)),
+      color_gradient_(encloser.dv_color_gradient_->DelegatedData(ex_policy)) {}
+//=================================================================================================//
+} // namespace fluid_dynamics
+} // namespace SPH
+#endif // FREE_SURFACE_STATE_CK_HPP
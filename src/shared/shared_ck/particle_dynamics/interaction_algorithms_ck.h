@@ -98,6 +98,10 @@ class InteractionDynamicsCK<ExecutionPolicy, Base, InteractionType<Inner<Paramet
     using LocalDynamicsType = InteractionType<Inner<Parameters...>>;
     using Identifier = typename LocalDynamicsType::Identifier;
     using InteractKernel = typename LocalDynamicsType::InteractKernel;
+    static_assert(!std::is_base_of<Neighbor<Anisotropic>, InteractKernel>::value ||
+                      is_anisotropy_aware<InteractKernel>::value,
+                  "InteractionDynamicsCK: the interaction kernel assumes a unit e_ij, "
+                  "not for an anisotropic neighborhood.");
     using KernelImplementation = Implementation<ExecutionPolicy, LocalDynamicsType, InteractKernel>;
     KernelImplementation kernel_implementation_;
 
@@ -117,6 +121,10 @@ class InteractionDynamicsCK<ExecutionPolicy, Base, InteractionType<Contact<Param
     using LocalDynamicsType = InteractionType<Contact<Parameters...>>;
     using Identifier = typename LocalDynamicsType::Identifier;
     using InteractKernel = typename LocalDynamicsType::InteractKernel;
+    static_assert(!std::is_base_of<Neighbor<Anisotropic>, InteractKernel>::value ||
+                      is_anisotropy_aware<InteractKernel>::value,
+                  "InteractionDynamicsCK: the interaction kernel assumes a unit e_ij, "
+                  "not for an anisotropic neighborhood.");
     using KernelImplementation = Implementation<ExecutionPolicy, LocalDynamicsType, InteractKernel>;
     UniquePtrsKeeper<KernelImplementation> contact_kernel_implementation_ptrs_;
     StdVec<KernelImplementation *> contact_kernel_implementation_;
@@ -0,0 +1,263 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	relax_stepping_ck.h
+ * @brief 	Particle relaxation with computing kernels.
+ * @details	A relaxation step has two particle loops only.
+ *			The first computes the zero-order residue, including the level-set correction,
+ *			and reduces its maximum in the same loop.
+ *			The second updates the particle positions by the scaled residue
+ *			and applies the level-set bounding to the updated positions.
+ *			The level-set shape is probed on host, therefore only host execution
+ *			policies are supported.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef RELAX_STEPPING_CK_H
+#define RELAX_STEPPING_CK_H
+
+#include "base_relax_dynamics.h"
+#include "interaction_ck.hpp"
+#include "level_set_shape.h"
+#include "update_body_relation.hpp"
+#include "update_cell_linked_list.hpp"
+
+namespace SPH
+{
+namespace relax_dynamics
+{
+template <typename... RelationTypes>
+class RelaxationResidueCK;
+
+template <typename... Parameters>
+class RelaxationResidueCK<Inner<Parameters...>> : public Interaction<Inner<Parameters...>>
+{
+    using BaseInteraction = Interaction<Inner<Parameters...>>;
+
+  public:
+    explicit RelaxationResidueCK(Relation<Inner<Parameters...>> &inner_relation);
+    virtual ~RelaxationResidueCK() {};
+    Shape &getRelaxShape() { return relax_shape_; };
+
+    class ReduceKernel : public BaseInteraction::InteractKernel
+    {
+      public:
+        template <class ExecutionPolicy, class EncloserType>
+        ReduceKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser);
+        Real reduce(size_t index_i, Real dt = 0.0)
+        {
+            residue_[index_i] = computeResidue(index_i);
+            return residue_[index_i].norm();
+        };
+
+      protected:
+        Real *Vol_;
+        Vecd *residue_;
+
+        Vecd computeResidue(size_t index_i)
+        {
+            Vecd residue = Vecd::Zero();
+            for (UnsignedInt n = this->FirstNeighbor(index_i); n != this->LastNeighbor(index_i); ++n)
+            {
+                UnsignedInt index_j = this->neighbor_index_[n];
+                residue -= 2.0 * this->dW_ij(index_i, index_j) * Vol_[index_j] * this->e_ij(index_i, index_j);
+            }
+            return residue;
+        };
+    };
+
+  protected:
+    Shape &relax_shape_;
+    DiscreteVariable<Real> *dv_Vol_;
+    DiscreteVariable<Vecd> *dv_residue_;
+};
+
+template <typename... Parameters>
+class RelaxationResidueCK<Inner<LevelSetCorrection, Parameters...>>
+    : public RelaxationResidueCK<Inner<Parameters...>>
+{
+    using BaseReduceKernel = typename RelaxationResidueCK<Inner<Parameters...>>::ReduceKernel;
+
+  public:
+    explicit RelaxationResidueCK(Relation<Inner<Parameters...>> &inner_relation);
+    virtual ~RelaxationResidueCK() {};
+
+    class ReduceKernel : public BaseReduceKernel
+    {
+      public:
+        template <class ExecutionPolicy>
+        ReduceKernel(const ExecutionPolicy &ex_policy,
+                     RelaxationResidueCK<Inner<LevelSetCorrection, Parameters...>> &encloser);
+        Real reduce(size_t index_i, Real dt = 0.0)
+        {
+            this->residue_[index_i] =
+                this->computeResidue(index_i) -
+                2.0 * level_set_shape_->computeKernelGradientIntegral(
+                          pos_[index_i], sph_adaptation_->SmoothingLengthRatio(index_i));
+            return this->residue_[index_i].norm();
+        };
+
+      protected:
+        Vecd *pos_;
+        SPHAdaptation *sph_adaptation_;
+        LevelSetShape *level_set_shape_;
+    };
+
+  protected:
+    DiscreteVariable<Vecd> *dv_pos_;
+    LevelSetShape &level_set_shape_;
+};
+
+/**
+ * @class ShapeSurfaceBoundingCK
+ * @brief Map the particles close to or outside of the shape surface to
+ * a constrained distance inside, r = r - (phi + constrained_distance) * normal.
+ */
+class ShapeSurfaceBoundingCK
+{
+  public:
+    ShapeSurfaceBoundingCK(SPHBody &sph_body, LevelSetShape &level_set_shape)
+        : level_set_shape_(&level_set_shape),
+          constrained_distance_(0.5 * sph_body.getSPHAdaptation().MinimumSpacing()) {};
+
+    class ComputingKernel
+    {
+      public:
+        template <class ExecutionPolicy>
+        ComputingKernel(const ExecutionPolicy &ex_policy, ShapeSurfaceBoundingCK &encloser)
+            : level_set_shape_(encloser.level_set_shape_),
+              constrained_distance_(encloser.constrained_distance_) {};
+
+        void operator()(Vecd &position)
+        {
+            Real phi = level_set_shape_->findSignedDistance(position);
+            if (phi > -constrained_distance_)
+            {
+                position -= (phi + constrained_distance_) * level_set_shape_->findNormalDirection(position);
+            }
+        };
+
+      protected:
+        LevelSetShape *level_set_shape_;
+        Real constrained_distance_;
+    };
+
+  protected:
+    LevelSetShape *level_set_shape_;
+    Real constrained_distance_;
+};
+
+/**
+ * @class ShellMidSurfaceBoundingCK
+ * @brief Constrain the particles of a thick shell towards the mid-surface.
+ */
+class ShellMidSurfaceBoundingCK : public ShapeSurfaceBoundingCK
+{
+  public:
+    ShellMidSurfaceBoundingCK(SPHBody &sph_body, LevelSetShape &level_set_shape)
+        : ShapeSurfaceBoundingCK(sph_body, level_set_shape) {};
+
+    class ComputingKernel : public ShapeSurfaceBoundingCK::ComputingKernel
+    {
+      public:
+        template <class ExecutionPolicy>
+        ComputingKernel(const ExecutionPolicy &ex_policy, ShellMidSurfaceBoundingCK &encloser)
+            : ShapeSurfaceBoundingCK::ComputingKernel(ex_policy, encloser) {};
+
+        void operator()(Vecd &position)
+        {
+            Real factor = 0.2 * level_set_shape_->findLevelSetGradient(position).norm();
+            position -= factor * constrained_distance_ * level_set_shape_->findNormalDirection(position);
+        };
+    };
+};
+
+template <class SurfaceBoundingType>
+class PositionRelaxationCK : public LocalDynamics
+{
+  public:
+    PositionRelaxationCK(SPHBody &sph_body, LevelSetShape &level_set_shape);
+    virtual ~PositionRelaxationCK() {};
+
+    class UpdateKernel
+    {
+      public:
+        template <class ExecutionPolicy>
+        UpdateKernel(const ExecutionPolicy &ex_policy, PositionRelaxationCK<SurfaceBoundingType> &encloser);
+        void update(size_t index_i, Real scaling)
+        {
+            pos_[index_i] += residue_[index_i] * scaling * 0.5 / sph_adaptation_->SmoothingLengthRatio(index_i);
+        };
+        /** Only applied to the particles near the shape surface, as the classic relaxation step. */
+        void bound(size_t index_i) { surface_bounding_(pos_[index_i]); };
+
+      protected:
+        SPHAdaptation *sph_adaptation_;
+        Vecd *pos_, *residue_;
+        typename SurfaceBoundingType::ComputingKernel surface_bounding_;
+    };
+
+  protected:
+    SPHAdaptation *sph_adaptation_;
+    DiscreteVariable<Vecd> *dv_pos_, *dv_residue_;
+    SurfaceBoundingType surface_bounding_;
+};
+
+template <class ExecutionPolicy, class RelaxationResidueType, class SurfaceBoundingType = ShapeSurfaceBoundingCK>
+class RelaxationStepCK : public BaseDynamics<void>
+{
+    using ReduceKernel = typename RelaxationResidueType::ReduceKernel;
+    using PositionRelaxationType = PositionRelaxationCK<SurfaceBoundingType>;
+    using UpdateKernel = typename PositionRelaxationType::UpdateKernel;
+
+  public:
+    explicit RelaxationStepCK(Relation<Inner<>> &inner_relation);
+    virtual ~RelaxationStepCK() {};
+    virtual void exec(Real dt = 0.0) override;
+    /** The maximum residue of the last step, available for monitoring the convergence. */
+    Real MaxResidue() { return max_residue_; };
+
+  protected:
+    RealBody &real_body_;
+    NearShapeSurface near_shape_surface_;
+    UpdateCellLinkedList<ExecutionPolicy, CellLinkedList> update_cell_linked_list_;
+    UpdateRelation<ExecutionPolicy, Inner<>> update_inner_relation_;
+    RelaxationResidueType relaxation_residue_;
+    PositionRelaxationType position_relaxation_;
+    Implementation<ExecutionPolicy, RelaxationResidueType, ReduceKernel> residue_implementation_;
+    Implementation<ExecutionPolicy, PositionRelaxationType, UpdateKernel> position_relaxation_implementation_;
+    Real h_ref_;
+    Real max_residue_;
+};
+
+template <class ExecutionPolicy>
+using RelaxationStepInnerCK = RelaxationStepCK<ExecutionPolicy, RelaxationResidueCK<Inner<>>>;
+template <class ExecutionPolicy>
+using RelaxationStepLevelSetCorrectionInnerCK =
+    RelaxationStepCK<ExecutionPolicy, RelaxationResidueCK<Inner<LevelSetCorrection>>>;
+template <class ExecutionPolicy>
+using ShellRelaxationStepCK =
+    RelaxationStepCK<ExecutionPolicy, RelaxationResidueCK<Inner<>>, ShellMidSurfaceBoundingCK>;
+} // namespace relax_dynamics
+} // namespace SPH
+#endif // RELAX_STEPPING_CK_H
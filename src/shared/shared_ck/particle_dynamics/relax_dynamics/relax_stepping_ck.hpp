@@ -0,0 +1,106 @@
+#ifndef RELAX_STEPPING_CK_HPP
+#define RELAX_STEPPING_CK_HPP
+
+#include "relax_stepping_ck.h"
+
+#include "particle_iterators_ck.h"
+
+namespace SPH
+{
+namespace relax_dynamics
+{
+//=================================================================================================//
+template <typename... Parameters>
+RelaxationResidueCK<Inner<Parameters...>>::
+    RelaxationResidueCK(Relation<Inner<Parameters...>> &inner_relation)
+    : Interaction<Inner<Parameters...>>(inner_relation),
+      relax_shape_(this->sph_body_.getInitialShape()),
+      dv_Vol_(this->particles_->template getVariableByName<Real>("VolumetricMeasure")),
+      dv_residue_(this->particles_->template registerStateVariableOnly<Vecd>("ZeroOrderResidue")) {}
+//=================================================================================================//
+template <typename... Parameters>
+template <class ExecutionPolicy, class EncloserType>
+RelaxationResidueCK<Inner<Parameters...>>::ReduceKernel::
+    ReduceKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser)
+    : BaseInteraction::InteractKernel(ex_policy, encloser),
+      Vol_(encloser.dv_Vol_->DelegatedData(ex_policy)),
+      residue_(encloser.dv_residue_->DelegatedData(ex_policy)) {}
+//=================================================================================================//
+template <typename... Parameters>
+RelaxationResidueCK<Inner<LevelSetCorrection, Parameters...>>::
+    RelaxationResidueCK(Relation<Inner<Parameters...>> &inner_relation)
+    : RelaxationResidueCK<Inner<Parameters...>>(inner_relation),
+      dv_pos_(this->particles_->template getVariableByName<Vecd>("Position")),
+      level_set_shape_(DynamicCast<LevelSetShape>(this, this->getRelaxShape())) {}
+//=================================================================================================//
+template <typename... Parameters>
+template <class ExecutionPolicy>
+RelaxationResidueCK<Inner<LevelSetCorrection, Parameters...>>::ReduceKernel::
+    ReduceKernel(const ExecutionPolicy &ex_policy,
+                 RelaxationResidueCK<Inner<LevelSetCorrection, Parameters...>> &encloser)
+    : BaseReduceKernel(ex_policy, encloser),
+      pos_(encloser.dv_pos_->DelegatedData(ex_policy)),
+      sph_adaptation_(encloser.sph_adaptation_),
+      level_set_shape_(&encloser.level_set_shape_) {}
+//=================================================================================================//
+template <class SurfaceBoundingType>
+PositionRelaxationCK<SurfaceBoundingType>::
+    PositionRelaxationCK(SPHBody &sph_body, LevelSetShape &level_set_shape)
+    : LocalDynamics(sph_body), sph_adaptation_(&sph_body.getSPHAdaptation()),
+      dv_pos_(particles_->getVariableByName<Vecd>("Position")),
+      dv_residue_(particles_->getVariableByName<Vecd>("ZeroOrderResidue")),
+      surface_bounding_(sph_body, level_set_shape) {}
+//=================================================================================================//
+template <class SurfaceBoundingType>
+template <class ExecutionPolicy>
+PositionRelaxationCK<SurfaceBoundingType>::UpdateKernel::
+    UpdateKernel(const ExecutionPolicy &ex_policy, PositionRelaxationCK<SurfaceBoundingType> &encloser)
+    : sph_adaptation_(encloser.sph_adaptation_),
+      pos_(encloser.dv_pos_->DelegatedData(ex_policy)),
+      residue_(encloser.dv_residue_->DelegatedData(ex_policy)),
+      surface_bounding_(ex_policy, encloser.surface_bounding_) {}
+//=================================================================================================//
+template <class ExecutionPolicy, class RelaxationResidueType, class SurfaceBoundingType>
+RelaxationStepCK<ExecutionPolicy, RelaxationResidueType, SurfaceBoundingType>::
+    RelaxationStepCK(Relation<Inner<>> &inner_relation)
+    : BaseDynamics<void>(),
+      real_body_(inner_relation.getRealBody()),
+      near_shape_surface_(real_body_),
+      update_cell_linked_list_(real_body_),
+      update_inner_relation_(inner_relation),
+      relaxation_residue_(inner_relation),
+      position_relaxation_(real_body_,
+                           DynamicCast<LevelSetShape>(this, relaxation_residue_.getRelaxShape())),
+      residue_implementation_(relaxation_residue_),
+      position_relaxation_implementation_(position_relaxation_),
+      h_ref_(real_body_.getSPHAdaptation().ReferenceSmoothingLength()),
+      max_residue_(MaxReal)
+{
+    relaxation_residue_.registerComputingKernel(&residue_implementation_);
+}
+//=================================================================================================//
+template <class ExecutionPolicy, class RelaxationResidueType, class SurfaceBoundingType>
+void RelaxationStepCK<ExecutionPolicy, RelaxationResidueType, SurfaceBoundingType>::exec(Real dt)
+{
+    update_cell_linked_list_.exec();
+    update_inner_relation_.exec();
+
+    ReduceKernel *reduce_kernel = residue_implementation_.getComputingKernel();
+    max_residue_ = particle_reduce<ReduceMax>(
+        LoopRangeCK<ExecutionPolicy, SPHBody>(real_body_), Real(0),
+        [=](size_t i)
+        { return reduce_kernel->reduce(i); });
+
+    Real scaling = 0.0625 * h_ref_ / (max_residue_ + TinyReal);
+    UpdateKernel *update_kernel = position_relaxation_implementation_.getComputingKernel();
+    particle_for(LoopRangeCK<ExecutionPolicy, SPHBody>(real_body_),
+                 [=](size_t i)
+                 { update_kernel->update(i, scaling); });
+    particle_for(LoopRangeCK<ExecutionPolicy, BodyPartByCell>(near_shape_surface_),
+                 [=](size_t i)
+                 { update_kernel->bound(i); });
+}
+//=================================================================================================//
+} // namespace relax_dynamics
+} // namespace SPH
+#endif // RELAX_STEPPING_CK_HPP
@@ -89,6 +89,9 @@ class ReduceDynamicsCK : public ReduceType,
           finish_dynamics_(*this){};
     virtual ~ReduceDynamicsCK() {};
     std::string QuantityName() { return this->quantity_name_; };
+    auto &getDynamicsIdentifier() { return this->identifier_; };
+    ReduceKernel *getReduceKernel() { return kernel_implementation_.getComputingKernel(); };
+    OutputType finishResult(const ReduceReturnType &reduced_value) { return finish_dynamics_.Result(reduced_value); };
 
     virtual OutputType exec(Real dt = 0.0) override
     {
@@ -102,5 +105,64 @@ class ReduceDynamicsCK : public ReduceType,
         return finish_dynamics_.Result(temp);
     };
 };
+
+/**
+ * @class ReduceDynamicsGroupCK
+ * @brief Evaluates several reduce dynamics on the same particles in one particle pass.
+ * The reduced values are combined as a tuple with heterogeneous operations,
+ * the finished results are returned in the order of the given dynamics,
+ * which remain usable separately.
+ */
+template <class ExecutionPolicy, class... ReduceTypes>
+class ReduceDynamicsGroupCK
+    : public BaseDynamics<std::tuple<typename ReduceTypes::FinishDynamics::OutputType...>>
+{
+    using Identifier = typename std::tuple_element_t<0, std::tuple<ReduceTypes...>>::Identifier;
+    using ReduceReturnType = std::tuple<typename ReduceTypes::ReturnType...>;
+    using Operation = ReduceTuple<typename ReduceTypes::OperationType...>;
+    using OutputType = std::tuple<typename ReduceTypes::FinishDynamics::OutputType...>;
+    std::tuple<ReduceDynamicsCK<ExecutionPolicy, ReduceTypes> &...> reduce_dynamics_;
+
+  public:
+    explicit ReduceDynamicsGroupCK(ReduceDynamicsCK<ExecutionPolicy, ReduceTypes> &...reduce_dynamics)
+        : BaseDynamics<OutputType>(), reduce_dynamics_(reduce_dynamics...)
+    {
+        static_assert((std::is_same_v<Identifier, typename ReduceTypes::Identifier> && ...),
+                      "The grouped reduce dynamics should have the same identifier type!");
+        std::apply(
+            [](auto &first, auto &...others)
+            {
+                if (((static_cast<void *>(&others.getDynamicsIdentifier()) !=
+                      static_cast<void *>(&first.getDynamicsIdentifier())) ||
+                     ...))
+                {
+                    std::cout << "\n Error: the grouped reduce dynamics are not on the same particles!" << std::endl;
+                    std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+                    exit(1);
+                }
+            },
+            reduce_dynamics_);
+    };
+    virtual ~ReduceDynamicsGroupCK() {};
+
+    virtual OutputType exec(Real dt = 0.0) override
+    {
+        return execGroup(dt, std::index_sequence_for<ReduceTypes...>{});
+    };
+
+  protected:
+    template <size_t... Is>
+    OutputType execGroup(Real dt, std::index_sequence<Is...>)
+    {
+        (std::get<Is>(reduce_dynamics_).setupDynamics(dt), ...);
+        auto reduce_kernels = std::make_tuple(std::get<Is>(reduce_dynamics_).getReduceKernel()...);
+        ReduceReturnType temp = particle_reduce<Operation>(
+            LoopRangeCK<ExecutionPolicy, Identifier>(std::get<0>(reduce_dynamics_).getDynamicsIdentifier()),
+            ReduceReturnType(std::get<Is>(reduce_dynamics_).Reference()...),
+            [=](size_t i)
+            { return ReduceReturnType(std::get<Is>(reduce_kernels)->reduce(i, dt)...); });
+        return OutputType(std::get<Is>(reduce_dynamics_).finishResult(std::get<Is>(temp))...);
+    };
+};
 } // namespace SPH
 #endif // SIMPLE_ALGORITHMS_CK_H
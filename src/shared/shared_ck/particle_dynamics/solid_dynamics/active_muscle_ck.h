@@ -0,0 +1,81 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	active_muscle_ck.h
+ * @brief 	Muscle activation updating the active contraction stress.
+ * @details The activation and the active contraction stress are updated in one pass
+ *			with the activation model given as template parameter,
+ *			which is copied into the computing kernel and so without virtual calls.
+ *			The activation model provides
+ *			Real Activation(const Vecd &initial_position, Real physical_time) and
+ *			Real ContractionStressRate(Real activation, Real active_contraction_stress, Real physical_time).
+ *			The active contraction stress is then used by the material ActiveMuscle.
+ * @author	Chi Zhang and Xiangyu Hu
+ */
+
+#ifndef ACTIVE_MUSCLE_CK_H
+#define ACTIVE_MUSCLE_CK_H
+
+#include "base_general_dynamics.h"
+
+namespace SPH
+{
+namespace solid_dynamics
+{
+template <class ActivationModel>
+class MuscleActivationCK : public LocalDynamics
+{
+  public:
+    MuscleActivationCK(SPHBody &sph_body, const ActivationModel &activation_model);
+    virtual ~MuscleActivationCK() {};
+
+    class UpdateKernel
+    {
+      public:
+        template <class ExecutionPolicy, class EncloserType>
+        UpdateKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser);
+        void update(size_t index_i, Real dt = 0.0)
+        {
+            Real activation = activation_model_.Activation(pos0_[index_i], *physical_time_);
+            active_contraction_stress_[index_i] +=
+                activation_model_.ContractionStressRate(
+                    activation, active_contraction_stress_[index_i], *physical_time_) *
+                dt;
+        };
+
+      protected:
+        ActivationModel activation_model_;
+        Real *physical_time_;
+        Vecd *pos0_;
+        Real *active_contraction_stress_;
+    };
+
+  protected:
+    const ActivationModel activation_model_;
+    SingularVariable<Real> *sv_physical_time_;
+    DiscreteVariable<Vecd> *dv_pos0_;
+    DiscreteVariable<Real> *dv_active_contraction_stress_;
+};
+} // namespace solid_dynamics
+} // namespace SPH
+#endif // ACTIVE_MUSCLE_CK_H
@@ -0,0 +1,30 @@
+#ifndef ACTIVE_MUSCLE_CK_HPP
+#define ACTIVE_MUSCLE_CK_HPP
+
+#include "active_muscle_ck.h"
+
+namespace SPH
+{
+namespace solid_dynamics
+{
+//=================================================================================================//
+template <class ActivationModel>
+MuscleActivationCK<ActivationModel>::
+    MuscleActivationCK(SPHBody &sph_body, const ActivationModel &activation_model)
+    : LocalDynamics(sph_body), activation_model_(activation_model),
+      sv_physical_time_(sph_system_.getSystemVariableByName<Real>("PhysicalTime")),
+      dv_pos0_(particles_->registerStateVariableOnlyFrom<Vecd>("InitialPosition", "Position")),
+      dv_active_contraction_stress_(particles_->registerStateVariableOnly<Real>("ActiveContractionStress")) {}
+//=================================================================================================//
+template <class ActivationModel>
+template <class ExecutionPolicy, class EncloserType>
+MuscleActivationCK<ActivationModel>::UpdateKernel::
+    UpdateKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser)
+    : activation_model_(encloser.activation_model_),
+      physical_time_(encloser.sv_physical_time_->DelegatedData(ex_policy)),
+      pos0_(encloser.dv_pos0_->DelegatedData(ex_policy)),
+      active_contraction_stress_(encloser.dv_active_contraction_stress_->DelegatedData(ex_policy)) {}
+//=================================================================================================//
+} // namespace solid_dynamics
+} // namespace SPH
+#endif // ACTIVE_MUSCLE_CK_HPP
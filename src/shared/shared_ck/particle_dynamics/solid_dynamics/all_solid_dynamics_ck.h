@@ -26,5 +26,6 @@
 
 #pragma once
 
+#include "active_muscle_ck.hpp"
 #include "derived_solid_state.h"
 #include "solid_constraint.hpp"
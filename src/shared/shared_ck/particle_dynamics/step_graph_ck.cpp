@@ -0,0 +1,184 @@
+#include "step_graph_ck.h"
+
+namespace SPH
+{
+//=================================================================================================//
+StepNode &StepNode::reads(Entity *variable)
+{
+    read_variables_.push_back(variable);
+    return *this;
+}
+//=================================================================================================//
+StepNode &StepNode::writes(Entity *variable)
+{
+    write_variables_.push_back(variable);
+    return *this;
+}
+//=================================================================================================//
+void StepNode::runAndRecord()
+{
+    StdVec<Entity *> recorded_variables;
+    VariableAccessRecorder::startRecording(&recorded_variables);
+    task_();
+    VariableAccessRecorder::stopRecording();
+
+    for (Entity *variable : recorded_variables)
+    {
+        if (std::find(read_variables_.begin(), read_variables_.end(), variable) == read_variables_.end() &&
+            std::find(write_variables_.begin(), write_variables_.end(), variable) == write_variables_.end())
+        {
+            write_variables_.push_back(variable);
+        }
+    }
+}
+//=================================================================================================//
+bool StepNode::dependsOn(const StepNode &earlier_node) const
+{
+    if (isBarrier() || earlier_node.isBarrier())
+        return true;
+
+    auto is_in = [](Entity *variable, const StdVec<Entity *> &variables) -> bool
+    { return std::find(variables.begin(), variables.end(), variable) != variables.end(); };
+
+    for (Entity *variable : earlier_node.write_variables_)
+    {
+        if (is_in(variable, read_variables_) || is_in(variable, write_variables_))
+            return true; // read after write or write after write
+    }
+
+    for (Entity *variable : earlier_node.read_variables_)
+    {
+        if (is_in(variable, write_variables_))
+            return true; // write after read
+    }
+    return false;
+}
+//=================================================================================================//
+StepNode &StepGraph::addNode(const std::string &name, const std::function<void()> &task)
+{
+    if (is_built_)
+    {
+        std::cout << "\n Error: the step graph has been built, node '" << name << "' can not be added!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    StepNode *step_node = step_node_ptrs_.createPtr<StepNode>(name, task);
+    step_nodes_.push_back(step_node);
+    return *step_node;
+}
+//=================================================================================================//
+StepNode &StepGraph::addNode(const std::string &name, BaseDynamics<void> &dynamics)
+{
+    return addNode(name, [&]()
+                   { dynamics.exec(); });
+}
+//=================================================================================================//
+StepNode &StepGraph::addNode(const std::string &name, BaseDynamics<void> &dynamics, const Real &dt)
+{
+    return addNode(name, [&]()
+                   { dynamics.exec(dt); });
+}
+//=================================================================================================//
+void StepGraph::inferDependencies()
+{
+    size_t number_of_nodes = step_nodes_.size();
+    predecessors_.assign(number_of_nodes, StdVec<size_t>());
+    node_levels_.assign(number_of_nodes, 0);
+    for (size_t j = 0; j != number_of_nodes; ++j)
+    {
+        for (size_t i = 0; i != j; ++i)
+        {
+            if (step_nodes_[j]->dependsOn(*step_nodes_[i]))
+            {
+                predecessors_[j].push_back(i);
+                node_levels_[j] = SMAX(node_levels_[j], node_levels_[i] + 1);
+            }
+        }
+    }
+}
+//=================================================================================================//
+void StepGraph::connectFlowNodes()
+{
+    for (size_t k = 0; k != step_nodes_.size(); ++k)
+    {
+        StepNode *step_node = step_nodes_[k];
+        FlowNode *flow_node = flow_node_ptrs_.createPtr<FlowNode>(
+            flow_graph_, [=](const tbb::flow::continue_msg &)
+            { step_node->run(); });
+        flow_nodes_.push_back(flow_node);
+    }
+
+    for (size_t j = 0; j != step_nodes_.size(); ++j)
+    {
+        if (predecessors_[j].empty())
+        {
+            tbb::flow::make_edge(start_node_, *flow_nodes_[j]);
+        }
+
+        for (size_t i : predecessors_[j])
+        {
+            // edges implied by a chain of other dependencies are redundant
+            bool is_implied = false;
+            for (size_t k : predecessors_[j])
+            {
+                if (std::find(predecessors_[k].begin(), predecessors_[k].end(), i) != predecessors_[k].end())
+                {
+                    is_implied = true;
+                    break;
+                }
+            }
+
+            if (!is_implied)
+            {
+                tbb::flow::make_edge(*flow_nodes_[i], *flow_nodes_[j]);
+            }
+        }
+    }
+}
+//=================================================================================================//
+void StepGraph::build()
+{
+    if (!is_built_)
+    {
+        inferDependencies();
+        connectFlowNodes();
+        is_built_ = true;
+    }
+}
+//=================================================================================================//
+size_t StepGraph::NumberOfLevels()
+{
+    if (!is_built_)
+    {
+        std::cout << "\n Error: the step graph is built at its first execution!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    return node_levels_.empty() ? 0 : *std::max_element(node_levels_.begin(), node_levels_.end()) + 1;
+}
+//=================================================================================================//
+void StepGraph::exec()
+{
+    if (!is_built_)
+    {
+        for (StepNode *step_node : step_nodes_)
+        {
+            step_node->runAndRecord();
+        }
+        build();
+        return;
+    }
+
+    start_node_.try_put(tbb::flow::continue_msg());
+    flow_graph_.wait_for_all();
+}
+//=================================================================================================//
+void StepGraph::execSequentially()
+{
+    for (StepNode *step_node : step_nodes_)
+    {
+        step_node->run();
+    }
+}
+//=================================================================================================//
+} // namespace SPH
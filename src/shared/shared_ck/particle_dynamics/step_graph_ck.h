@@ -0,0 +1,130 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	step_graph_ck.h
+ * @brief 	Dependency-graph execution of particle dynamics within a time step.
+ * @details	Each node of the graph wraps a dynamics call. At the first execution,
+ *			the nodes are run sequentially in insertion order and the discrete (or singular)
+ *			variables delegated to their computing kernels are recorded.
+ *			A recorded variable is taken as written unless it is declared as read-only.
+ *			Variables can also be declared for nodes without computing kernels, e.g. lambdas.
+ *			The dependencies are inferred from the insertion order and
+ *			the read-after-write, write-after-read and write-after-write
+ *			conflicts on these variables. A node without any recorded or declared
+ *			variable is treated as a barrier. Independent nodes,
+ *			e.g. updates on different bodies, are run concurrently
+ *			by a TBB flow graph so that the implicit barrier after
+ *			each parallel loop is only imposed where it is required.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef STEP_GRAPH_CK_H
+#define STEP_GRAPH_CK_H
+
+#include "base_body.h"
+#include "base_particle_dynamics.h"
+#include "base_particles.hpp"
+
+#include "tbb/flow_graph.h"
+#include <functional>
+
+namespace SPH
+{
+class StepNode
+{
+  public:
+    StepNode(const std::string &name, const std::function<void()> &task)
+        : name_(name), task_(task){};
+    ~StepNode() {};
+    std::string Name() const { return name_; };
+    void run() { task_(); };
+
+    StepNode &reads(Entity *variable);
+    StepNode &writes(Entity *variable);
+
+    template <typename DataType>
+    StepNode &reads(SPHBody &sph_body, const std::string &name)
+    {
+        return reads(sph_body.getBaseParticles().getVariableByName<DataType>(name));
+    };
+
+    template <typename DataType>
+    StepNode &writes(SPHBody &sph_body, const std::string &name)
+    {
+        return writes(sph_body.getBaseParticles().getVariableByName<DataType>(name));
+    };
+
+    /** Runs the task and records the delegated variables. */
+    void runAndRecord();
+    bool isBarrier() const { return read_variables_.empty() && write_variables_.empty(); };
+    bool dependsOn(const StepNode &earlier_node) const;
+    StdVec<Entity *> &ReadVariables() { return read_variables_; };
+    StdVec<Entity *> &WriteVariables() { return write_variables_; };
+
+  protected:
+    std::string name_;
+    std::function<void()> task_;
+    StdVec<Entity *> read_variables_;
+    StdVec<Entity *> write_variables_;
+};
+
+class StepGraph
+{
+    using FlowNode = tbb::flow::continue_node<tbb::flow::continue_msg>;
+    UniquePtrsKeeper<StepNode> step_node_ptrs_;
+    UniquePtrsKeeper<FlowNode> flow_node_ptrs_;
+
+  public:
+    StepGraph() : is_built_(false), start_node_(flow_graph_){};
+    ~StepGraph() {};
+
+    StepNode &addNode(const std::string &name, const std::function<void()> &task);
+    StepNode &addNode(const std::string &name, BaseDynamics<void> &dynamics);
+    /** The time step is taken by reference and read at each execution. */
+    StepNode &addNode(const std::string &name, BaseDynamics<void> &dynamics, const Real &dt);
+
+    /** The first execution is sequential and records the variables for building the graph. */
+    void exec();
+    void execSequentially();
+    bool isBuilt() { return is_built_; };
+    size_t NumberOfNodes() { return step_nodes_.size(); };
+    /** Number of successive groups of independent nodes, i.e. barriers needed, after the first execution. */
+    size_t NumberOfLevels();
+    StdVec<size_t> &NodeLevels() { return node_levels_; };
+    StdVec<StdVec<size_t>> &Predecessors() { return predecessors_; };
+
+  protected:
+    bool is_built_;
+    StdVec<StepNode *> step_nodes_;
+    StdVec<StdVec<size_t>> predecessors_;
+    StdVec<size_t> node_levels_;
+    tbb::flow::graph flow_graph_;
+    tbb::flow::broadcast_node<tbb::flow::continue_msg> start_node_;
+    StdVec<FlowNode *> flow_nodes_;
+
+    void build();
+    void inferDependencies();
+    void connectFlowNodes();
+};
+} // namespace SPH
+#endif // STEP_GRAPH_CK_H
@@ -170,9 +170,9 @@ SPHSystem *SPHSystem::handleCommandlineOptions(int ac, char *av[])
 }
 #endif
 //=================================================================================================//
-SPHSystem *SPHSystem::setIOEnvironment(bool delete_output)
+SPHSystem *SPHSystem::setIOEnvironment(bool delete_output, const std::string &folder_suffix)
 {
-    io_environment_ = io_ptr_keeper_.createPtr<IOEnvironment>(*this, delete_output);
+    io_environment_ = io_ptr_keeper_.createPtr<IOEnvironment>(*this, delete_output, folder_suffix);
     return this;
 }
 //=================================================================================================//
@@ -61,7 +61,7 @@ class SPHSystem
 #ifdef BOOST_AVAILABLE
     SPHSystem *handleCommandlineOptions(int ac, char *av[]);
 #endif
-    SPHSystem *setIOEnvironment(bool delete_output = true);
+    SPHSystem *setIOEnvironment(bool delete_output = true, const std::string &folder_suffix = "");
     IOEnvironment &getIOEnvironment();
     void setRunParticleRelaxation(bool run_particle_relaxation) { run_particle_relaxation_ = run_particle_relaxation; };
     bool RunParticleRelaxation() { return run_particle_relaxation_; };
@@ -42,6 +42,16 @@ void DiscreteVariable<DataType>::synchronizeToDevice()
 }
 //=================================================================================================//
 template <typename DataType>
+void DiscreteVariable<DataType>::synchronizeToDevice(const ParallelDevicePolicy &par_device)
+{
+    if (isDataDelegated())
+    {
+        device_only_variable_->reallocateData(this);
+        synchronizeToDevice();
+    }
+}
+//=================================================================================================//
+template <typename DataType>
 DeviceOnlyDiscreteVariable<DataType>::
     DeviceOnlyDiscreteVariable(DiscreteVariable<DataType> *host_variable)
     : Entity(host_variable->Name()), device_only_data_field_(nullptr)
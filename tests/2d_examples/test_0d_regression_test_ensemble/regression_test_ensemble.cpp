@@ -0,0 +1,301 @@
+/**
+ * @file regression_test_ensemble.cpp
+ * @brief This is the diffusion case of test_0d_regression_test,
+ * in which the runs for generating the ensemble-averaged regression database are carried out
+ * as the replicas of an ensemble in the same process, instead of separate processes.
+ * The diffusion coefficients of the replicas are perturbed slightly as in a parameter sweep.
+ * The shapes are built only once and shared by the replicas,
+ * and the observations are handed to the regression test in memory.
+ * For comparison, the same replicas are also launched as sequential processes
+ * and the total wall times are given.
+ * @author 	Xiangyu Hu
+ */
+#include "sphinxsys.h" //SPHinXsys Library
+using namespace SPH;   // namespace cite here
+//----------------------------------------------------------------------
+//	Basic geometry parameters and simulation setup.
+//----------------------------------------------------------------------
+Real L = 0.2;
+Real H = 0.2;
+Real resolution_ref = H / 40.0;
+Real BW = resolution_ref * 4;
+BoundingBox system_domain_bounds(Vec2d(-BW, -BW), Vec2d(L + BW, H + BW));
+size_t number_of_replicas = 16;
+//----------------------------------------------------------------------
+//	Global parameters on material properties
+//----------------------------------------------------------------------
+std::string diffusion_species_name = "Phi";
+Real diffusion_coeff = 1.0e-3;
+Real perturbation = 0.01; // relative perturbation of the diffusion coefficient among the replicas
+Real bias_coeff = 0.0;
+Real alpha = Pi / 4.0;
+Vec2d bias_direction(cos(alpha), sin(alpha));
+Real initial_temperature = 0.0;
+Real high_temperature = 1.0;
+Real low_temperature = 0.0;
+//----------------------------------------------------------------------
+//	Cases-dependent 2D geometries
+//----------------------------------------------------------------------
+MultiPolygon createDiffusionDomain()
+{
+    // thermal solid domain geometry.
+    std::vector<Vecd> diffusion_domain;
+    diffusion_domain.push_back(Vecd(-BW, -BW));
+    diffusion_domain.push_back(Vecd(-BW, H + BW));
+    diffusion_domain.push_back(Vecd(L + BW, H + BW));
+    diffusion_domain.push_back(Vecd(L + BW, -BW));
+    diffusion_domain.push_back(Vecd(-BW, -BW));
+
+    MultiPolygon multi_polygon;
+    multi_polygon.addAPolygon(diffusion_domain, ShapeBooleanOps::add);
+    return multi_polygon;
+}
+
+MultiPolygon createLeftSideBoundary()
+{
+    // left isothermal boundary geometry.
+    std::vector<Vecd> left_boundary;
+    left_boundary.push_back(Vecd(-BW, -BW));
+    left_boundary.push_back(Vecd(-BW, H + BW));
+    left_boundary.push_back(Vecd(0.0, H));
+    left_boundary.push_back(Vecd(0.0, 0.0));
+    left_boundary.push_back(Vecd(-BW, -BW));
+
+    MultiPolygon multi_polygon;
+    multi_polygon.addAPolygon(left_boundary, ShapeBooleanOps::add);
+
+    return multi_polygon;
+}
+
+MultiPolygon createOtherSideBoundary()
+{
+    // other side isothermal boundary geometry.
+    std::vector<Vecd> other_boundaries;
+    other_boundaries.push_back(Vecd(-BW, -BW));
+    other_boundaries.push_back(Vecd(0.0, 0.0));
+    other_boundaries.push_back(Vecd(L, 0.0));
+    other_boundaries.push_back(Vecd(L, H));
+    other_boundaries.push_back(Vecd(0.0, L));
+    other_boundaries.push_back(Vecd(-BW, H + BW));
+    other_boundaries.push_back(Vecd(L + BW, H + BW));
+    other_boundaries.push_back(Vecd(L + BW, -BW));
+    other_boundaries.push_back(Vecd(-BW, -BW));
+
+    MultiPolygon multi_polygon;
+    multi_polygon.addAPolygon(other_boundaries, ShapeBooleanOps::add);
+
+    return multi_polygon;
+}
+//----------------------------------------------------------------------
+// Define extra classes which are used in the main program.
+// These classes are defined under the namespace of SPH.
+//----------------------------------------------------------------------
+namespace SPH
+{
+//----------------------------------------------------------------------
+//	Case-dependent initial condition.
+//----------------------------------------------------------------------
+class DiffusionInitialCondition : public LocalDynamics
+{
+  public:
+    explicit DiffusionInitialCondition(SPHBody &sph_body)
+        : LocalDynamics(sph_body),
+          pos_(particles_->getVariableDataByName<Vecd>("Position")),
+          phi_(particles_->registerStateVariable<Real>(diffusion_species_name)) {};
+
+    void update(size_t index_i, Real dt)
+    {
+        if (pos_[index_i][0] >= 0 && pos_[index_i][0] <= L && pos_[index_i][1] >= 0 && pos_[index_i][1] <= H)
+        {
+            phi_[index_i] = initial_temperature;
+        }
+    };
+
+  protected:
+    Vecd *pos_;
+    Real *phi_;
+};
+//----------------------------------------------------------------------
+//	Specify diffusion relaxation method.
+//----------------------------------------------------------------------
+using DiffusionBodyRelaxation =
+    DiffusionRelaxationRK2<DiffusionRelaxation<Inner<CorrectedKernelGradientInner>, BaseDiffusion>>;
+
+StdVec<Vecd> createObservationPoints()
+{
+    /** A line of measuring points at the middle line. */
+    size_t number_of_observation_points = 11;
+    Real range_of_measure = L - BW;
+    Real start_of_measure = BW;
+
+    StdVec<Vecd> observation_points;
+    for (size_t i = 0; i < number_of_observation_points; ++i)
+    {
+        Vec2d point_coordinate(0.5 * L, start_of_measure + range_of_measure * (Real)i / (Real)(number_of_observation_points - 1));
+        observation_points.push_back(point_coordinate);
+    }
+    return observation_points;
+};
+//----------------------------------------------------------------------
+//	The shapes built once and shared by all replicas.
+//	The bounds are found beforehand, so that the shapes are only read by the replicas.
+//----------------------------------------------------------------------
+struct SharedShapes
+{
+    SharedShapes()
+    {
+        diffusion_domain_->getBounds();
+        left_boundary_->getBounds();
+        other_boundary_->getBounds();
+    };
+
+    SharedPtr<MultiPolygonShape> diffusion_domain_ =
+        makeShared<MultiPolygonShape>(createDiffusionDomain(), "DiffusionBody");
+    SharedPtr<MultiPolygonShape> left_boundary_ = makeShared<MultiPolygonShape>(createLeftSideBoundary());
+    SharedPtr<MultiPolygonShape> other_boundary_ = makeShared<MultiPolygonShape>(createOtherSideBoundary());
+    StdVec<Vecd> observation_points_ = createObservationPoints();
+};
+} // namespace SPH
+//----------------------------------------------------------------------
+//	A replica with the perturbed diffusion coefficient.
+//	Without the ensemble runner, it is run in a separate process.
+//----------------------------------------------------------------------
+void runReplica(SharedShapes &shapes, size_t replica_index, EnsembleRunner *ensemble_runner)
+{
+    Real replica_diffusion_coeff =
+        diffusion_coeff * (1.0 + perturbation * (2.0 * Real(replica_index) / Real(number_of_replicas - 1) - 1.0));
+    //----------------------------------------------------------------------
+    //	Build up the environment of a SPHSystem with global controls.
+    //----------------------------------------------------------------------
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    sph_system.setGenerateRegressionData(true);
+    sph_system.setIOEnvironment(true, EnsembleRunner::FolderSuffix(replica_index));
+    //----------------------------------------------------------------------
+    //	Create body, materials and particles.
+    //----------------------------------------------------------------------
+    SolidBody diffusion_body(sph_system, shapes.diffusion_domain_);
+    diffusion_body.defineClosure<Solid, DirectionalDiffusion>(
+        Solid(), ConstructArgs(diffusion_species_name, replica_diffusion_coeff, bias_coeff, bias_direction));
+    diffusion_body.generateParticles<BaseParticles, Lattice>();
+    ObserverBody temperature_observer(sph_system, "TemperatureObserver");
+    temperature_observer.generateParticles<ObserverParticles>(shapes.observation_points_);
+    //----------------------------------------------------------------------
+    //	Define body relation map.
+    //----------------------------------------------------------------------
+    InnerRelation diffusion_body_inner_relation(diffusion_body);
+    ContactRelation temperature_observer_contact(temperature_observer, {&diffusion_body});
+    //----------------------------------------------------------------------
+    //	Define the main numerical methods used in the simulation.
+    //----------------------------------------------------------------------
+    SimpleDynamics<DiffusionInitialCondition> setup_diffusion_initial_condition(diffusion_body);
+    InteractionWithUpdate<LinearGradientCorrectionMatrixInner> correct_configuration(diffusion_body_inner_relation);
+    DiffusionBodyRelaxation diffusion_relaxation(diffusion_body_inner_relation);
+    GetDiffusionTimeStepSize get_time_step_size(diffusion_body);
+    BodyRegionByParticle left_boundary(diffusion_body, shapes.left_boundary_);
+    SimpleDynamics<ConstantConstraint<BodyRegionByParticle, Real>> left_boundary_condition(left_boundary, diffusion_species_name, high_temperature);
+    BodyRegionByParticle other_boundary(diffusion_body, shapes.other_boundary_);
+    SimpleDynamics<ConstantConstraint<BodyRegionByParticle, Real>> other_boundary_condition(other_boundary, diffusion_species_name, low_temperature);
+    //----------------------------------------------------------------------
+    //	The observations are remembered in memory for the regression test.
+    //----------------------------------------------------------------------
+    ObservationsInMemory<ObservedQuantityRecording<Real>>
+        write_solid_temperature(diffusion_species_name, temperature_observer_contact);
+    //----------------------------------------------------------------------
+    //	Prepare the simulation with cell linked list, configuration
+    //	and case specified initial condition if necessary.
+    //----------------------------------------------------------------------
+    sph_system.initializeSystemCellLinkedLists();
+    sph_system.initializeSystemConfigurations();
+    correct_configuration.exec();
+    setup_diffusion_initial_condition.exec();
+    left_boundary_condition.exec();
+    other_boundary_condition.exec();
+    //----------------------------------------------------------------------
+    //	Setup for time-stepping control
+    //----------------------------------------------------------------------
+    Real &physical_time = *sph_system.getSystemVariableDataByName<Real>("PhysicalTime");
+    int ite = 0;
+    Real end_time = 20.0;
+    Real dt = 0.0;
+    write_solid_temperature.writeToFile(ite);
+    //----------------------------------------------------------------------
+    //	Main loop starts here.
+    //----------------------------------------------------------------------
+    while (physical_time < end_time)
+    {
+        diffusion_relaxation.exec(dt);
+        left_boundary_condition.exec();
+        other_boundary_condition.exec();
+        ite++;
+        dt = get_time_step_size.exec();
+        physical_time += dt;
+
+        if (ite % 100 == 0)
+        {
+            write_solid_temperature.writeToFile(ite);
+        }
+    }
+    //----------------------------------------------------------------------
+    //	The regression database is enhanced by the replicas one after another.
+    //----------------------------------------------------------------------
+    if (ensemble_runner != nullptr)
+    {
+        ensemble_runner->runInOrder(
+            replica_index,
+            [&]()
+            {
+                RegressionTestEnsembleAverage<ObservedQuantityRecording<Real>>
+                    regression_solid_temperature(diffusion_species_name, temperature_observer_contact);
+                regression_solid_temperature.setObservations(
+                    write_solid_temperature.Observations(), write_solid_temperature.ElementTags());
+                regression_solid_temperature.generateDataBase(0.001, 0.001);
+            });
+    }
+}
+//----------------------------------------------------------------------
+//	Main program starts here.
+//----------------------------------------------------------------------
+int main(int ac, char *av[])
+{
+    SharedShapes shapes;
+    //----------------------------------------------------------------------
+    //	A single replica in a separate process.
+    //----------------------------------------------------------------------
+    std::string replica_option = "--replica=";
+    if (ac > 1 && std::string(av[1]).rfind(replica_option, 0) == 0)
+    {
+        runReplica(shapes, std::stoul(std::string(av[1]).substr(replica_option.size())), nullptr);
+        return 0;
+    }
+    //----------------------------------------------------------------------
+    //	All replicas in this process.
+    //----------------------------------------------------------------------
+    fs::remove_all("./input");
+    fs::create_directory("./input");
+    EnsembleRunner ensemble_runner(number_of_replicas);
+    TickCount t1 = TickCount::now();
+    ensemble_runner.run([&](size_t replica_index)
+                        { runReplica(shapes, replica_index, &ensemble_runner); });
+    TimeInterval ensemble_time = TickCount::now() - t1;
+    //----------------------------------------------------------------------
+    //	The same replicas launched as sequential processes for comparison.
+    //----------------------------------------------------------------------
+    TickCount t2 = TickCount::now();
+    for (size_t replica_index = 0; replica_index != number_of_replicas; ++replica_index)
+    {
+        std::string command = std::string(av[0]) + " " + replica_option + std::to_string(replica_index);
+        if (std::system(command.c_str()) != 0)
+        {
+            std::cout << "\n Error: the replica " << replica_index << " in a separate process failed!" << std::endl;
+            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+            exit(1);
+        }
+    }
+    TimeInterval sequential_time = TickCount::now() - t2;
+
+    std::cout << number_of_replicas << " replicas in " << ensemble_runner.NumberOfArenas() << " arenas with "
+              << ensemble_runner.ThreadsPerArena() << " threads each: " << ensemble_time.seconds() << " seconds, "
+              << "in sequential processes: " << sequential_time.seconds() << " seconds." << std::endl;
+
+    return 0;
+}
@@ -85,7 +85,7 @@ class SupersonicFlowBoundaryConditionSetup : public GhostBoundaryConditionSetupI
           p_(particles_->getVariableDataByName<Real>("Pressure")),
           E_(particles_->getVariableDataByName<Real>("TotalEnergy"))
     {
-        setupBoundaryTypes();
+        updateBoundaryTypes();
     };
     virtual ~SupersonicFlowBoundaryConditionSetup(){};
 
@@ -0,0 +1,226 @@
+/**
+ * @file fsi2_fused_force.cpp
+ * @brief This is the benchmark test of fluid-structure interaction with the fused force from fluid.
+ * @details We consider a flow-induced vibration of an elastic beam behind a cylinder in 2D,
+ * which is the same case as test_2d_fsi2 except that the pressure and viscous forces from the fluid
+ * are evaluated in a single pass at every fluid acoustic step and only on the wetted surface particles
+ * of the inserted body. The beam tip displacement and the wall time for the forces from fluid
+ * can be compared with those of test_2d_fsi2.
+ * @author Xiangyu Hu
+ */
+#include "fsi2.h" // case file to setup the test case
+#include "sphinxsys.h"
+using namespace SPH;
+//----------------------------------------------------------------------
+//	Main program starts here.
+//----------------------------------------------------------------------
+int main(int ac, char *av[])
+{
+    //----------------------------------------------------------------------
+    //	Build up SPHSystem and IO environment.
+    //----------------------------------------------------------------------
+    BoundingBox system_domain_bounds(Vec2d(-DL_sponge - BW, -BW), Vec2d(DL + BW, DH + BW));
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    sph_system.handleCommandlineOptions(ac, av)->setIOEnvironment();
+    //----------------------------------------------------------------------
+    //	Creating body, materials and particles.
+    //----------------------------------------------------------------------
+    FluidBody water_block(sph_system, makeShared<WaterBlock>("WaterBody"));
+    water_block.defineClosure<WeaklyCompressibleFluid, Viscosity>(ConstructArgs(rho0_f, c_f), mu_f);
+    water_block.generateParticles<BaseParticles, Lattice>();
+
+    SolidBody wall_boundary(sph_system, makeShared<WallBoundary>("WallBoundary"));
+    wall_boundary.defineMaterial<Solid>();
+    wall_boundary.generateParticles<BaseParticles, Lattice>();
+
+    SolidBody insert_body(sph_system, makeShared<Insert>("InsertedBody"));
+    insert_body.defineAdaptationRatios(1.15, 2.0);
+    insert_body.defineMaterial<SaintVenantKirchhoffSolid>(rho0_s, Youngs_modulus, poisson);
+    insert_body.generateParticles<BaseParticles, Lattice>();
+
+    ObserverBody beam_observer(sph_system, "BeamObserver");
+    StdVec<Vecd> beam_observation_location = {0.5 * (BRT + BRB)};
+    beam_observer.generateParticles<ObserverParticles>(beam_observation_location);
+    //----------------------------------------------------------------------
+    //	Define body relation map.
+    //----------------------------------------------------------------------
+    InnerRelation water_block_inner(water_block);
+    InnerRelation insert_body_inner(insert_body);
+    ContactRelation water_block_contact(water_block, RealBodyVector{&wall_boundary, &insert_body});
+    ContactRelation insert_body_contact(insert_body, {&water_block});
+    ContactRelation beam_observer_contact(beam_observer, {&insert_body});
+    ComplexRelation water_block_complex(water_block_inner, water_block_contact);
+    //----------------------------------------------------------------------
+    // Define the numerical methods used in the simulation.
+    //----------------------------------------------------------------------
+    SimpleDynamics<NormalDirectionFromBodyShape> wall_boundary_normal_direction(wall_boundary);
+    SimpleDynamics<NormalDirectionFromBodyShape> insert_body_normal_direction(insert_body);
+    InteractionWithUpdate<LinearGradientCorrectionMatrixInner> insert_body_corrected_configuration(insert_body_inner);
+
+    Dynamics1Level<solid_dynamics::Integration1stHalfPK2> insert_body_stress_relaxation_first_half(insert_body_inner);
+    Dynamics1Level<solid_dynamics::Integration2ndHalf> insert_body_stress_relaxation_second_half(insert_body_inner);
+
+    ReduceDynamics<solid_dynamics::AcousticTimeStep> insert_body_computing_time_step_size(insert_body);
+    BodyRegionByParticle beam_base(insert_body, makeShared<MultiPolygonShape>(createBeamBaseShape()));
+    SimpleDynamics<FixBodyPartConstraint> constraint_beam_base(beam_base);
+    //----------------------------------------------------------------------
+    //	Algorithms of fluid dynamics.
+    //----------------------------------------------------------------------
+    Dynamics1Level<fluid_dynamics::Integration1stHalfWithWallRiemann> pressure_relaxation(water_block_inner, water_block_contact);
+    Dynamics1Level<fluid_dynamics::Integration2ndHalfWithWallNoRiemann> density_relaxation(water_block_inner, water_block_contact);
+    InteractionWithUpdate<fluid_dynamics::DensitySummationComplex> update_density_by_summation(water_block_inner, water_block_contact);
+    InteractionWithUpdate<fluid_dynamics::TransportVelocityCorrectionComplex<AllParticles>> transport_correction(DynamicsArgs(water_block_inner, 0.25), water_block_contact);
+    InteractionWithUpdate<fluid_dynamics::ViscousForceWithWall> viscous_force(water_block_inner, water_block_contact);
+
+    ReduceDynamics<fluid_dynamics::AdvectionViscousTimeStep> get_fluid_advection_time_step_size(water_block, U_f);
+    ReduceDynamics<fluid_dynamics::AcousticTimeStep> get_fluid_time_step_size(water_block);
+
+    AlignedBoxByCell inflow_buffer(water_block, AlignedBox(xAxis, Transform(Vec2d(buffer_translation)), buffer_halfsize));
+    SimpleDynamics<fluid_dynamics::InflowVelocityCondition<InflowVelocity>> parabolic_inflow(inflow_buffer);
+    PeriodicAlongAxis periodic_along_x(water_block.getSPHBodyBounds(), xAxis);
+    PeriodicConditionUsingCellLinkedList periodic_condition(water_block, periodic_along_x);
+    //----------------------------------------------------------------------
+    //	Algorithms of FSI.
+    //	The wetted surface is updated with the contact configuration,
+    //	and the fused force from fluid replaces the separate pressure and viscous forces.
+    //----------------------------------------------------------------------
+    solid_dynamics::AverageVelocityAndAcceleration average_velocity_and_acceleration(insert_body);
+    SimpleDynamics<solid_dynamics::UpdateElasticNormalDirection> insert_body_update_normal(insert_body);
+    WettedSurfaceByParticle insert_body_wetted_surface(insert_body_contact);
+    InteractionWithUpdate<solid_dynamics::PressureAndViscousForceFromFluidOnWettedSurface<decltype(density_relaxation)>>
+        force_from_fluid(insert_body_wetted_surface);
+    //----------------------------------------------------------------------
+    //	Define the configuration related particles dynamics.
+    //----------------------------------------------------------------------
+    ParticleSorting particle_sorting(water_block);
+    //----------------------------------------------------------------------
+    //	Define the methods for I/O operations and observations of the simulation.
+    //----------------------------------------------------------------------
+    BodyStatesRecordingToVtp write_real_body_states(sph_system);
+    ReducedQuantityRecording<QuantitySummation<Vecd>> write_total_viscous_force_from_fluid(insert_body, "ViscousForceFromFluid");
+    ReducedQuantityRecording<QuantitySummation<Vecd>> write_total_force_from_fluid(insert_body, "ForceFromFluid");
+    ObservedQuantityRecording<Vecd> write_beam_tip_displacement("Position", beam_observer_contact);
+    //----------------------------------------------------------------------
+    //	Prepare the simulation with cell linked list, configuration
+    //	and case specified initial condition if necessary.
+    //----------------------------------------------------------------------
+    sph_system.initializeSystemCellLinkedLists();
+    periodic_condition.update_cell_linked_list_.exec();
+    sph_system.initializeSystemConfigurations();
+    insert_body_wetted_surface.update();
+    wall_boundary_normal_direction.exec();
+    insert_body_normal_direction.exec();
+    insert_body_corrected_configuration.exec();
+    //----------------------------------------------------------------------
+    //	Setup for time-stepping control
+    //----------------------------------------------------------------------
+    Real &physical_time = *sph_system.getSystemVariableDataByName<Real>("PhysicalTime");
+    size_t number_of_iterations = 0;
+    int screen_output_interval = 100;
+    Real end_time = 200.0;
+    Real output_interval = end_time / 200.0;
+    //----------------------------------------------------------------------
+    //	Statistics for CPU time
+    //----------------------------------------------------------------------
+    TickCount t1 = TickCount::now();
+    TimeInterval interval;
+    TimeInterval interval_force_from_fluid;
+    //----------------------------------------------------------------------
+    //	First output before the main loop.
+    //----------------------------------------------------------------------
+    write_real_body_states.writeToFile();
+    //----------------------------------------------------------------------
+    //	Main loop starts here.
+    //----------------------------------------------------------------------
+    while (physical_time < end_time)
+    {
+        Real integration_time = 0.0;
+        /** Integrate time (loop) until the next output time. */
+        while (integration_time < output_interval)
+        {
+            Real Dt = get_fluid_advection_time_step_size.exec();
+            update_density_by_summation.exec();
+            viscous_force.exec();
+            transport_correction.exec();
+
+            /** Update normal direction on elastic body.*/
+            insert_body_update_normal.exec();
+            size_t inner_ite_dt = 0;
+            size_t inner_ite_dt_s = 0;
+            Real relaxation_time = 0.0;
+            while (relaxation_time < Dt)
+            {
+                Real dt = SMIN(get_fluid_time_step_size.exec(), Dt);
+                /** Fluid pressure relaxation */
+                pressure_relaxation.exec(dt);
+                /** FSI for both pressure and viscous forces. */
+                TickCount t_force = TickCount::now();
+                force_from_fluid.exec();
+                interval_force_from_fluid += TickCount::now() - t_force;
+                /** Fluid density relaxation */
+                density_relaxation.exec(dt);
+
+                /** Solid dynamics. */
+                inner_ite_dt_s = 0;
+                Real dt_s_sum = 0.0;
+                average_velocity_and_acceleration.initialize_displacement_.exec();
+                while (dt_s_sum < dt)
+                {
+                    Real dt_s = SMIN(insert_body_computing_time_step_size.exec(), dt - dt_s_sum);
+                    insert_body_stress_relaxation_first_half.exec(dt_s);
+                    constraint_beam_base.exec();
+                    insert_body_stress_relaxation_second_half.exec(dt_s);
+                    dt_s_sum += dt_s;
+                    inner_ite_dt_s++;
+                }
+                average_velocity_and_acceleration.update_averages_.exec(dt);
+
+                relaxation_time += dt;
+                integration_time += dt;
+                physical_time += dt;
+                parabolic_inflow.exec();
+                inner_ite_dt++;
+            }
+
+            if (number_of_iterations % screen_output_interval == 0)
+            {
+                std::cout << std::fixed << std::setprecision(9) << "N=" << number_of_iterations << "	Time = "
+                          << physical_time
+                          << "	Dt = " << Dt << "	Dt / dt = " << inner_ite_dt << "	dt / dt_s = " << inner_ite_dt_s << "\n";
+                write_beam_tip_displacement.writeToFile(number_of_iterations);
+            }
+            number_of_iterations++;
+
+            /** Water block configuration and periodic condition. */
+            periodic_condition.bounding_.exec();
+            if (number_of_iterations % 100 == 0 && number_of_iterations != 1)
+            {
+                particle_sorting.exec();
+            }
+            water_block.updateCellLinkedList();
+            periodic_condition.update_cell_linked_list_.exec();
+            water_block_complex.updateConfiguration();
+            /** one need update configuration after periodic condition. */
+            insert_body.updateCellLinkedList();
+            insert_body_contact.updateConfiguration();
+            insert_body_wetted_surface.update();
+        }
+
+        TickCount t2 = TickCount::now();
+        /** write run-time observation into file */
+        write_real_body_states.writeToFile();
+        write_total_viscous_force_from_fluid.writeToFile(number_of_iterations);
+        write_total_force_from_fluid.writeToFile(number_of_iterations);
+        TickCount t3 = TickCount::now();
+        interval += t3 - t2;
+    }
+    TickCount t4 = TickCount::now();
+
+    TimeInterval tt;
+    tt = t4 - t1 - interval;
+    std::cout << "Total wall time for computation: " << tt.seconds() << " seconds,"
+              << " in which " << interval_force_from_fluid.seconds() << " seconds for the forces from fluid on "
+              << insert_body_wetted_surface.SizeOfLoopRange() << " wetted particles." << std::endl;
+
+    return 0;
+}
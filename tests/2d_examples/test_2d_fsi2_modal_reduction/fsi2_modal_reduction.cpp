@@ -0,0 +1,221 @@
+/**
+ * @file fsi2_modal_reduction.cpp
+ * @brief This is the benchmark test of fluid-structure interaction with a reduced-order elastic beam.
+ * @details We consider a flow-induced vibration of an elastic beam behind a cylinder in 2D,
+ * which is the same case as test_2d_fsi2 except that the elastic beam is
+ * represented by its lowest vibration modes. The modal dynamics is integrated with the fluid time step,
+ * instead of the stress relaxation with the acoustic time step of the solid.
+ * The beam tip displacement and the wall time can be compared with those of test_2d_fsi2.
+ * @author Xiangyu Hu
+ */
+#include "fsi2.h" // case file to setup the test case
+#include "sphinxsys.h"
+using namespace SPH;
+//----------------------------------------------------------------------
+//	Number of modes and damping ratio of the reduced-order beam.
+//----------------------------------------------------------------------
+size_t number_of_modes = 8;
+Real damping_ratio = 0.01;
+//----------------------------------------------------------------------
+//	Main program starts here.
+//----------------------------------------------------------------------
+int main(int ac, char *av[])
+{
+    //----------------------------------------------------------------------
+    //	Build up SPHSystem and IO environment.
+    //----------------------------------------------------------------------
+    BoundingBox system_domain_bounds(Vec2d(-DL_sponge - BW, -BW), Vec2d(DL + BW, DH + BW));
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    sph_system.handleCommandlineOptions(ac, av)->setIOEnvironment();
+    //----------------------------------------------------------------------
+    //	Creating body, materials and particles.
+    //----------------------------------------------------------------------
+    FluidBody water_block(sph_system, makeShared<WaterBlock>("WaterBody"));
+    water_block.defineClosure<WeaklyCompressibleFluid, Viscosity>(ConstructArgs(rho0_f, c_f), mu_f);
+    water_block.generateParticles<BaseParticles, Lattice>();
+
+    SolidBody wall_boundary(sph_system, makeShared<WallBoundary>("WallBoundary"));
+    wall_boundary.defineMaterial<Solid>();
+    wall_boundary.generateParticles<BaseParticles, Lattice>();
+
+    SolidBody insert_body(sph_system, makeShared<Insert>("InsertedBody"));
+    insert_body.defineAdaptationRatios(1.15, 2.0);
+    insert_body.defineMaterial<SaintVenantKirchhoffSolid>(rho0_s, Youngs_modulus, poisson);
+    insert_body.generateParticles<BaseParticles, Lattice>();
+
+    ObserverBody beam_observer(sph_system, "BeamObserver");
+    StdVec<Vecd> beam_observation_location = {0.5 * (BRT + BRB)};
+    beam_observer.generateParticles<ObserverParticles>(beam_observation_location);
+    ObserverBody fluid_observer(sph_system, "FluidObserver");
+    fluid_observer.generateParticles<ObserverParticles>(createObservationPoints());
+    //----------------------------------------------------------------------
+    //	Define body relation map.
+    //----------------------------------------------------------------------
+    InnerRelation water_block_inner(water_block);
+    InnerRelation insert_body_inner(insert_body);
+    ContactRelation water_block_contact(water_block, RealBodyVector{&wall_boundary, &insert_body});
+    ContactRelation insert_body_contact(insert_body, {&water_block});
+    ContactRelation beam_observer_contact(beam_observer, {&insert_body});
+    ContactRelation fluid_observer_contact(fluid_observer, {&water_block});
+    ComplexRelation water_block_complex(water_block_inner, water_block_contact);
+    //----------------------------------------------------------------------
+    // Define the numerical methods used in the simulation.
+    //----------------------------------------------------------------------
+    SimpleDynamics<NormalDirectionFromBodyShape> wall_boundary_normal_direction(wall_boundary);
+    SimpleDynamics<NormalDirectionFromBodyShape> insert_body_normal_direction(insert_body);
+    InteractionWithUpdate<LinearGradientCorrectionMatrixInner> insert_body_corrected_configuration(insert_body_inner);
+    /** The cylinder is the clamped beam base, and the states are only reconstructed on the beam. */
+    BodyRegionByParticle beam_base(insert_body, makeShared<MultiPolygonShape>(createBeamBaseShape()));
+    BodyRegionByParticle beam(insert_body, makeShared<MultiPolygonShape>(MultiPolygon(createBeamShape())));
+    solid_dynamics::ModalReduction beam_modal_reduction(insert_body_inner, beam_base, number_of_modes, damping_ratio);
+    beam_modal_reduction.reconstructOn(beam);
+    //----------------------------------------------------------------------
+    //	Algorithms of fluid dynamics.
+    //----------------------------------------------------------------------
+    Dynamics1Level<fluid_dynamics::Integration1stHalfWithWallRiemann> pressure_relaxation(water_block_inner, water_block_contact);
+    Dynamics1Level<fluid_dynamics::Integration2ndHalfWithWallNoRiemann> density_relaxation(water_block_inner, water_block_contact);
+    InteractionWithUpdate<fluid_dynamics::DensitySummationComplex> update_density_by_summation(water_block_inner, water_block_contact);
+    InteractionWithUpdate<fluid_dynamics::TransportVelocityCorrectionComplex<AllParticles>> transport_correction(DynamicsArgs(water_block_inner, 0.25), water_block_contact);
+    InteractionWithUpdate<fluid_dynamics::ViscousForceWithWall> viscous_force(water_block_inner, water_block_contact);
+
+    ReduceDynamics<fluid_dynamics::AdvectionViscousTimeStep> get_fluid_advection_time_step_size(water_block, U_f);
+    ReduceDynamics<fluid_dynamics::AcousticTimeStep> get_fluid_time_step_size(water_block);
+
+    AlignedBoxByCell inflow_buffer(water_block, AlignedBox(xAxis, Transform(Vec2d(buffer_translation)), buffer_halfsize));
+    SimpleDynamics<fluid_dynamics::InflowVelocityCondition<InflowVelocity>> parabolic_inflow(inflow_buffer);
+    PeriodicAlongAxis periodic_along_x(water_block.getSPHBodyBounds(), xAxis);
+    PeriodicConditionUsingCellLinkedList periodic_condition(water_block, periodic_along_x);
+    //----------------------------------------------------------------------
+    //	Algorithms of FSI.
+    //----------------------------------------------------------------------
+    SimpleDynamics<solid_dynamics::UpdateElasticNormalDirection> insert_body_update_normal(insert_body);
+    InteractionWithUpdate<solid_dynamics::ViscousForceFromFluid> viscous_force_from_fluid(insert_body_contact);
+    InteractionWithUpdate<solid_dynamics::PressureForceFromFluid<decltype(density_relaxation)>> pressure_force_from_fluid(insert_body_contact);
+    //----------------------------------------------------------------------
+    //	Define the configuration related particles dynamics.
+    //----------------------------------------------------------------------
+    ParticleSorting particle_sorting(water_block);
+    //----------------------------------------------------------------------
+    //	Define the methods for I/O operations and observations of the simulation.
+    //----------------------------------------------------------------------
+    BodyStatesRecordingToVtp write_real_body_states(sph_system);
+    ReducedQuantityRecording<QuantitySummation<Vecd>> write_total_viscous_force_from_fluid(insert_body, "ViscousForceFromFluid");
+    ObservedQuantityRecording<Vecd> write_beam_tip_displacement("Position", beam_observer_contact);
+    //----------------------------------------------------------------------
+    //	Prepare the simulation with cell linked list, configuration
+    //	and case specified initial condition if necessary.
+    //----------------------------------------------------------------------
+    sph_system.initializeSystemCellLinkedLists();
+    periodic_condition.update_cell_linked_list_.exec();
+    sph_system.initializeSystemConfigurations();
+    wall_boundary_normal_direction.exec();
+    insert_body_normal_direction.exec();
+    insert_body_corrected_configuration.exec();
+    /** The modes are computed only once. */
+    TickCount t0 = TickCount::now();
+    beam_modal_reduction.computeModes();
+    TimeInterval modal_analysis_time = TickCount::now() - t0;
+    std::cout << "Modal analysis with " << beam_modal_reduction.NumberOfModes() << " modes in "
+              << modal_analysis_time.seconds() << " seconds, natural frequencies:";
+    for (size_t m = 0; m != beam_modal_reduction.NumberOfModes(); ++m)
+        std::cout << " " << beam_modal_reduction.NaturalFrequency(m) / (2.0 * Pi);
+    std::cout << std::endl;
+    //----------------------------------------------------------------------
+    //	Setup for time-stepping control
+    //----------------------------------------------------------------------
+    Real &physical_time = *sph_system.getSystemVariableDataByName<Real>("PhysicalTime");
+    size_t number_of_iterations = 0;
+    int screen_output_interval = 100;
+    Real end_time = 200.0;
+    Real output_interval = end_time / 200.0;
+    //----------------------------------------------------------------------
+    //	Statistics for CPU time
+    //----------------------------------------------------------------------
+    TickCount t1 = TickCount::now();
+    TimeInterval interval;
+    TimeInterval interval_modal_dynamics;
+    //----------------------------------------------------------------------
+    //	First output before the main loop.
+    //----------------------------------------------------------------------
+    write_real_body_states.writeToFile();
+    //----------------------------------------------------------------------
+    //	Main loop starts here.
+    //----------------------------------------------------------------------
+    while (physical_time < end_time)
+    {
+        Real integration_time = 0.0;
+        /** Integrate time (loop) until the next output time. */
+        while (integration_time < output_interval)
+        {
+            Real Dt = get_fluid_advection_time_step_size.exec();
+            update_density_by_summation.exec();
+            viscous_force.exec();
+            transport_correction.exec();
+
+            /** FSI for viscous force. */
+            viscous_force_from_fluid.exec();
+            /** Update normal direction on elastic body.*/
+            insert_body_update_normal.exec();
+            size_t inner_ite_dt = 0;
+            Real relaxation_time = 0.0;
+            while (relaxation_time < Dt)
+            {
+                Real dt = SMIN(get_fluid_time_step_size.exec(), Dt);
+                /** Fluid pressure relaxation */
+                pressure_relaxation.exec(dt);
+                /** FSI for pressure force. */
+                pressure_force_from_fluid.exec();
+                /** Fluid density relaxation */
+                density_relaxation.exec(dt);
+
+                /** Reduced-order solid dynamics with the fluid time step. */
+                TickCount t_modal = TickCount::now();
+                beam_modal_reduction.exec(dt);
+                interval_modal_dynamics += TickCount::now() - t_modal;
+
+                relaxation_time += dt;
+                integration_time += dt;
+                physical_time += dt;
+                parabolic_inflow.exec();
+                inner_ite_dt++;
+            }
+
+            if (number_of_iterations % screen_output_interval == 0)
+            {
+                std::cout << std::fixed << std::setprecision(9) << "N=" << number_of_iterations << "	Time = "
+                          << physical_time
+                          << "	Dt = " << Dt << "	Dt / dt = " << inner_ite_dt << "\n";
+                write_beam_tip_displacement.writeToFile(number_of_iterations);
+            }
+            number_of_iterations++;
+
+            /** Water block configuration and periodic condition. */
+            periodic_condition.bounding_.exec();
+            if (number_of_iterations % 100 == 0 && number_of_iterations != 1)
+            {
+                particle_sorting.exec();
+            }
+            water_block.updateCellLinkedList();
+            periodic_condition.update_cell_linked_list_.exec();
+            water_block_complex.updateConfiguration();
+            /** one need update configuration after periodic condition. */
+            insert_body.updateCellLinkedList();
+            insert_body_contact.updateConfiguration();
+        }
+
+        TickCount t2 = TickCount::now();
+        /** write run-time observation into file */
+        write_real_body_states.writeToFile();
+        write_total_viscous_force_from_fluid.writeToFile(number_of_iterations);
+        TickCount t3 = TickCount::now();
+        interval += t3 - t2;
+    }
+    TickCount t4 = TickCount::now();
+
+    TimeInterval tt;
+    tt = t4 - t1 - interval;
+    std::cout << "Total wall time for computation: " << tt.seconds() << " seconds,"
+              << " in which " << interval_modal_dynamics.seconds() << " seconds for the modal dynamics." << std::endl;
+
+    return 0;
+}
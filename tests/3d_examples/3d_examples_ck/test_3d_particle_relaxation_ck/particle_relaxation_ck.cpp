@@ -0,0 +1,226 @@
+/**
+ * @file 	particle_relaxation_ck.cpp
+ * @brief 	Side-by-side particle relaxation of a complex STL geometry
+ *			with the classic and the computing-kernel implementations.
+ * @details The same randomized particle distribution is relaxed by both implementations
+ *			at several resolutions and the wall-clock times are compared.
+ *			The two implementations are required to give the same particle positions
+ *			after a few steps and a comparable residue after the full relaxation,
+ *			for both a volumetric body and a thin shell.
+ * @author 	Xiangyu Hu
+ */
+#include "sphinxsys_ck.h"
+using namespace SPH;
+//----------------------------------------------------------------------
+//	Basic geometry parameters and numerical setup.
+//----------------------------------------------------------------------
+std::string full_path_to_file = "./input/SPHinXsys.stl";
+Vec3d domain_lower_bound(-2.3, -0.1, -0.3);
+Vec3d domain_upper_bound(2.3, 4.5, 0.3);
+Vecd translation(0.0, 0.0, 0.0);
+Real scaling = 1.0;
+BoundingBox system_domain_bounds(domain_lower_bound, domain_upper_bound);
+StdVec<Real> resolution_levels = {50.0, 75.0, 100.0};
+int relaxation_steps = 200;
+int comparison_steps = 10;
+// shell of a ball for testing the relaxation of shell particles
+Real shell_radius = 0.5;
+Real shell_thickness = 0.1;
+Real shell_resolution = 0.05;
+Real shell_level_set_refinement_ratio = shell_resolution / (0.1 * shell_thickness);
+BoundingBox shell_domain_bounds(Vecd(-0.7, -0.7, -0.7), Vecd(0.7, 0.7, 0.7));
+//----------------------------------------------------------------------
+//	Define the imported model.
+//----------------------------------------------------------------------
+class SolidBodyFromMesh : public ComplexShape
+{
+  public:
+    explicit SolidBodyFromMesh(const std::string &shape_name) : ComplexShape(shape_name)
+    {
+        add<TriangleMeshShapeSTL>(full_path_to_file, translation, scaling);
+    }
+};
+
+class BallShell : public ComplexShape
+{
+  public:
+    explicit BallShell(const std::string &shape_name) : ComplexShape(shape_name)
+    {
+        add<GeometricShapeBall>(Vecd::Zero(), shell_radius + shell_thickness);
+        subtract<GeometricShapeBall>(Vecd::Zero(), shell_radius);
+    }
+};
+//-----------------------------------------------------------------------------------------------------------
+//	Compare the particle positions and residues of the two implementations.
+//-----------------------------------------------------------------------------------------------------------
+Real maxPositionDifference(BaseParticles &classic_particles, BaseParticles &ck_particles)
+{
+    Vecd *classic_pos = classic_particles.ParticlePositions();
+    Vecd *ck_pos = ck_particles.ParticlePositions();
+    Real max_difference = 0.0;
+    for (size_t i = 0; i != classic_particles.TotalRealParticles(); ++i)
+    {
+        max_difference = SMAX(max_difference, (classic_pos[i] - ck_pos[i]).norm());
+    }
+    return max_difference;
+}
+
+Real maxResidue(BaseParticles &particles)
+{
+    Vecd *residue = particles.getVariableDataByName<Vecd>("ZeroOrderResidue");
+    Real max_residue = 0.0;
+    for (size_t i = 0; i != particles.TotalRealParticles(); ++i)
+    {
+        max_residue = SMAX(max_residue, residue[i].norm());
+    }
+    return max_residue;
+}
+
+void copyPositions(BaseParticles &from_particles, BaseParticles &to_particles)
+{
+    Vecd *from_pos = from_particles.ParticlePositions();
+    Vecd *to_pos = to_particles.ParticlePositions();
+    for (size_t i = 0; i != from_particles.TotalRealParticles(); ++i)
+    {
+        to_pos[i] = from_pos[i];
+    }
+}
+
+template <class ClassicRelaxationType, class CKRelaxationType>
+void compareRelaxation(const std::string &case_name, ClassicRelaxationType &classic_relaxation_step,
+                       CKRelaxationType &ck_relaxation_step, BaseParticles &classic_particles,
+                       BaseParticles &ck_particles, Real dp_0)
+{
+    // the round-off differences from the summation order grow only slightly within a few steps
+    for (int ite_p = 0; ite_p != comparison_steps; ++ite_p)
+    {
+        classic_relaxation_step.exec();
+        ck_relaxation_step.exec();
+    }
+    Real max_position_difference = maxPositionDifference(classic_particles, ck_particles);
+    if (max_position_difference > 1.0e-4 * dp_0)
+    {
+        std::cout << "\n Error: the " << case_name << " particles relaxed by the computing kernels deviate by "
+                  << max_position_difference / dp_0 << " times the particle spacing after "
+                  << comparison_steps << " steps!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+
+    TickCount time_instance = TickCount::now();
+    for (int ite_p = comparison_steps; ite_p != relaxation_steps; ++ite_p)
+    {
+        classic_relaxation_step.exec();
+    }
+    TimeInterval classic_time = TickCount::now() - time_instance;
+
+    time_instance = TickCount::now();
+    for (int ite_p = comparison_steps; ite_p != relaxation_steps; ++ite_p)
+    {
+        ck_relaxation_step.exec();
+    }
+    TimeInterval ck_time = TickCount::now() - time_instance;
+
+    // the two paths may depart afterwards but should converge equally well
+    Real classic_residue = maxResidue(classic_particles);
+    Real ck_residue = maxResidue(ck_particles);
+    if (ABS(classic_residue - ck_residue) > 0.2 * SMAX(classic_residue, ck_residue))
+    {
+        std::cout << "\n Error: the " << case_name << " maximum residue " << ck_residue
+                  << " from the computing kernels differs from the classic one " << classic_residue << "!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+
+    std::cout << std::fixed << std::setprecision(6)
+              << case_name << " dp = " << dp_0 << " with " << ck_particles.TotalRealParticles() << " particles: "
+              << "classic " << classic_time.seconds() << " s, "
+              << "computing kernels " << ck_time.seconds() << " s, "
+              << "speedup " << classic_time.seconds() / (ck_time.seconds() + TinyReal) << ", "
+              << "final maximum residue " << ck_residue << std::endl;
+}
+//-----------------------------------------------------------------------------------------------------------
+//	Relax the particles with both implementations at a given resolution.
+//-----------------------------------------------------------------------------------------------------------
+using MainExecutionPolicy = execution::ParallelPolicy;
+void relaxAtResolution(Real resolution_level, int ac, char *av[])
+{
+    Real dp_0 = (domain_upper_bound[0] - domain_lower_bound[0]) / resolution_level;
+    SPHSystem sph_system(system_domain_bounds, dp_0);
+    sph_system.handleCommandlineOptions(ac, av)->setIOEnvironment();
+
+    RealBody classic_model(sph_system, makeShared<SolidBodyFromMesh>("ClassicModel"));
+    classic_model.defineBodyLevelSetShape()->correctLevelSetSign();
+    classic_model.generateParticles<BaseParticles, Lattice>();
+    RealBody ck_model(sph_system, makeShared<SolidBodyFromMesh>("CKModel"));
+    ck_model.defineBodyLevelSetShape()->correctLevelSetSign();
+    ck_model.generateParticles<BaseParticles, Lattice>();
+
+    InnerRelation classic_model_inner(classic_model);
+    Relation<Inner<>> ck_model_inner(ck_model);
+
+    using namespace relax_dynamics;
+    SimpleDynamics<RandomizeParticlePosition> random_classic_model_particles(classic_model);
+    RelaxationStepLevelSetCorrectionInner classic_relaxation_step(classic_model_inner);
+    RelaxationStepLevelSetCorrectionInnerCK<MainExecutionPolicy> ck_relaxation_step(ck_model_inner);
+    BodyStatesRecordingToVtp write_model_states(sph_system);
+    //----------------------------------------------------------------------
+    //	The two models start from the same randomized particle distribution.
+    //----------------------------------------------------------------------
+    random_classic_model_particles.exec(0.25);
+    classic_relaxation_step.SurfaceBounding().exec();
+    BaseParticles &classic_particles = classic_model.getBaseParticles();
+    BaseParticles &ck_particles = ck_model.getBaseParticles();
+    copyPositions(classic_particles, ck_particles);
+    write_model_states.writeToFile(0);
+    //----------------------------------------------------------------------
+    //	Relaxation with the two implementations.
+    //----------------------------------------------------------------------
+    compareRelaxation("Volumetric body", classic_relaxation_step, ck_relaxation_step,
+                      classic_particles, ck_particles, dp_0);
+    write_model_states.writeToFile(relaxation_steps);
+}
+//-----------------------------------------------------------------------------------------------------------
+//	Relax the particles of a thin shell with both implementations.
+//-----------------------------------------------------------------------------------------------------------
+void relaxShell(int ac, char *av[])
+{
+    SPHSystem sph_system(shell_domain_bounds, shell_resolution);
+    sph_system.handleCommandlineOptions(ac, av)->setIOEnvironment();
+
+    RealBody classic_shell(sph_system, makeShared<BallShell>("ClassicShell"));
+    classic_shell.defineBodyLevelSetShape(shell_level_set_refinement_ratio)->correctLevelSetSign();
+    classic_shell.generateParticles<SurfaceParticles, Lattice>(shell_thickness);
+    RealBody ck_shell(sph_system, makeShared<BallShell>("CKShell"));
+    ck_shell.defineBodyLevelSetShape(shell_level_set_refinement_ratio)->correctLevelSetSign();
+    ck_shell.generateParticles<SurfaceParticles, Lattice>(shell_thickness);
+
+    InnerRelation classic_shell_inner(classic_shell);
+    Relation<Inner<>> ck_shell_inner(ck_shell);
+
+    using namespace relax_dynamics;
+    SimpleDynamics<RandomizeParticlePosition> random_classic_shell_particles(classic_shell);
+    ShellRelaxationStep classic_relaxation_step(classic_shell_inner);
+    ShellRelaxationStepCK<MainExecutionPolicy> ck_relaxation_step(ck_shell_inner);
+
+    random_classic_shell_particles.exec(0.25);
+    classic_relaxation_step.MidSurfaceBounding().exec();
+    BaseParticles &classic_particles = classic_shell.getBaseParticles();
+    BaseParticles &ck_particles = ck_shell.getBaseParticles();
+    copyPositions(classic_particles, ck_particles);
+
+    compareRelaxation("Shell", classic_relaxation_step, ck_relaxation_step,
+                      classic_particles, ck_particles, shell_resolution);
+}
+//-----------------------------------------------------------------------------------------------------------
+//	Main program starts here.
+//-----------------------------------------------------------------------------------------------------------
+int main(int ac, char *av[])
+{
+    for (Real resolution_level : resolution_levels)
+    {
+        relaxAtResolution(resolution_level, ac, av);
+    }
+    relaxShell(ac, av);
+    return 0;
+}
@@ -3,7 +3,7 @@
  * @brief This is the first example of electro activation of myocardium
  * @author Chi Zhang and Xiangyu Hu
  */
-#include "sphinxsys.h"
+#include "sphinxsys_ck.h"
 using namespace SPH;
 //----------------------------------------------------------------------
 //	Basic geometry parameters and numerical setup.
@@ -33,23 +33,17 @@ Real bulk_modulus = 30.0 * reference_voltage * fabs(linear_active_stress_factor)
 //	Case dependent muscle activation history.
 //----------------------------------------------------------------------
 class MyocardiumActivation
-    : public active_muscle_dynamics::MuscleActivation
 {
   public:
-    explicit MyocardiumActivation(SPHBody &sph_body)
-        : active_muscle_dynamics::MuscleActivation(sph_body),
-          physical_time_(sph_system_.getSystemVariableDataByName<Real>("PhysicalTime")){};
-
-    void update(size_t index_i, Real dt)
+    Real Activation(const Vecd &initial_position, Real physical_time)
     {
-        Real voltage = pos0_[index_i][0] <= 0 ? 0.0 : reference_voltage * pos0_[index_i][0] / PL;
-        active_contraction_stress_[index_i] += *physical_time_ <= 1.0
-                                                   ? linear_active_stress_factor * voltage * dt
-                                                   : 0.0;
+        return initial_position[0] <= 0 ? 0.0 : reference_voltage * initial_position[0] / PL;
     };
 
-  protected:
-    Real *physical_time_;
+    Real ContractionStressRate(Real voltage, Real active_contraction_stress, Real physical_time)
+    {
+        return physical_time <= 1.0 ? linear_active_stress_factor * voltage : 0.0;
+    };
 };
 //----------------------------------------------------------------------
 //	Main program starts here.
@@ -88,7 +82,8 @@ int main(int ac, char *av[])
     Dynamics1Level<solid_dynamics::Integration2ndHalf> stress_relaxation_second_half(muscle_body_inner);
 
     ReduceDynamics<solid_dynamics::AcousticTimeStep> computing_time_step_size(muscle_body);
-    SimpleDynamics<MyocardiumActivation> myocardium_activation(muscle_body);
+    StateDynamics<execution::ParallelPolicy, solid_dynamics::MuscleActivationCK<MyocardiumActivation>>
+        myocardium_activation(muscle_body, MyocardiumActivation());
     BodyRegionByParticle holder(muscle_body, makeShared<GeometricShapeBox>(Transform(translation_holder), halfsize_holder));
     SimpleDynamics<FixedInAxisDirection> constrain_holder(holder, Vecd(0.0, 1.0, 1.0));
     //----------------------------------------------------------------------
@@ -0,0 +1,128 @@
+/**
+ * @file 	test_body_part_tagging.cpp
+ * @brief 	test the parallel tagging and re-tagging of a body region by particles
+ * @details The particles tagged in parallel should be the same and in the same order
+ *			as those found by a sequential loop, also after the region shape is moved.
+ *			After particle sorting, the particle list should still give the re-tagged particles.
+ * @author 	Xiangyu Hu
+ */
+#include "sphinxsys_ck.h"
+#include <gtest/gtest.h>
+using namespace SPH;
+//----------------------------------------------------------------------
+//	Basic geometry parameters and numerical setup.
+//----------------------------------------------------------------------
+Real block_width = 2.0;
+Real block_height = 1.0;
+Real particle_spacing = 0.01;
+Vec2d region_halfsize(0.2, 0.1);
+BoundingBox system_domain_bounds(Vec2d(-0.5, -0.5), Vec2d(block_width + 0.5, block_height + 0.5));
+//----------------------------------------------------------------------
+//	Sequential reference of the tagged particles.
+//----------------------------------------------------------------------
+IndexVector findContainedParticles(BaseParticles &particles, Shape &shape)
+{
+    IndexVector contained_particles;
+    Vecd *pos = particles.ParticlePositions();
+    for (size_t i = 0; i != particles.TotalRealParticles(); ++i)
+    {
+        if (shape.checkContain(pos[i]))
+            contained_particles.push_back(i);
+    }
+    return contained_particles;
+}
+
+void checkBodyRegion(BodyRegionByParticle &body_region, BaseParticles &particles, Shape &shape)
+{
+    IndexVector reference = findContainedParticles(particles, shape);
+    ASSERT_FALSE(reference.empty());
+    EXPECT_EQ(body_region.body_part_particles_, reference);
+    EXPECT_EQ(size_t(body_region.svRangeSize()->getValue()), reference.size());
+
+    UnsignedInt *particle_list = body_region.dvParticleList()->Data();
+    int *body_part_id = particles.getVariableDataByName<int>(body_region.getSPHBody().getName() + "Part" +
+                                                             std::to_string(body_region.getPartID()) + "ID");
+    size_t number_of_tagged_ids = 0;
+    for (size_t i = 0; i != particles.TotalRealParticles(); ++i)
+    {
+        if (body_part_id[i] == body_region.getPartID())
+            number_of_tagged_ids++;
+    }
+    EXPECT_EQ(number_of_tagged_ids, reference.size());
+    for (size_t i = 0; i != reference.size(); ++i)
+    {
+        EXPECT_EQ(size_t(particle_list[i]), reference[i]);
+    }
+}
+
+void checkSortedBodyRegion(BodyRegionByParticle &body_region, BaseParticles &particles, Shape &shape)
+{
+    IndexVector reference = findContainedParticles(particles, shape);
+    ASSERT_FALSE(reference.empty());
+    ASSERT_EQ(size_t(body_region.svRangeSize()->getValue()), reference.size());
+
+    UnsignedInt *particle_list = body_region.dvParticleList()->Data();
+    IndexVector sorted_list(particle_list, particle_list + reference.size());
+    std::sort(sorted_list.begin(), sorted_list.end());
+    EXPECT_EQ(sorted_list, reference);
+}
+//----------------------------------------------------------------------
+//	Main program starts here.
+//----------------------------------------------------------------------
+TEST(BodyRegionByParticle, TagAndUpdate)
+{
+    SPHSystem sph_system(system_domain_bounds, particle_spacing);
+    GeometricShapeBox block_shape(Transform(Vec2d(0.5 * block_width, 0.5 * block_height)),
+                                  Vec2d(0.5 * block_width, 0.5 * block_height), "Block");
+    RealBody block(sph_system, block_shape);
+    block.generateParticles<BaseParticles, Lattice>();
+    BaseParticles &particles = block.getBaseParticles();
+
+    GeometricShapeBox region_shape(Transform(Vec2d(0.3, 0.3)), region_halfsize, "Region");
+    BodyRegionByParticle body_region(block, region_shape);
+    checkBodyRegion(body_region, particles, region_shape);
+
+    // moved and rotated within the block
+    region_shape.setTransform(Transform(Rotation2d(0.25 * Pi), Vec2d(1.0, 0.5)));
+    body_region.update();
+    checkBodyRegion(body_region, particles, region_shape);
+
+    // moving partially out of the block, the particle list shrinks
+    region_shape.setTransform(Transform(Vec2d(block_width, 0.8)));
+    body_region.update();
+    checkBodyRegion(body_region, particles, region_shape);
+}
+
+TEST(BodyRegionByParticle, SortAfterUpdate)
+{
+    SPHSystem sph_system(system_domain_bounds, particle_spacing);
+    GeometricShapeBox block_shape(Transform(Vec2d(0.5 * block_width, 0.5 * block_height)),
+                                  Vec2d(0.5 * block_width, 0.5 * block_height), "Block");
+    RealBody block(sph_system, block_shape);
+    block.generateParticles<BaseParticles, Lattice>();
+    BaseParticles &particles = block.getBaseParticles();
+
+    // partially out of the block first
+    GeometricShapeBox region_shape(Transform(Vec2d(block_width, 0.8)), region_halfsize, "Region");
+    BodyRegionByParticle body_region(block, region_shape);
+    ParticleSortCK<execution::ParallelPolicy> particle_sort(block);
+    particle_sort.exec();
+    checkSortedBodyRegion(body_region, particles, region_shape);
+
+    // the particle list is reallocated when it grows
+    region_shape.setTransform(Transform(Vec2d(1.0, 0.5)));
+    body_region.update();
+    particle_sort.exec();
+    checkSortedBodyRegion(body_region, particles, region_shape);
+
+    region_shape.setTransform(Transform(Rotation2d(0.25 * Pi), Vec2d(0.5, 0.5)));
+    body_region.update();
+    particle_sort.exec();
+    checkSortedBodyRegion(body_region, particles, region_shape);
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,77 @@
+#include "base_data_type.h"
+#include "multi_polygon_shape.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real ring_radius = 1.0;
+Real hole_radius = 0.4;
+int resolution = 5000;
+size_t number_of_probes = 2000;
+auto tolerance = []()
+{ return 100 * Eps; }; // Invalid initialization order with static libraries on GCC 9.4 requires function
+
+MultiPolygon createRingWithBox()
+{
+    MultiPolygon multi_polygon(Vec2d::Zero(), ring_radius, resolution);
+    multi_polygon.addACircle(Vec2d::Zero(), hole_radius, resolution, ShapeBooleanOps::sub);
+    multi_polygon.addABox(Transform(Vec2d(2.0, 0.0)), Vec2d(0.3, 0.5), ShapeBooleanOps::add);
+    return multi_polygon;
+}
+
+StdVec<Vec2d> createProbePoints()
+{
+    StdVec<Vec2d> probe_points;
+    for (size_t n = 0; n != number_of_probes; ++n)
+    {
+        // quasi-random probes from the golden ratio sequences
+        Real x = fmod(0.5 + Real(n) * 0.6180339887498949, 1.0);
+        Real y = fmod(0.5 + Real(n) * 0.7548776662466927, 1.0);
+        probe_points.push_back(Vec2d(-1.5 + 4.0 * x, -1.5 + 3.0 * y));
+    }
+    return probe_points;
+}
+
+TEST(test_MultiPolygon, test_contain)
+{
+    MultiPolygon multi_polygon = createRingWithBox();
+    boost_multi_poly boost_multi_polygon = multi_polygon.getBoostMultiPoly();
+    for (const Vec2d &probe_point : createProbePoints())
+    {
+        boost_point point(probe_point[0], probe_point[1]);
+        EXPECT_EQ(multi_polygon.checkContain(probe_point), bg::covered_by(point, boost_multi_polygon));
+        EXPECT_EQ(multi_polygon.checkContain(probe_point, false), bg::within(point, boost_multi_polygon));
+    }
+}
+
+TEST(test_MultiPolygon, test_contain_boundary)
+{
+    MultiPolygon multi_polygon = createRingWithBox();
+    Vec2d boundary_point(2.3, 0.1);
+
+    EXPECT_EQ(multi_polygon.checkContain(boundary_point), true);
+    EXPECT_EQ(multi_polygon.checkContain(boundary_point, false), false);
+}
+
+TEST(test_MultiPolygon, test_closest_point)
+{
+    MultiPolygon multi_polygon = createRingWithBox();
+    boost_multi_poly boost_multi_polygon = multi_polygon.getBoostMultiPoly();
+    for (const Vec2d &probe_point : createProbePoints())
+    {
+        // brute-force distance to all segments as reference
+        boost_point point(probe_point[0], probe_point[1]);
+        Real boundary_distance = MaxReal;
+        bg::for_each_segment(boost_multi_polygon, [&](const auto &seg)
+                             { boundary_distance = SMIN(boundary_distance, Real(bg::distance(point, seg))); });
+
+        Vec2d closest_point = multi_polygon.findClosestPoint(probe_point);
+        EXPECT_LE(ABS((closest_point - probe_point).norm() - boundary_distance), tolerance());
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,126 @@
+/**
+ * @file 	test_fvm_ghost_creation.cpp
+ * @brief 	test the parallel creation of the ghost particles from a 2D FVM mesh
+ * @details The ghost indices, positions, contact real particles and normals of each boundary type
+ *			should be the same and in the same order as those created by a serial loop over the mesh.
+ * @author 	Xiangyu Hu
+ */
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+using namespace SPH;
+//----------------------------------------------------------------------
+//	Basic geometry parameters and numerical setup.
+//----------------------------------------------------------------------
+Real DL = 4.0;
+Real DH = 1.0;
+BoundingBox system_domain_bounds(Vec2d(0.0, 0.0), Vec2d(DL, DH));
+std::string mesh_fullpath = "./input/double_mach_reflection_0.05.msh";
+class MeshBody : public ComplexShape
+{
+  public:
+    explicit MeshBody(const std::string &shape_name) : ComplexShape(shape_name)
+    {
+        std::vector<Vecd> computation_domain{Vecd(0.0, 0.0), Vecd(0.0, DH), Vecd(DL, DH),
+                                             Vecd(DL, 0.0), Vecd(0.0, 0.0)};
+        add<MultiPolygonShape>(MultiPolygon(computation_domain), "ComputationDomain");
+    }
+};
+//----------------------------------------------------------------------
+//	Serial reference of the ghosts created from the mesh.
+//----------------------------------------------------------------------
+struct SerialGhosts
+{
+    StdVec<StdVec<size_t>> ghost_index_;
+    StdVec<StdVec<size_t>> contact_real_index_;
+    StdVec<StdVec<Vecd>> ghost_eij_;
+    StdVec<Vecd> ghost_position_;
+};
+
+SerialGhosts createSerialGhosts(ANSYSMesh &mesh, Vecd *pos, size_t total_real_particles, size_t ghost_lower_bound)
+{
+    SerialGhosts serial_ghosts;
+    size_t ghost_particle_index = ghost_lower_bound;
+    for (size_t index_i = 0; index_i != total_real_particles; ++index_i)
+    {
+        for (size_t neighbor_index = 0; neighbor_index != mesh.mesh_topology_[index_i].size(); ++neighbor_index)
+        {
+            size_t boundary_type = mesh.mesh_topology_[index_i][neighbor_index][1];
+            if (boundary_type != 2)
+            {
+                if (serial_ghosts.ghost_index_.size() <= boundary_type)
+                {
+                    serial_ghosts.ghost_index_.resize(boundary_type + 1);
+                    serial_ghosts.contact_real_index_.resize(boundary_type + 1);
+                    serial_ghosts.ghost_eij_.resize(boundary_type + 1);
+                }
+                Vecd node1_position = mesh.node_coordinates_[mesh.mesh_topology_[index_i][neighbor_index][2]];
+                Vecd node2_position = mesh.node_coordinates_[mesh.mesh_topology_[index_i][neighbor_index][3]];
+                Vecd unit_vector = (node1_position - node2_position).normalized();
+                Vecd normal_vector = Vecd(unit_vector[1], -unit_vector[0]);
+                if ((pos[index_i] - node1_position).dot(normal_vector) < 0)
+                    normal_vector = -normal_vector;
+
+                serial_ghosts.ghost_index_[boundary_type].push_back(ghost_particle_index);
+                serial_ghosts.contact_real_index_[boundary_type].push_back(index_i);
+                serial_ghosts.ghost_eij_[boundary_type].push_back(normal_vector);
+                serial_ghosts.ghost_position_.push_back(0.5 * (node1_position + node2_position));
+                ghost_particle_index++;
+            }
+        }
+    }
+    return serial_ghosts;
+}
+//----------------------------------------------------------------------
+//	Main program starts here.
+//----------------------------------------------------------------------
+TEST(GhostCreationFromMesh, SameAsSerialOrder)
+{
+    ANSYSMesh ansys_mesh(mesh_fullpath);
+    ANSYSMesh reference_mesh(mesh_fullpath);
+    SPHSystem sph_system(system_domain_bounds, ansys_mesh.MinMeshEdge());
+    FluidBody mesh_body(sph_system, makeShared<MeshBody>("MeshBody"));
+    mesh_body.defineMaterial<CompressibleFluid>(1.0, 1.4);
+    Ghost<ReserveSizeFactor> ghost_boundary(0.5);
+    mesh_body.generateParticlesWithReserve<BaseParticles, UnstructuredMesh>(ghost_boundary, ansys_mesh);
+    BaseParticles &particles = mesh_body.getBaseParticles();
+    size_t total_real_particles = particles.TotalRealParticles();
+
+    GhostCreationFromMesh ghost_creation(mesh_body, ansys_mesh, ghost_boundary);
+    Vecd *pos = particles.ParticlePositions();
+    SerialGhosts serial_ghosts =
+        createSerialGhosts(reference_mesh, pos, total_real_particles, ghost_creation.ghost_bound_.first);
+
+    size_t total_ghosts = ghost_creation.ghost_bound_.second - ghost_creation.ghost_bound_.first;
+    ASSERT_EQ(total_ghosts, serial_ghosts.ghost_position_.size());
+    for (size_t n = 0; n != total_ghosts; ++n)
+    {
+        EXPECT_LT((pos[ghost_creation.ghost_bound_.first + n] - serial_ghosts.ghost_position_[n]).norm(), 1.0e-12);
+    }
+
+    size_t number_of_boundary_types = serial_ghosts.ghost_index_.size();
+    ASSERT_GE(ghost_creation.each_boundary_type_with_all_ghosts_index_.size(), number_of_boundary_types);
+    for (size_t boundary_type = 0; boundary_type != ghost_creation.each_boundary_type_with_all_ghosts_index_.size(); ++boundary_type)
+    {
+        if (boundary_type >= number_of_boundary_types)
+        {
+            EXPECT_TRUE(ghost_creation.each_boundary_type_with_all_ghosts_index_[boundary_type].empty());
+            continue;
+        }
+        EXPECT_EQ(ghost_creation.each_boundary_type_with_all_ghosts_index_[boundary_type],
+                  serial_ghosts.ghost_index_[boundary_type]);
+        EXPECT_EQ(ghost_creation.each_boundary_type_contact_real_index_[boundary_type],
+                  serial_ghosts.contact_real_index_[boundary_type]);
+        StdVec<Vecd> &ghost_eij = ghost_creation.each_boundary_type_with_all_ghosts_eij_[boundary_type];
+        ASSERT_EQ(ghost_eij.size(), serial_ghosts.ghost_eij_[boundary_type].size());
+        for (size_t n = 0; n != ghost_eij.size(); ++n)
+        {
+            EXPECT_LT((ghost_eij[n] - serial_ghosts.ghost_eij_[boundary_type][n]).norm(), 1.0e-12);
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,88 @@
+#include "component_planes.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+/** A kernel-like update written for an array of the data type. */
+template <typename DataType, class ArrayType>
+void addScaled(ArrayType target, const DataType *source, Real factor, size_t size)
+{
+    for (size_t i = 0; i != size; ++i)
+    {
+        target[i] += factor * source[i];
+    }
+}
+
+TEST(ComponentPlanes, VectorRoundTrip)
+{
+    size_t size = 100;
+    DiscreteVariable<Vec3d> dv_vector("Vector", size, [](size_t i)
+                                      { return Vec3d(Real(i), 2.0 * Real(i), -Real(i)); });
+    ComponentPlanes<Vec3d> planes(&dv_vector);
+    planes.load(size);
+    for (size_t i = 0; i != size; ++i)
+    {
+        EXPECT_EQ(planes.Plane(0)[i], Real(i));
+        EXPECT_EQ(planes.Plane(1)[i], 2.0 * Real(i));
+        EXPECT_EQ(planes.Plane(2)[i], -Real(i));
+        EXPECT_EQ(planes.Accessor().load(i), dv_vector.Data()[i]);
+    }
+
+    StdVec<Vec3d> reference(dv_vector.Data(), dv_vector.Data() + size);
+    StdVec<Vec3d> increment(size, Vec3d(1.0, 0.5, 0.25));
+    addScaled<Vec3d>(reference.data(), increment.data(), 0.1, size);
+    addScaled<Vec3d>(planes.Accessor(), increment.data(), 0.1, size);
+    planes.store(size);
+    for (size_t i = 0; i != size; ++i)
+    {
+        EXPECT_EQ(dv_vector.Data()[i], reference[i]);
+    }
+}
+
+TEST(ComponentPlanes, MatrixRoundTrip)
+{
+    size_t size = 50;
+    DiscreteVariable<Mat3d> dv_matrix("Matrix", size, [](size_t i)
+                                      { return Real(i + 1) * Mat3d::Identity() + Mat3d::Ones(); });
+    ComponentPlanes<Mat3d> planes(&dv_matrix);
+    planes.load(size);
+    PlanesAccessor<Mat3d> accessor = planes.Accessor();
+    for (size_t i = 0; i != size; ++i)
+    {
+        Mat3d matrix = accessor[i];
+        EXPECT_EQ(matrix, dv_matrix.Data()[i]);
+        accessor[i] = matrix.transpose() * matrix;
+    }
+    planes.store(size);
+    for (size_t i = 0; i != size; ++i)
+    {
+        Mat3d matrix = Real(i + 1) * Mat3d::Identity() + Mat3d::Ones();
+        EXPECT_EQ(dv_matrix.Data()[i], matrix.transpose() * matrix);
+    }
+}
+
+TEST(ComponentPlanes, ReallocatedVariable)
+{
+    DiscreteVariable<Vec3d> dv_vector("Vector", 10, [](size_t i)
+                                      { return Vec3d::Constant(Real(i)); });
+    ComponentPlanes<Vec3d> planes(&dv_vector);
+    planes.load(10);
+    dv_vector.reallocateData(execution::ParallelPolicy(), 100);
+    for (size_t i = 0; i != 100; ++i)
+    {
+        dv_vector.setValue(i, Vec3d::Constant(Real(i)));
+    }
+    planes.load(100);
+    EXPECT_EQ(planes.PlaneSize(), dv_vector.getDataSize());
+    for (size_t i = 0; i != 100; ++i)
+    {
+        EXPECT_EQ(planes.Plane(2)[i], Real(i));
+    }
+}
+//=================================================================================================//
+//=================================================================================================//
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
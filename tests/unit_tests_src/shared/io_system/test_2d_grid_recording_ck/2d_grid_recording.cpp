@@ -0,0 +1,122 @@
+/**
+ * @file 	2d_grid_recording.cpp
+ * @brief 	test the resampling of particle variables on a Cartesian grid.
+ * @details Two adjacent bodies carry the same linear pressure and velocity fields,
+ *			which should be recovered on the grid points inside the bodies,
+ *			also across the interface between the bodies.
+ *			The grid points away from the bodies should have zero weight.
+ * @author 	Xiangyu Hu
+ */
+#include "sphinxsys_ck.h"
+#include <gtest/gtest.h>
+using namespace SPH;
+//----------------------------------------------------------------------
+//	Basic geometry parameters and numerical setup.
+//----------------------------------------------------------------------
+Real width = 1.0;
+Real height = 0.5;
+Real particle_spacing = 0.02;
+Real extension = 0.2;
+//----------------------------------------------------------------------
+//	Linear fields to be resampled.
+//----------------------------------------------------------------------
+Real linearPressure(const Vecd &position) { return 1.0 + position[0] + 2.0 * position[1]; }
+Vecd linearVelocity(const Vecd &position) { return Vecd(position[1], -position[0]); }
+//----------------------------------------------------------------------
+//	Google test item.
+//----------------------------------------------------------------------
+Real max_pressure_error = MaxReal;
+Real max_velocity_error = MaxReal;
+Real max_outside_weight = MaxReal;
+bool is_file_written = false;
+TEST(BodyStatesRecordingToVtiCK, LinearFields)
+{
+    EXPECT_LT(max_pressure_error, 1.0e-2);
+    EXPECT_LT(max_velocity_error, 1.0e-2);
+    EXPECT_EQ(max_outside_weight, 0.0);
+    EXPECT_TRUE(is_file_written);
+    std::cout << "Maximum pressure error: " << max_pressure_error << " and "
+              << "maximum velocity error: " << max_velocity_error << std::endl;
+};
+
+class Block : public ComplexShape
+{
+  public:
+    Block(const std::string &shape_name, const Vecd &lower_bound) : ComplexShape(shape_name)
+    {
+        Vecd halfsize(0.25 * width, 0.5 * height);
+        add<GeometricShapeBox>(Transform(lower_bound + halfsize), halfsize);
+    }
+};
+
+void setLinearFields(BaseParticles &particles)
+{
+    Vecd *pos = particles.ParticlePositions();
+    Real *p = particles.registerStateVariable<Real>("Pressure");
+    Vecd *vel = particles.registerStateVariable<Vecd>("Velocity");
+    for (size_t i = 0; i != particles.TotalRealParticles(); ++i)
+    {
+        p[i] = linearPressure(pos[i]);
+        vel[i] = linearVelocity(pos[i]);
+    }
+}
+//----------------------------------------------------------------------
+//	Main program starts here.
+//----------------------------------------------------------------------
+int main(int ac, char *av[])
+{
+    BoundingBox system_domain_bounds(Vecd(-extension, -extension), Vecd(width + extension, height + extension));
+    SPHSystem sph_system(system_domain_bounds, particle_spacing);
+    sph_system.handleCommandlineOptions(ac, av)->setIOEnvironment();
+
+    SolidBody left_block(sph_system, makeShared<Block>("LeftBlock", Vecd::Zero()));
+    left_block.defineMaterial<Solid>();
+    left_block.generateParticles<BaseParticles, Lattice>();
+    SolidBody right_block(sph_system, makeShared<Block>("RightBlock", Vecd(0.5 * width, 0.0)));
+    right_block.defineMaterial<Solid>();
+    right_block.generateParticles<BaseParticles, Lattice>();
+    setLinearFields(left_block.getBaseParticles());
+    setLinearFields(right_block.getBaseParticles());
+
+    using MainExecutionPolicy = execution::ParallelPolicy;
+    UpdateCellLinkedList<MainExecutionPolicy, CellLinkedList> left_cell_linked_list(left_block);
+    UpdateCellLinkedList<MainExecutionPolicy, CellLinkedList> right_cell_linked_list(right_block);
+
+    BodyStatesRecordingToVtiCK<MainExecutionPolicy> grid_recording(
+        sph_system, BoundingBox(Vecd(-0.5 * extension, -0.5 * extension), Vecd(width, height)), 0.05);
+    grid_recording.addToWrite<Real>(left_block, "Pressure");
+    grid_recording.addToWrite<Real>(right_block, "Pressure");
+    grid_recording.addToWrite<Vecd>(left_block, "Velocity");
+    grid_recording.addToWrite<Vecd>(right_block, "Velocity");
+
+    left_cell_linked_list.exec();
+    right_cell_linked_list.exec();
+    grid_recording.writeToFile(0);
+
+    Vecd *grid_pos = grid_recording.getGridPositions();
+    Real *grid_p = grid_recording.getGridValues<Real>("Pressure");
+    Vecd *grid_vel = grid_recording.getGridValues<Vecd>("Velocity");
+    Real *total_weight = grid_recording.getTotalWeights();
+    Real cutoff_radius = left_block.getSPHAdaptation().getKernel()->CutOffRadius();
+    max_pressure_error = 0.0;
+    max_velocity_error = 0.0;
+    max_outside_weight = 0.0;
+    for (size_t k = 0; k != grid_recording.TotalGridPoints(); ++k)
+    {
+        Vecd position = grid_pos[k];
+        bool is_inner = position[0] > cutoff_radius && position[0] < width - cutoff_radius &&
+                        position[1] > cutoff_radius && position[1] < height - cutoff_radius;
+        bool is_outside = position[0] < -cutoff_radius || position[1] < -cutoff_radius;
+        if (is_inner)
+        {
+            max_pressure_error = SMAX(max_pressure_error, ABS(grid_p[k] - linearPressure(position)));
+            max_velocity_error = SMAX(max_velocity_error, (grid_vel[k] - linearVelocity(position)).norm());
+        }
+        if (is_outside)
+            max_outside_weight = SMAX(max_outside_weight, total_weight[k]);
+    }
+    is_file_written = fs::exists(sph_system.getIOEnvironment().output_folder_ + "/GridStates_0000000000.vti");
+
+    testing::InitGoogleTest(&ac, av);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,142 @@
+/**
+ * @file 	test_2d_adaptive_particle_sort_ck.cpp
+ * @brief 	test the incremental sorting of nearly sorted particles
+ * @details Two identical blocks are sorted and then perturbed in the same way.
+ *			One is sorted incrementally by the adaptive particle sort and the other by the full sort.
+ *			The incrementally sorted cell sequence should be non-decreasing,
+ *			and the particles should be the same as those sorted by the full sort.
+ *			The times of both sorts are given for comparison.
+ * @author 	Xiangyu Hu
+ */
+#include "sphinxsys_ck.h"
+#include <gtest/gtest.h>
+using namespace SPH;
+//----------------------------------------------------------------------
+//	Basic geometry parameters and numerical setup.
+//----------------------------------------------------------------------
+Real block_width = 2.0;
+Real block_height = 1.0;
+Real particle_spacing = 0.02;
+BoundingBox system_domain_bounds(Vec2d(-0.5, -0.5), Vec2d(block_width + 0.5, block_height + 0.5));
+using MainExecutionPolicy = execution::ParallelPolicy;
+//----------------------------------------------------------------------
+//	Cell sequences and positions of the sorted particles.
+//----------------------------------------------------------------------
+StdVec<UnsignedInt> cellSequences(RealBody &real_body)
+{
+    Mesh &mesh = DynamicCast<CellLinkedList>(&real_body, real_body.getCellLinkedList()).getMesh();
+    BaseParticles &particles = real_body.getBaseParticles();
+    Vecd *pos = particles.ParticlePositions();
+    StdVec<UnsignedInt> sequences;
+    for (size_t i = 0; i != particles.TotalRealParticles(); ++i)
+    {
+        sequences.push_back(mesh.transferMeshIndexToMortonOrder(mesh.CellIndexFromPosition(pos[i])));
+    }
+    return sequences;
+}
+
+StdVec<std::pair<UnsignedInt, Vecd>> cellSortedPositions(RealBody &real_body)
+{
+    StdVec<UnsignedInt> sequences = cellSequences(real_body);
+    Vecd *pos = real_body.getBaseParticles().ParticlePositions();
+    StdVec<std::pair<UnsignedInt, Vecd>> sorted_positions;
+    for (size_t i = 0; i != sequences.size(); ++i)
+    {
+        sorted_positions.push_back(std::make_pair(sequences[i], pos[i]));
+    }
+    // the order of the particles within a cell is not defined by sorting
+    std::sort(sorted_positions.begin(), sorted_positions.end(),
+              [](const std::pair<UnsignedInt, Vecd> &a, const std::pair<UnsignedInt, Vecd> &b)
+              {
+                  return a.first != b.first ? a.first < b.first
+                                            : std::make_pair(a.second[0], a.second[1]) <
+                                                  std::make_pair(b.second[0], b.second[1]);
+              });
+    return sorted_positions;
+}
+//----------------------------------------------------------------------
+//	Main program starts here.
+//----------------------------------------------------------------------
+TEST(AdaptiveParticleSortCK, IncrementalSort)
+{
+    SPHSystem sph_system(system_domain_bounds, particle_spacing);
+    GeometricShapeBox block_shape(Transform(Vec2d(0.5 * block_width, 0.5 * block_height)),
+                                  Vec2d(0.5 * block_width, 0.5 * block_height), "Block");
+    RealBody incremental_block(sph_system, block_shape);
+    incremental_block.generateParticles<BaseParticles, Lattice>();
+    RealBody full_block(sph_system, block_shape);
+    full_block.generateParticles<BaseParticles, Lattice>();
+
+    ParticleSortCK<MainExecutionPolicy> initial_sort(incremental_block);
+    AdaptiveParticleSortCK<MainExecutionPolicy> adaptive_sort(incremental_block, 0.0, 0.5);
+    ParticleSortCK<MainExecutionPolicy> full_sort(full_block);
+    initial_sort.exec();
+    full_sort.exec();
+
+    // a sorted lattice is not sorted again
+    adaptive_sort.exec();
+    EXPECT_EQ(adaptive_sort.Disorder(), 0.0);
+    EXPECT_EQ(adaptive_sort.NumberOfSorts(), size_t(0));
+
+    // a few particles are moved by up to two cells, the others slightly
+    BaseParticles &incremental_particles = incremental_block.getBaseParticles();
+    BaseParticles &full_particles = full_block.getBaseParticles();
+    size_t total_real_particles = incremental_particles.TotalRealParticles();
+    ASSERT_EQ(total_real_particles, full_particles.TotalRealParticles());
+    Vecd *incremental_pos = incremental_particles.ParticlePositions();
+    Vecd *full_pos = full_particles.ParticlePositions();
+    std::mt19937 random_engine(1);
+    std::uniform_real_distribution<Real> perturbation(-1.0, 1.0);
+    Real cell_size = DynamicCast<CellLinkedList>(this, incremental_block.getCellLinkedList()).getMesh().GridSpacing();
+    for (size_t i = 0; i != total_real_particles; ++i)
+    {
+        ASSERT_EQ(incremental_pos[i], full_pos[i]);
+        Real amplitude = i % 20 == 0 ? 2.0 * cell_size : 0.1 * particle_spacing;
+        Vecd displacement(amplitude * perturbation(random_engine), amplitude * perturbation(random_engine));
+        incremental_pos[i] += displacement;
+        full_pos[i] += displacement;
+    }
+    UnsignedInt *original_id = incremental_particles.getVariableDataByName<UnsignedInt>("OriginalID");
+    StdVec<Vecd> perturbed_pos(total_real_particles);
+    for (size_t i = 0; i != total_real_particles; ++i)
+    {
+        perturbed_pos[original_id[i]] = incremental_pos[i];
+    }
+
+    TickCount time_instance = TickCount::now();
+    adaptive_sort.exec();
+    TimeInterval adaptive_sort_time = TickCount::now() - time_instance;
+    time_instance = TickCount::now();
+    full_sort.exec();
+    TimeInterval full_sort_time = TickCount::now() - time_instance;
+    std::cout << "Adaptive sort: " << adaptive_sort_time.seconds() << " seconds, "
+              << "full sort: " << full_sort_time.seconds() << " seconds." << std::endl;
+    EXPECT_GT(adaptive_sort.Disorder(), 0.0);
+    EXPECT_EQ(adaptive_sort.NumberOfSorts(), size_t(1));
+    EXPECT_EQ(adaptive_sort.NumberOfIncrementalSorts(), size_t(1));
+
+    StdVec<UnsignedInt> incremental_sequences = cellSequences(incremental_block);
+    EXPECT_TRUE(std::is_sorted(incremental_sequences.begin(), incremental_sequences.end()));
+    EXPECT_EQ(incremental_sequences, cellSequences(full_block));
+
+    StdVec<std::pair<UnsignedInt, Vecd>> incremental_positions = cellSortedPositions(incremental_block);
+    StdVec<std::pair<UnsignedInt, Vecd>> full_positions = cellSortedPositions(full_block);
+    for (size_t i = 0; i != total_real_particles; ++i)
+    {
+        EXPECT_EQ(incremental_positions[i].second, full_positions[i].second);
+    }
+
+    // the other particle variables are permuted consistently
+    incremental_pos = incremental_particles.ParticlePositions();
+    original_id = incremental_particles.getVariableDataByName<UnsignedInt>("OriginalID");
+    for (size_t i = 0; i != total_real_particles; ++i)
+    {
+        EXPECT_EQ(incremental_pos[i], perturbed_pos[original_id[i]]);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,155 @@
+/**
+ * @file 	test_3d_compressed_neighbor_list_ck.cpp
+ * @brief 	test the compressed neighbor list with 16-bit offsets in 3D
+ * @details The positions of a particle block are shuffled so that the neighbor indices are scattered,
+ *			and then optionally sorted. The same neighbor loop is carried out with the full-width
+ *			and the compressed neighbor lists, and the results should be identical.
+ *			The memory footprints and the wall times of the neighbor loops are given for comparison.
+ * @author 	Xiangyu Hu
+ */
+#include "sphinxsys_ck.h"
+#include <gtest/gtest.h>
+using namespace SPH;
+//----------------------------------------------------------------------
+//	Basic geometry parameters and numerical setup.
+//----------------------------------------------------------------------
+Real block_width = 0.4;
+Real particle_spacing = 0.01;
+BoundingBox system_domain_bounds(Vec3d(-0.1, -0.1, -0.1), Vec3d(block_width + 0.1, block_width + 0.1, block_width + 0.1));
+size_t number_of_loops = 10;
+using MainExecutionPolicy = execution::ParallelPolicy;
+//----------------------------------------------------------------------
+//	A neighbor loop summing the neighbor indices and the kernel gradients.
+//----------------------------------------------------------------------
+template <typename... RelationTypes>
+class NeighborLoopSum;
+
+template <typename... Parameters>
+class NeighborLoopSum<Inner<Parameters...>> : public Interaction<Inner<Parameters...>>
+{
+    using BaseInteraction = Interaction<Inner<Parameters...>>;
+
+  public:
+    NeighborLoopSum(Relation<Inner<Parameters...>> &inner_relation, const std::string &suffix)
+        : BaseInteraction(inner_relation),
+          dv_index_sum_(this->particles_->template registerDiscreteVariableOnly<UnsignedInt>(
+              "NeighborIndexSum" + suffix, this->particles_->ParticlesBound())),
+          dv_gradient_sum_(this->particles_->template registerStateVariableOnly<Vecd>("KernelGradientSum" + suffix)) {};
+    virtual ~NeighborLoopSum() {};
+
+    class InteractKernel : public BaseInteraction::InteractKernel
+    {
+      public:
+        template <class ExecutionPolicy, class EncloserType>
+        InteractKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser)
+            : BaseInteraction::InteractKernel(ex_policy, encloser),
+              index_sum_(encloser.dv_index_sum_->DelegatedData(ex_policy)),
+              gradient_sum_(encloser.dv_gradient_sum_->DelegatedData(ex_policy)) {};
+        void interact(size_t index_i, Real dt = 0.0)
+        {
+            UnsignedInt index_sum = 0;
+            Vecd gradient_sum = Vecd::Zero();
+            this->forEachNeighbor(
+                index_i,
+                [&](UnsignedInt index_j)
+                {
+                    index_sum += index_j;
+                    gradient_sum += this->dW_ij(index_i, index_j) * this->e_ij(index_i, index_j);
+                });
+            index_sum_[index_i] = index_sum;
+            gradient_sum_[index_i] = gradient_sum;
+        };
+
+      protected:
+        UnsignedInt *index_sum_;
+        Vecd *gradient_sum_;
+    };
+
+  protected:
+    DiscreteVariable<UnsignedInt> *dv_index_sum_;
+    DiscreteVariable<Vecd> *dv_gradient_sum_;
+};
+//----------------------------------------------------------------------
+//	Compare the full-width and compressed neighbor lists.
+//----------------------------------------------------------------------
+void testCompressedNeighborList(bool is_sorted)
+{
+    SPHSystem sph_system(system_domain_bounds, particle_spacing);
+    Vec3d halfsize(0.5 * block_width, 0.5 * block_width, 0.5 * block_width);
+    GeometricShapeBox block_shape(Transform(halfsize), halfsize, "Block");
+    RealBody block(sph_system, block_shape);
+    block.generateParticles<BaseParticles, Lattice>();
+
+    BaseParticles &particles = block.getBaseParticles();
+    size_t total_real_particles = particles.TotalRealParticles();
+    Vecd *pos = particles.ParticlePositions();
+    std::mt19937 random_engine(1);
+    std::shuffle(pos, pos + total_real_particles, random_engine);
+
+    Relation<Inner<>> full_inner(block);
+    Relation<Inner<>> compressed_inner(block);
+    compressed_inner.enableCompressedNeighborList();
+    ParticleSortCK<MainExecutionPolicy> particle_sort(block);
+    UpdateCellLinkedList<MainExecutionPolicy, CellLinkedList> block_cell_linked_list(block);
+    UpdateRelation<MainExecutionPolicy, Inner<>> full_update_relation(full_inner);
+    UpdateRelation<MainExecutionPolicy, Inner<>> compressed_update_relation(compressed_inner);
+    InteractionDynamicsCK<MainExecutionPolicy, NeighborLoopSum<Inner<>>> full_neighbor_loop(full_inner, "Full");
+    InteractionDynamicsCK<MainExecutionPolicy, NeighborLoopSum<Inner<>>> compressed_neighbor_loop(compressed_inner, "Compressed");
+
+    if (is_sorted)
+        particle_sort.exec();
+    block_cell_linked_list.exec();
+    full_update_relation.exec();
+    compressed_update_relation.exec();
+    ASSERT_TRUE(compressed_inner.isNeighborListCompressed());
+    ASSERT_FALSE(full_inner.isNeighborListCompressed());
+
+    TickCount time_instance = TickCount::now();
+    for (size_t k = 0; k != number_of_loops; ++k)
+        full_neighbor_loop.exec();
+    TimeInterval full_loop_time = TickCount::now() - time_instance;
+    time_instance = TickCount::now();
+    for (size_t k = 0; k != number_of_loops; ++k)
+        compressed_neighbor_loop.exec();
+    TimeInterval compressed_loop_time = TickCount::now() - time_instance;
+
+    UnsignedInt *full_index_sum = particles.getVariableDataByName<UnsignedInt>("NeighborIndexSumFull");
+    UnsignedInt *compressed_index_sum = particles.getVariableDataByName<UnsignedInt>("NeighborIndexSumCompressed");
+    Vecd *full_gradient_sum = particles.getVariableDataByName<Vecd>("KernelGradientSumFull");
+    Vecd *compressed_gradient_sum = particles.getVariableDataByName<Vecd>("KernelGradientSumCompressed");
+    for (size_t i = 0; i != total_real_particles; ++i)
+    {
+        ASSERT_EQ(full_index_sum[i], compressed_index_sum[i]);
+        ASSERT_EQ(full_gradient_sum[i], compressed_gradient_sum[i]);
+    }
+
+    size_t full_bytes = full_inner.NeighborListBytes();
+    size_t compressed_bytes = compressed_inner.CompressedNeighborListBytes();
+    EXPECT_EQ(full_bytes, compressed_inner.NeighborListBytes());
+    if (is_sorted)
+    {
+        EXPECT_LT(Real(compressed_bytes), 0.6 * Real(full_bytes));
+    }
+    std::cout << (is_sorted ? "Sorted" : "Unsorted") << " particles, "
+              << "full neighbor list: " << full_bytes << " bytes, " << full_loop_time.seconds() << " seconds, "
+              << "compressed neighbor list: " << compressed_bytes << " bytes, "
+              << compressed_loop_time.seconds() << " seconds." << std::endl;
+}
+//----------------------------------------------------------------------
+//	Main program starts here.
+//----------------------------------------------------------------------
+TEST(CompressedNeighborListCK, UnsortedParticles)
+{
+    testCompressedNeighborList(false);
+}
+
+TEST(CompressedNeighborListCK, SortedParticles)
+{
+    testCompressedNeighborList(true);
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
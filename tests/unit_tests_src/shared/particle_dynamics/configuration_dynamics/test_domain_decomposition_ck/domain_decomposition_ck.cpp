@@ -0,0 +1,162 @@
+/**
+ * @file 	domain_decomposition_ck.cpp
+ * @brief 	test the shared-memory domain decomposition of a fluid body
+ * @details A water block with an initial compressing velocity field is integrated
+ *			on two slab-decomposed ranks and in a single process.
+ *			The particle positions of the two runs should agree up to round-off errors.
+ * @author 	Xiangyu Hu
+ */
+#include "sphinxsys_ck.h"
+#include <gtest/gtest.h>
+using namespace SPH;
+//----------------------------------------------------------------------
+//	Basic geometry parameters and numerical setup.
+//----------------------------------------------------------------------
+Real block_width = 2.0;
+Real block_height = 0.5;
+Real particle_spacing = 0.02;
+Real rho0_f = 1.0;
+Real gravity_g = 1.0;
+Real U_ref = 0.2;
+Real c_f = 10.0 * U_ref;
+size_t number_of_ranks = 2;
+size_t number_of_steps = 200;
+size_t max_number_of_particles =
+    size_t(block_width / particle_spacing + 1) * size_t(block_height / particle_spacing + 1);
+BoundingBox system_domain_bounds(Vec2d(-block_width, -block_width), Vec2d(2.0 * block_width, block_width));
+//----------------------------------------------------------------------
+//	Run the case and write the positions by original ids.
+//----------------------------------------------------------------------
+using MainExecutionPolicy = execution::ParallelPolicy;
+void runWaterBlock(Vecd *positions, SharedMemoryCommunicator *communicator = nullptr)
+{
+    SPHSystem sph_system(system_domain_bounds, particle_spacing);
+    GeometricShapeBox block_shape(Transform(Vec2d(0.5 * block_width, 0.5 * block_height)),
+                                  Vec2d(0.5 * block_width, 0.5 * block_height), "WaterBody");
+    FluidBody water_block(sph_system, block_shape);
+    water_block.defineMaterial<WeaklyCompressibleFluid>(rho0_f, c_f);
+    water_block.generateParticles<BaseParticles, Lattice>();
+
+    Gravity gravity(Vecd(0.0, -gravity_g));
+    Relation<Inner<>> water_block_inner(water_block);
+    UpdateCellLinkedList<MainExecutionPolicy, CellLinkedList> water_cell_linked_list(water_block);
+    UpdateRelation<MainExecutionPolicy, Inner<>> water_block_update_inner_relation(water_block_inner);
+    ParticleSortCK<MainExecutionPolicy> particle_sort(water_block);
+    StateDynamics<MainExecutionPolicy, GravityForceCK<Gravity>> constant_gravity(water_block, gravity);
+    StateDynamics<MainExecutionPolicy, fluid_dynamics::AdvectionStepSetup> water_advection_step_setup(water_block);
+    StateDynamics<MainExecutionPolicy, fluid_dynamics::AdvectionStepClose> water_advection_step_close(water_block);
+    InteractionDynamicsCK<MainExecutionPolicy, fluid_dynamics::AcousticStep1stHalf<
+                                                   Inner<OneLevel, AcousticRiemannSolverCK, NoKernelCorrectionCK>>>
+        fluid_acoustic_step_1st_half(water_block_inner);
+    InteractionDynamicsCK<MainExecutionPolicy, fluid_dynamics::AcousticStep2ndHalf<
+                                                   Inner<OneLevel, AcousticRiemannSolverCK, NoKernelCorrectionCK>>>
+        fluid_acoustic_step_2nd_half(water_block_inner);
+
+    BaseParticles &particles = water_block.getBaseParticles();
+    Vecd *pos = particles.ParticlePositions();
+    Vecd *vel = particles.getVariableDataByName<Vecd>("Velocity");
+    for (size_t i = 0; i != particles.TotalRealParticles(); ++i)
+    {
+        vel[i] = Vecd(-U_ref * sin(2.0 * Pi * pos[i][0] / block_width), 0.0);
+    }
+
+    UniquePtrKeeper<SlabDecomposition> slab_decomposition_keeper;
+    UniquePtrKeeper<ParticleExchangeCK> particle_exchange_keeper;
+    ParticleExchangeCK *particle_exchange = nullptr;
+    if (communicator != nullptr)
+    {
+        SlabDecomposition *slab_decomposition = slab_decomposition_keeper.createPtr<SlabDecomposition>(
+            system_domain_bounds, communicator->NumberOfRanks());
+        particle_exchange = particle_exchange_keeper.createPtr<ParticleExchangeCK>(
+            water_block, *slab_decomposition, *communicator);
+        particle_exchange->addVariable<Real>("Mass");
+        particle_exchange->addVariable<Real>("Density");
+        particle_exchange->addVariable<Real>("DensityChangeRate");
+        particle_exchange->addVariable<Real>("VolumetricMeasure");
+        particle_exchange->addVariable<Vecd>("ForcePrior");
+        // all ranks hold the whole body before initialization
+        particle_exchange->rebalance();
+        particle_exchange->initialize();
+    }
+
+    constant_gravity.exec();
+    water_cell_linked_list.exec();
+    water_block_update_inner_relation.exec();
+
+    Real dt = 0.1 * particle_spacing / c_f;
+    for (size_t n = 0; n != number_of_steps; ++n)
+    {
+        water_advection_step_setup.exec();
+        fluid_acoustic_step_1st_half.exec(dt);
+        if (particle_exchange != nullptr)
+            particle_exchange->updateHaloStates();
+        fluid_acoustic_step_2nd_half.exec(dt);
+        water_advection_step_close.exec();
+
+        if (particle_exchange != nullptr)
+            particle_exchange->exec();
+        if (n % 20 == 0)
+            particle_sort.exec();
+        water_cell_linked_list.exec();
+        water_block_update_inner_relation.exec();
+    }
+
+    UnsignedInt *original_id = particles.ParticleOriginalIds();
+    size_t number_of_owned_particles =
+        particle_exchange != nullptr ? particle_exchange->NumberOfOwnedParticles() : particles.TotalRealParticles();
+    StdVec<bool> is_owned(particles.ParticlesBound(), particle_exchange == nullptr);
+    if (particle_exchange != nullptr)
+    {
+        SlabDecomposition *slab_decomposition = slab_decomposition_keeper.getPtr();
+        for (size_t i = 0; i != particles.TotalRealParticles(); ++i)
+            is_owned[i] = slab_decomposition->SlabIndex(pos[i]) == communicator->Rank();
+    }
+    size_t number_of_written_particles = 0;
+    for (size_t i = 0; i != particles.TotalRealParticles(); ++i)
+    {
+        if (is_owned[i])
+        {
+            positions[original_id[i]] = pos[i];
+            number_of_written_particles++;
+        }
+    }
+    if (number_of_written_particles != number_of_owned_particles)
+    {
+        std::cout << "\n Error: owned particles are not consistent!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+}
+//----------------------------------------------------------------------
+//	Main program starts here.
+//----------------------------------------------------------------------
+size_t number_of_failed_ranks = 0;
+Real max_position_difference = MaxReal;
+TEST(DomainDecomposition, ParticleExchange)
+{
+    EXPECT_EQ(number_of_failed_ranks, size_t(0));
+    EXPECT_LT(max_position_difference, 1.0e-6 * particle_spacing);
+};
+
+int main(int ac, char *av[])
+{
+    // the ranks are forked before any thread is started
+    SharedMemoryCommunicator communicator(number_of_ranks);
+    SharedMemorySegment decomposed_result("DecomposedResult", max_number_of_particles * sizeof(Vecd));
+    Vecd *decomposed_positions = static_cast<Vecd *>(decomposed_result.Data());
+    number_of_failed_ranks = communicator.runOnRanks(
+        [&](size_t)
+        { runWaterBlock(decomposed_positions, &communicator); },
+        false);
+
+    StdVec<Vecd> positions(max_number_of_particles, Vecd::Zero());
+    runWaterBlock(positions.data());
+    max_position_difference = 0.0;
+    for (size_t i = 0; i != max_number_of_particles; ++i)
+    {
+        max_position_difference = SMAX(max_position_difference, (positions[i] - decomposed_positions[i]).norm());
+    }
+
+    testing::InitGoogleTest(&ac, av);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,190 @@
+/**
+ * @file 	2d_implicit_viscous_force.cpp
+ * @brief 	test the implicit viscous step with the start-up of a highly viscous Poiseuille flow
+ * @details The fluid particles between two walls are fixed and driven by a body force.
+ *			The velocity is integrated with the implicit viscous step using a time step
+ *			far beyond the viscous limit and with the explicit viscous force at the viscous limit.
+ *			Both should give the steady parabolic profile in the middle of the channel.
+ *			The wall-clock times of both are given for comparison.
+ * @author 	Xiangyu Hu
+ */
+#include "sphinxsys_ck.h"
+#include <gtest/gtest.h>
+using namespace SPH;
+//----------------------------------------------------------------------
+//	Basic geometry parameters and numerical setup.
+//----------------------------------------------------------------------
+Real width = 1.0;
+Real height = 0.5;
+Real particle_spacing = 0.025;
+Real boundary_width = particle_spacing * 4;
+//----------------------------------------------------------------------
+//	Material parameters.
+//----------------------------------------------------------------------
+Real rho0_f = 1.0;
+Real mu_f = 100.0;
+Real gravity_g = 800.0;
+Real U_max = gravity_g * height * height / (8.0 * mu_f / rho0_f);
+Real c_f = 10.0 * U_max;
+//----------------------------------------------------------------------
+//	Complex shapes.
+//----------------------------------------------------------------------
+class WallBoundary : public ComplexShape
+{
+  public:
+    explicit WallBoundary(const std::string &shape_name) : ComplexShape(shape_name)
+    {
+        Vecd scaled_container_outer(0.5 * width + boundary_width, 0.5 * height + boundary_width);
+        Vecd scaled_container(0.5 * width + 2.0 * boundary_width, 0.5 * height);
+        Transform translate_to_origin_outer(Vec2d(-boundary_width, -boundary_width) + scaled_container_outer);
+        Transform translate_to_origin_inner(Vec2d(-boundary_width, 0.0) + scaled_container);
+
+        add<GeometricShapeBox>(Transform(translate_to_origin_outer), scaled_container_outer);
+        subtract<GeometricShapeBox>(Transform(translate_to_origin_inner), scaled_container);
+    }
+};
+class WaterBlock : public ComplexShape
+{
+  public:
+    explicit WaterBlock(const std::string &shape_name) : ComplexShape(shape_name)
+    {
+        Vecd scaled_container(0.5 * width, 0.5 * height);
+        Transform translate_to_origin(scaled_container);
+        add<GeometricShapeBox>(Transform(translate_to_origin), scaled_container);
+    }
+};
+//----------------------------------------------------------------------
+//	Error of the steady profile away from the free ends of the channel.
+//----------------------------------------------------------------------
+Real profileError(BaseParticles &particles)
+{
+    Vecd *pos = particles.ParticlePositions();
+    Vecd *vel = particles.getVariableDataByName<Vecd>("Velocity");
+    Real max_error = 0.0;
+    for (size_t i = 0; i != particles.TotalRealParticles(); ++i)
+    {
+        if (ABS(pos[i][0] - 0.5 * width) < 0.1 * width)
+        {
+            Real y = pos[i][1];
+            Real analytical = 0.5 * gravity_g * rho0_f / mu_f * y * (height - y);
+            max_error = SMAX(max_error, (vel[i] - Vecd(analytical, 0.0)).norm() / U_max);
+        }
+    }
+    return max_error;
+}
+//----------------------------------------------------------------------
+//	Main program starts here.
+//----------------------------------------------------------------------
+using MainExecutionPolicy = execution::ParallelPolicy;
+Real implicit_error = MaxReal;
+Real explicit_error = MaxReal;
+Real max_relative_residual = MaxReal;
+TEST(ImplicitViscousForceCK, PoiseuilleFlow)
+{
+    EXPECT_LT(implicit_error, 0.05);
+    EXPECT_LT(ABS(implicit_error - explicit_error), 0.01);
+    EXPECT_LT(max_relative_residual, 1.0e-6);
+    std::cout << "Implicit profile error: " << implicit_error << " and "
+              << "explicit profile error: " << explicit_error << std::endl;
+};
+
+int main(int ac, char *av[])
+{
+    BoundingBox system_domain_bounds(Vecd(-boundary_width * 2, -boundary_width * 2),
+                                     Vecd(width + boundary_width * 2, height + boundary_width * 2));
+    SPHSystem sph_system(system_domain_bounds, particle_spacing);
+    sph_system.handleCommandlineOptions(ac, av)->setIOEnvironment();
+
+    FluidBody implicit_water(sph_system, makeShared<WaterBlock>("ImplicitWater"));
+    implicit_water.defineClosure<WeaklyCompressibleFluid, Viscosity>(ConstructArgs(rho0_f, c_f), mu_f);
+    implicit_water.generateParticles<BaseParticles, Lattice>();
+    FluidBody explicit_water(sph_system, makeShared<WaterBlock>("ExplicitWater"));
+    explicit_water.defineClosure<WeaklyCompressibleFluid, Viscosity>(ConstructArgs(rho0_f, c_f), mu_f);
+    explicit_water.generateParticles<BaseParticles, Lattice>();
+    SolidBody wall_boundary(sph_system, makeShared<WallBoundary>("WallBoundary"));
+    wall_boundary.defineMaterial<Solid>();
+    wall_boundary.generateParticles<BaseParticles, Lattice>();
+    implicit_water.getBaseParticles().registerStateVariableOnly<Vecd>("Velocity");
+    explicit_water.getBaseParticles().registerStateVariableOnly<Vecd>("Velocity");
+
+    Relation<Inner<>> implicit_water_inner(implicit_water);
+    Relation<Contact<>> implicit_water_wall_contact(implicit_water, {&wall_boundary});
+    Relation<Inner<>> explicit_water_inner(explicit_water);
+    Relation<Contact<>> explicit_water_wall_contact(explicit_water, {&wall_boundary});
+
+    UpdateCellLinkedList<MainExecutionPolicy, CellLinkedList> implicit_water_cell_linked_list(implicit_water);
+    UpdateCellLinkedList<MainExecutionPolicy, CellLinkedList> explicit_water_cell_linked_list(explicit_water);
+    UpdateCellLinkedList<MainExecutionPolicy, CellLinkedList> wall_cell_linked_list(wall_boundary);
+    UpdateRelation<MainExecutionPolicy, Inner<>, Contact<>>
+        implicit_water_update_complex_relation(implicit_water_inner, implicit_water_wall_contact);
+    UpdateRelation<MainExecutionPolicy, Inner<>, Contact<>>
+        explicit_water_update_complex_relation(explicit_water_inner, explicit_water_wall_contact);
+    StateDynamics<MainExecutionPolicy, NormalFromBodyShapeCK> wall_boundary_normal_direction(wall_boundary);
+
+    fluid_dynamics::ImplicitViscousForceWithWallCK<MainExecutionPolicy>
+        implicit_viscous_force(implicit_water_inner, implicit_water_wall_contact);
+    InteractionDynamicsCK<MainExecutionPolicy, fluid_dynamics::ViscousForceWithWallCK>
+        explicit_viscous_force(explicit_water_inner, explicit_water_wall_contact);
+
+    wall_boundary_normal_direction.exec();
+    implicit_water_cell_linked_list.exec();
+    explicit_water_cell_linked_list.exec();
+    wall_cell_linked_list.exec();
+    implicit_water_update_complex_relation.exec();
+    explicit_water_update_complex_relation.exec();
+
+    Real end_time = rho0_f * height * height / mu_f;
+    Real h_ref = implicit_water.getSPHAdaptation().ReferenceSmoothingLength();
+    Real explicit_dt = 0.25 * rho0_f * h_ref * h_ref / mu_f;
+    size_t implicit_steps = 20;
+    Real implicit_dt = end_time / Real(implicit_steps);
+    std::cout << "Implicit time step is " << implicit_dt / explicit_dt
+              << " times the viscous limit." << std::endl;
+
+    // the body force is added before the viscous step, which is then exact for the steady state
+    TickCount time_instance = TickCount::now();
+    BaseParticles &implicit_particles = implicit_water.getBaseParticles();
+    Vecd *implicit_vel = implicit_particles.getVariableDataByName<Vecd>("Velocity");
+    Vecd *implicit_force = implicit_particles.getVariableDataByName<Vecd>("ViscousForce");
+    Real *implicit_mass = implicit_particles.getVariableDataByName<Real>("Mass");
+    max_relative_residual = 0.0;
+    for (size_t n = 0; n != implicit_steps; ++n)
+    {
+        for (size_t i = 0; i != implicit_particles.TotalRealParticles(); ++i)
+            implicit_vel[i][0] += gravity_g * implicit_dt;
+        implicit_viscous_force.exec(implicit_dt);
+        max_relative_residual = SMAX(max_relative_residual, implicit_viscous_force.RelativeResidual());
+        for (size_t i = 0; i != implicit_particles.TotalRealParticles(); ++i)
+            implicit_vel[i] += implicit_force[i] * implicit_dt / implicit_mass[i];
+    }
+    TimeInterval implicit_time = TickCount::now() - time_instance;
+    std::cout << "Conjugate gradient iterations of the last step: "
+              << implicit_viscous_force.NumberOfIterations() << std::endl;
+
+    time_instance = TickCount::now();
+    BaseParticles &explicit_particles = explicit_water.getBaseParticles();
+    Vecd *explicit_vel = explicit_particles.getVariableDataByName<Vecd>("Velocity");
+    Vecd *explicit_force = explicit_particles.getVariableDataByName<Vecd>("ViscousForce");
+    Real *explicit_mass = explicit_particles.getVariableDataByName<Real>("Mass");
+    size_t explicit_steps = size_t(end_time / explicit_dt) + 1;
+    explicit_dt = end_time / Real(explicit_steps);
+    for (size_t n = 0; n != explicit_steps; ++n)
+    {
+        explicit_viscous_force.exec();
+        for (size_t i = 0; i != explicit_particles.TotalRealParticles(); ++i)
+        {
+            explicit_vel[i] += explicit_force[i] * explicit_dt / explicit_mass[i];
+            explicit_vel[i][0] += gravity_g * explicit_dt;
+        }
+    }
+    TimeInterval explicit_time = TickCount::now() - time_instance;
+    std::cout << "Implicit stepping: " << implicit_time.seconds() << " seconds with " << implicit_steps << " steps, "
+              << "explicit stepping: " << explicit_time.seconds() << " seconds with " << explicit_steps << " steps."
+              << std::endl;
+
+    implicit_error = profileError(implicit_particles);
+    explicit_error = profileError(explicit_particles);
+
+    testing::InitGoogleTest(&ac, av);
+    return RUN_ALL_TESTS();
+}
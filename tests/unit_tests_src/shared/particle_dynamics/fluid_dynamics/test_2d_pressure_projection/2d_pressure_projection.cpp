@@ -0,0 +1,154 @@
+/**
+ * @file 	2d_pressure_projection.cpp
+ * @brief 	test the pressure projection with the hydrostatic pressure in an open tank
+ * @details The water at rest in a tank with open top is integrated with the pressure projection
+ *			using the advection time step, which is far beyond the acoustic time step.
+ *			The pressure gradient should balance the gravity and the water should stay at rest.
+ * @author 	Xiangyu Hu
+ */
+#include "sphinxsys_ck.h"
+#include <gtest/gtest.h>
+using namespace SPH;
+//----------------------------------------------------------------------
+//	Basic geometry parameters and numerical setup.
+//----------------------------------------------------------------------
+Real DL = 1.0;
+Real DH = 0.5;
+Real particle_spacing = 0.02;
+Real BW = particle_spacing * 4;
+//----------------------------------------------------------------------
+//	Material parameters.
+//----------------------------------------------------------------------
+Real rho0_f = 1.0;
+Real gravity_g = 1.0;
+Real U_ref = 2.0 * sqrt(gravity_g * DH);
+Real c_f = 10.0 * U_ref;
+//----------------------------------------------------------------------
+//	Complex shapes.
+//----------------------------------------------------------------------
+class WallBoundary : public ComplexShape
+{
+  public:
+    explicit WallBoundary(const std::string &shape_name) : ComplexShape(shape_name)
+    {
+        Vecd outer_halfsize(0.5 * DL + BW, 0.5 * DH + BW);
+        Vecd inner_halfsize(0.5 * DL, 0.5 * DH + BW);
+        add<GeometricShapeBox>(Transform(Vecd(0.5 * DL, 0.5 * DH)), outer_halfsize);
+        subtract<GeometricShapeBox>(Transform(Vecd(0.5 * DL, 0.5 * DH + BW)), inner_halfsize);
+    }
+};
+class WaterBlock : public ComplexShape
+{
+  public:
+    explicit WaterBlock(const std::string &shape_name) : ComplexShape(shape_name)
+    {
+        Vecd halfsize(0.5 * DL, 0.5 * DH);
+        add<GeometricShapeBox>(Transform(halfsize), halfsize);
+    }
+};
+//----------------------------------------------------------------------
+//	Least-square slope of the pressure over the height in the middle of the tank.
+//----------------------------------------------------------------------
+Real pressureSlope(BaseParticles &particles)
+{
+    Vecd *pos = particles.ParticlePositions();
+    Real *p = particles.getVariableDataByName<Real>("Pressure");
+    Real sum_y = 0.0, sum_p = 0.0, sum_yy = 0.0, sum_yp = 0.0, count = 0.0;
+    for (size_t i = 0; i != particles.TotalRealParticles(); ++i)
+    {
+        if (ABS(pos[i][0] - 0.5 * DL) < 0.25 * DL && pos[i][1] > 0.2 * DH && pos[i][1] < 0.7 * DH)
+        {
+            sum_y += pos[i][1];
+            sum_p += p[i];
+            sum_yy += pos[i][1] * pos[i][1];
+            sum_yp += pos[i][1] * p[i];
+            count += 1.0;
+        }
+    }
+    return (count * sum_yp - sum_y * sum_p) / (count * sum_yy - sum_y * sum_y);
+}
+//----------------------------------------------------------------------
+//	Main program starts here.
+//----------------------------------------------------------------------
+using MainExecutionPolicy = execution::ParallelPolicy;
+Real slope_error = MaxReal;
+Real max_speed = MaxReal;
+Real max_relative_residual = MaxReal;
+TEST(PressureProjectionCK, HydrostaticPressure)
+{
+    EXPECT_LT(slope_error, 0.05);
+    EXPECT_LT(max_speed, 0.02 * U_ref);
+    EXPECT_LT(max_relative_residual, 1.0e-6);
+    std::cout << "Hydrostatic slope error: " << slope_error << " and "
+              << "maximum speed: " << max_speed << std::endl;
+};
+
+int main(int ac, char *av[])
+{
+    BoundingBox system_domain_bounds(Vecd(-BW * 2, -BW * 2), Vecd(DL + BW * 2, DH + BW * 2));
+    SPHSystem sph_system(system_domain_bounds, particle_spacing);
+    sph_system.handleCommandlineOptions(ac, av)->setIOEnvironment();
+
+    FluidBody water_block(sph_system, makeShared<WaterBlock>("WaterBody"));
+    water_block.defineMaterial<WeaklyCompressibleFluid>(rho0_f, c_f);
+    water_block.generateParticles<BaseParticles, Lattice>();
+    SolidBody wall_boundary(sph_system, makeShared<WallBoundary>("WallBoundary"));
+    wall_boundary.defineMaterial<Solid>();
+    wall_boundary.generateParticles<BaseParticles, Lattice>();
+
+    Relation<Inner<>> water_block_inner(water_block);
+    Relation<Contact<>> water_wall_contact(water_block, {&wall_boundary});
+
+    UpdateCellLinkedList<MainExecutionPolicy, CellLinkedList> water_cell_linked_list(water_block);
+    UpdateCellLinkedList<MainExecutionPolicy, CellLinkedList> wall_cell_linked_list(wall_boundary);
+    UpdateRelation<MainExecutionPolicy, Inner<>, Contact<>>
+        water_block_update_complex_relation(water_block_inner, water_wall_contact);
+
+    Gravity gravity(Vecd(0.0, -gravity_g));
+    StateDynamics<MainExecutionPolicy, GravityForceCK<Gravity>> constant_gravity(water_block, gravity);
+    StateDynamics<MainExecutionPolicy, NormalFromBodyShapeCK> wall_boundary_normal_direction(wall_boundary);
+    StateDynamics<MainExecutionPolicy, fluid_dynamics::AdvectionStepSetup> water_advection_step_setup(water_block);
+    StateDynamics<MainExecutionPolicy, fluid_dynamics::AdvectionStepClose> water_advection_step_close(water_block);
+    InteractionDynamicsCK<MainExecutionPolicy, fluid_dynamics::FreeSurfaceIndicationComplexSpatialTemporalCK>
+        fluid_boundary_indicator(water_block_inner, water_wall_contact);
+    fluid_dynamics::PressureProjectionWithWallCK<MainExecutionPolicy>
+        pressure_projection(water_block_inner, water_wall_contact);
+
+    wall_boundary_normal_direction.exec();
+    constant_gravity.exec();
+    water_cell_linked_list.exec();
+    wall_cell_linked_list.exec();
+    water_block_update_complex_relation.exec();
+
+    Real h_ref = water_block.getSPHAdaptation().ReferenceSmoothingLength();
+    Real advection_dt = 0.25 * h_ref / U_ref;
+    Real acoustic_dt = 0.6 * h_ref / (c_f + U_ref);
+    std::cout << "Projection time step is " << advection_dt / acoustic_dt
+              << " times the acoustic time step." << std::endl;
+
+    BaseParticles &water_particles = water_block.getBaseParticles();
+    Vecd *vel = water_particles.getVariableDataByName<Vecd>("Velocity");
+    size_t number_of_steps = 20;
+    max_relative_residual = 0.0;
+    for (size_t n = 0; n != number_of_steps; ++n)
+    {
+        water_advection_step_setup.exec();
+        fluid_boundary_indicator.exec();
+        pressure_projection.exec(advection_dt);
+        max_relative_residual = SMAX(max_relative_residual, pressure_projection.RelativeResidual());
+        water_advection_step_close.exec();
+
+        water_cell_linked_list.exec();
+        water_block_update_complex_relation.exec();
+    }
+    std::cout << "Conjugate gradient iterations of the last step: "
+              << pressure_projection.NumberOfIterations() << std::endl;
+
+    slope_error = ABS(pressureSlope(water_particles) + rho0_f * gravity_g) / (rho0_f * gravity_g);
+    max_speed = 0.0;
+    for (size_t i = 0; i != water_particles.TotalRealParticles(); ++i)
+        max_speed = SMAX(max_speed, vel[i].norm());
+
+    testing::InitGoogleTest(&ac, av);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,116 @@
+/**
+ * @file 	2d_riemann_solver_batch.cpp
+ * @brief 	test the batched Riemann solvers for compressible flows against the scalar ones
+ * @details Random left and right states are evaluated pair by pair with getInterfaceState
+ *			and block by block with getInterfaceStates. The interface states should agree
+ *			up to the round-off from the different instruction ordering.
+ * @author 	Xiangyu Hu
+ */
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+#include <random>
+using namespace SPH;
+//----------------------------------------------------------------------
+//	Random states of particle pairs.
+//----------------------------------------------------------------------
+Real heat_capacity_ratio = 1.4;
+size_t number_of_batches = 1000;
+Real tolerance = 1.0e-12;
+
+struct PairStates
+{
+    Real rho_i_, p_i_, E_i_, rho_j_, p_j_, E_j_;
+    Vecd vel_i_, vel_j_, e_ij_;
+};
+
+PairStates randomPairStates(std::mt19937 &generator)
+{
+    std::uniform_real_distribution<Real> positive(0.1, 2.0);
+    std::uniform_real_distribution<Real> signed_unit(-1.0, 1.0);
+    PairStates states;
+    states.rho_i_ = positive(generator);
+    states.p_i_ = positive(generator);
+    states.rho_j_ = positive(generator);
+    states.p_j_ = positive(generator);
+    states.vel_i_ = Vecd(signed_unit(generator), signed_unit(generator));
+    states.vel_j_ = Vecd(signed_unit(generator), signed_unit(generator));
+    Real angle = Pi * signed_unit(generator);
+    states.e_ij_ = Vecd(cos(angle), sin(angle));
+    states.E_i_ = states.p_i_ / (heat_capacity_ratio - 1.0) + 0.5 * states.rho_i_ * states.vel_i_.squaredNorm();
+    states.E_j_ = states.p_j_ / (heat_capacity_ratio - 1.0) + 0.5 * states.rho_j_ * states.vel_j_.squaredNorm();
+    return states;
+}
+
+void expectEqualState(Real batched, Real scalar)
+{
+    if (std::isnan(scalar))
+    {
+        EXPECT_TRUE(std::isnan(batched));
+    }
+    else
+    {
+        EXPECT_NEAR(batched, scalar, tolerance * SMAX(Real(1), ABS(scalar)));
+    }
+}
+//----------------------------------------------------------------------
+//	Compare the batched solver with the scalar one over random blocks.
+//----------------------------------------------------------------------
+template <class RiemannSolverType>
+void compareBatchedWithScalar()
+{
+    CompressibleFluid compressible_fluid(1.0, heat_capacity_ratio);
+    RiemannSolverType riemann_solver(compressible_fluid, compressible_fluid);
+    std::mt19937 generator(12345);
+    for (size_t n = 0; n != number_of_batches; ++n)
+    {
+        CompressibleFluidStateBatch batch;
+        StdVec<PairStates> pair_states;
+        batch.size_ = 1 + n % CompressibleFluidStateBatch::capacity_;
+        for (size_t k = 0; k != batch.size_; ++k)
+        {
+            pair_states.push_back(randomPairStates(generator));
+            PairStates &states = pair_states.back();
+            CompressibleFluidState state_i(states.rho_i_, states.vel_i_, states.p_i_, states.E_i_);
+            CompressibleFluidState state_j(states.rho_j_, states.vel_j_, states.p_j_, states.E_j_);
+            batch.setPair(k, state_i, state_j, states.e_ij_);
+        }
+        riemann_solver.getInterfaceStates(batch);
+
+        for (size_t k = 0; k != batch.size_; ++k)
+        {
+            PairStates &states = pair_states[k];
+            CompressibleFluidState state_i(states.rho_i_, states.vel_i_, states.p_i_, states.E_i_);
+            CompressibleFluidState state_j(states.rho_j_, states.vel_j_, states.p_j_, states.E_j_);
+            CompressibleFluidStarState scalar = riemann_solver.getInterfaceState(state_i, state_j, states.e_ij_);
+            CompressibleFluidStarState batched = batch.InterfaceState(k);
+            expectEqualState(batched.rho_, scalar.rho_);
+            expectEqualState(batched.p_, scalar.p_);
+            expectEqualState(batched.E_, scalar.E_);
+            for (int d = 0; d != Dimensions; ++d)
+            {
+                expectEqualState(batched.vel_[d], scalar.vel_[d]);
+            }
+        }
+    }
+}
+
+TEST(RiemannSolverBatch, NoRiemannSolver)
+{
+    compareBatchedWithScalar<NoRiemannSolverInCompressibleEulerianMethod>();
+}
+
+TEST(RiemannSolverBatch, HLLCRiemannSolver)
+{
+    compareBatchedWithScalar<HLLCRiemannSolver>();
+}
+
+TEST(RiemannSolverBatch, HLLCWithLimiterRiemannSolver)
+{
+    compareBatchedWithScalar<HLLCWithLimiterRiemannSolver>();
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
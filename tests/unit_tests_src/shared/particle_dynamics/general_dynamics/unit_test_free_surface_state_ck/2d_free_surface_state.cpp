@@ -0,0 +1,230 @@
+/**
+ * @file 	2d_free_surface_state.cpp
+ * @brief 	test the fused free-surface state with computing kernels
+ * @details The surface indicator is compared with that of the spatial-temporal
+ *			free-surface indication on the same perturbed water block above a wall.
+ *			The normal, curvature and surface tension force are checked on a circular droplet and
+ *			the smeared-surface density regularization on a static water block.
+ * @author 	Xiangyu Hu
+ */
+#include "sphinxsys_ck.h"
+#include <gtest/gtest.h>
+using namespace SPH;
+//----------------------------------------------------------------------
+//	Basic geometry parameters and numerical setup.
+//----------------------------------------------------------------------
+Real water_width = 1.0;
+Real water_height = 0.5;
+Real droplet_radius = 0.5;
+Real particle_spacing = 0.02;
+Real wall_thickness = 4.0 * particle_spacing;
+Real rho0_f = 1.0;
+Real c_f = 10.0;
+Real surface_tension_coeff = 1.0;
+BoundingBox system_domain_bounds(Vec2d(-1.0, -1.0), Vec2d(2.0, 2.0));
+using MainExecutionPolicy = execution::SequencedPolicy;
+//----------------------------------------------------------------------
+//	Bodies used in the tests.
+//----------------------------------------------------------------------
+class WaterBlock : public FluidBody
+{
+  public:
+    WaterBlock(SPHSystem &sph_system, const std::string &name)
+        : FluidBody(sph_system, makeShared<GeometricShapeBox>(
+                                    Transform(Vec2d(0.5 * water_width, 0.5 * water_height)),
+                                    Vec2d(0.5 * water_width, 0.5 * water_height), name))
+    {
+        defineMaterial<WeaklyCompressibleFluid>(rho0_f, c_f);
+        generateParticles<BaseParticles, Lattice>();
+    };
+};
+
+void perturbPositions(BaseParticles &particles)
+{
+    // the same deterministic perturbation for the compared bodies
+    Vecd *pos = particles.ParticlePositions();
+    for (size_t i = 0; i != particles.TotalRealParticles(); ++i)
+    {
+        pos[i] += 0.2 * particle_spacing * Vecd(sin(37.0 * pos[i][0] + 11.0 * pos[i][1]), cos(23.0 * pos[i][0] - 17.0 * pos[i][1]));
+    }
+}
+//----------------------------------------------------------------------
+//	The indicator is identical to that of the spatial-temporal indication.
+//----------------------------------------------------------------------
+TEST(FreeSurfaceStateCK, IndicatorAsSpatialTemporalIndication)
+{
+    SPHSystem sph_system(system_domain_bounds, particle_spacing);
+    WaterBlock indication_block(sph_system, "IndicationBlock");
+    WaterBlock state_block(sph_system, "StateBlock");
+    SolidBody wall(sph_system, makeShared<GeometricShapeBox>(
+                                   Transform(Vec2d(0.5 * water_width, -0.5 * wall_thickness)),
+                                   Vec2d(0.5 * water_width + wall_thickness, 0.5 * wall_thickness), "Wall"));
+    wall.generateParticles<BaseParticles, Lattice>();
+    perturbPositions(indication_block.getBaseParticles());
+    perturbPositions(state_block.getBaseParticles());
+
+    Relation<Inner<>> indication_block_inner(indication_block);
+    Relation<Contact<>> indication_wall_contact(indication_block, {&wall});
+    Relation<Inner<>> state_block_inner(state_block);
+    Relation<Contact<>> state_wall_contact(state_block, {&wall});
+
+    UpdateCellLinkedList<MainExecutionPolicy, CellLinkedList> indication_cell_linked_list(indication_block);
+    UpdateCellLinkedList<MainExecutionPolicy, CellLinkedList> state_cell_linked_list(state_block);
+    UpdateCellLinkedList<MainExecutionPolicy, CellLinkedList> wall_cell_linked_list(wall);
+    UpdateRelation<MainExecutionPolicy, Inner<>, Contact<>>
+        indication_block_update_complex_relation(indication_block_inner, indication_wall_contact);
+    UpdateRelation<MainExecutionPolicy, Inner<>, Contact<>>
+        state_block_update_complex_relation(state_block_inner, state_wall_contact);
+
+    InteractionDynamicsCK<MainExecutionPolicy, fluid_dynamics::FreeSurfaceIndicationComplexSpatialTemporalCK>
+        free_surface_indication(indication_block_inner, indication_wall_contact);
+    InteractionDynamicsCK<MainExecutionPolicy, fluid_dynamics::FreeSurfaceStateComplexCK>
+        free_surface_state(state_block_inner, state_wall_contact);
+
+    wall_cell_linked_list.exec();
+    indication_cell_linked_list.exec();
+    state_cell_linked_list.exec();
+    indication_block_update_complex_relation.exec();
+    state_block_update_complex_relation.exec();
+
+    BaseParticles &indication_particles = indication_block.getBaseParticles();
+    BaseParticles &state_particles = state_block.getBaseParticles();
+    int *indication_indicator = indication_particles.getVariableDataByName<int>("Indicator");
+    int *state_indicator = state_particles.getVariableDataByName<int>("Indicator");
+    // the repeated evaluations involve the previous surface indicator
+    for (size_t n = 0; n != 3; ++n)
+    {
+        free_surface_indication.exec();
+        free_surface_state.exec();
+        size_t number_of_surface_particles = 0;
+        for (size_t i = 0; i != state_particles.TotalRealParticles(); ++i)
+        {
+            ASSERT_EQ(state_indicator[i], indication_indicator[i]);
+            number_of_surface_particles += state_indicator[i];
+        }
+        EXPECT_GT(number_of_surface_particles, size_t(0));
+    }
+}
+//----------------------------------------------------------------------
+//	The normal, curvature and surface tension of a circular droplet.
+//----------------------------------------------------------------------
+TEST(FreeSurfaceStateCK, DropletNormalAndCurvature)
+{
+    SPHSystem sph_system(system_domain_bounds, particle_spacing);
+    Vecd droplet_center(0.5, 0.5);
+    FluidBody droplet(sph_system, makeShared<GeometricShapeBall>(droplet_center, droplet_radius, "Droplet"));
+    droplet.defineMaterial<WeaklyCompressibleFluid>(rho0_f, c_f);
+    droplet.generateParticles<BaseParticles, Lattice>();
+
+    Relation<Inner<>> droplet_inner(droplet);
+    UpdateCellLinkedList<MainExecutionPolicy, CellLinkedList> droplet_cell_linked_list(droplet);
+    UpdateRelation<MainExecutionPolicy, Inner<>> droplet_update_inner_relation(droplet_inner);
+    InteractionDynamicsCK<MainExecutionPolicy, fluid_dynamics::FreeSurfaceStateInnerCK> free_surface_state(droplet_inner);
+    StateDynamics<MainExecutionPolicy, fluid_dynamics::FreeSurfaceTensionForceCK>
+        surface_tension_force(droplet, surface_tension_coeff);
+
+    droplet_cell_linked_list.exec();
+    droplet_update_inner_relation.exec();
+    free_surface_state.exec();
+    surface_tension_force.exec();
+
+    BaseParticles &particles = droplet.getBaseParticles();
+    Vecd *pos = particles.ParticlePositions();
+    int *indicator = particles.getVariableDataByName<int>("Indicator");
+    Vecd *normal = particles.getVariableDataByName<Vecd>("FreeSurfaceNormal");
+    Real *curvature = particles.getVariableDataByName<Real>("FreeSurfaceCurvature");
+    Vecd *surface_tension = particles.getVariableDataByName<Vecd>("FreeSurfaceTensionForce");
+    size_t number_of_outer_particles = 0;
+    Real min_normal_alignment = 1.0;
+    Real curvature_sum = 0.0;
+    for (size_t i = 0; i != particles.TotalRealParticles(); ++i)
+    {
+        Vecd radial = pos[i] - droplet_center;
+        // the outermost layer is on the surface
+        if (radial.norm() > droplet_radius - 0.5 * particle_spacing)
+        {
+            EXPECT_EQ(indicator[i], 1);
+            min_normal_alignment = SMIN(min_normal_alignment, normal[i].dot(radial.normalized()));
+            curvature_sum += curvature[i];
+            // the surface tension pulls the surface particles inward
+            EXPECT_LT(surface_tension[i].dot(radial), 0.0);
+            number_of_outer_particles++;
+        }
+        // the particles far inside are not
+        if (radial.norm() < droplet_radius - 4.0 * particle_spacing)
+        {
+            EXPECT_EQ(indicator[i], 0);
+        }
+    }
+    ASSERT_GT(number_of_outer_particles, size_t(0));
+    EXPECT_GT(min_normal_alignment, 0.9);
+    Real average_curvature = curvature_sum / Real(number_of_outer_particles);
+    EXPECT_NEAR(average_curvature * droplet_radius, 1.0, 0.2);
+    std::cout << "Average curvature times radius: " << average_curvature * droplet_radius
+              << " and minimum normal alignment: " << min_normal_alignment << std::endl;
+}
+//----------------------------------------------------------------------
+//	The smeared-surface regularization on a static water block.
+//----------------------------------------------------------------------
+TEST(FreeSurfaceStateCK, SmearedSurfaceRegularization)
+{
+    SPHSystem sph_system(system_domain_bounds, particle_spacing);
+    WaterBlock water_block(sph_system, "WaterBlock");
+
+    Relation<Inner<>> water_block_inner(water_block);
+    UpdateCellLinkedList<MainExecutionPolicy, CellLinkedList> water_cell_linked_list(water_block);
+    UpdateRelation<MainExecutionPolicy, Inner<>> water_block_update_inner_relation(water_block_inner);
+    fluid_dynamics::CachedFreeSurfaceStateInnerCK<MainExecutionPolicy> free_surface_state(water_block_inner);
+    InteractionDynamicsCK<MainExecutionPolicy, fluid_dynamics::DensityRegularization<
+                                                   Inner<WithUpdate, SmearedSurface, AllParticles>>>
+        density_regularization(water_block_inner);
+
+    water_cell_linked_list.exec();
+    water_block_update_inner_relation.exec();
+    free_surface_state.exec();
+    density_regularization.exec();
+
+    BaseParticles &particles = water_block.getBaseParticles();
+    Vecd *pos = particles.ParticlePositions();
+    int *indicator = particles.getVariableDataByName<int>("Indicator");
+    int *smeared_surface = particles.getVariableDataByName<int>("SmearedSurface");
+    Real *rho = particles.getVariableDataByName<Real>("Density");
+    Real *rho_sum = particles.getVariableDataByName<Real>("DensitySummation");
+    Real cutoff_radius = water_block.getSPHAdaptation().getKernel()->CutOffRadius();
+    size_t number_of_smeared_particles = 0;
+    for (size_t i = 0; i != particles.TotalRealParticles(); ++i)
+    {
+        if (indicator[i] == 1)
+        {
+            EXPECT_NE(smeared_surface[i], 0);
+        }
+
+        if (smeared_surface[i] != 0)
+        {
+            // the truncated summation density is limited by the reference one
+            EXPECT_DOUBLE_EQ(rho[i], SMAX(rho_sum[i], rho0_f));
+            number_of_smeared_particles++;
+        }
+        else
+        {
+            EXPECT_DOUBLE_EQ(rho[i], rho_sum[i]);
+        }
+
+        Real distance_to_surface = SMIN(SMIN(pos[i][0], water_width - pos[i][0]),
+                                        SMIN(pos[i][1], water_height - pos[i][1]));
+        if (distance_to_surface > 2.0 * cutoff_radius)
+        {
+            EXPECT_EQ(smeared_surface[i], 0);
+        }
+    }
+    EXPECT_GT(number_of_smeared_particles, size_t(0));
+    EXPECT_LT(number_of_smeared_particles, particles.TotalRealParticles());
+}
+//----------------------------------------------------------------------
+//	Main program starts here.
+//----------------------------------------------------------------------
+int main(int ac, char *av[])
+{
+    testing::InitGoogleTest(&ac, av);
+    return RUN_ALL_TESTS();
+}
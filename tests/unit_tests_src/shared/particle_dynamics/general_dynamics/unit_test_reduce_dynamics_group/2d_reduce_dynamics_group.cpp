@@ -0,0 +1,79 @@
+/**
+ * @file 	2d_reduce_dynamics_group.cpp
+ * @brief 	test the evaluation of several reduce dynamics in one particle pass
+ * @details The grouped reductions, with max, sum, logical or and averaging operations,
+ *			should give the same results as the separately executed reduce dynamics,
+ *			for both the classic and the computing-kernel versions.
+ * @author 	Xiangyu Hu
+ */
+#include "sphinxsys_ck.h"
+#include <gtest/gtest.h>
+using namespace SPH;
+//----------------------------------------------------------------------
+//	Basic geometry parameters and numerical setup.
+//----------------------------------------------------------------------
+Real block_width = 2.0;
+Real block_height = 1.0;
+Real particle_spacing = 0.02;
+Real rho0_f = 1.0;
+Real U_ref = 1.0;
+Real c_f = 10.0 * U_ref;
+BoundingBox system_domain_bounds(Vec2d(-0.5, -0.5), Vec2d(block_width + 0.5, block_height + 0.5));
+using MainExecutionPolicy = execution::ParallelPolicy;
+//----------------------------------------------------------------------
+//	Main program starts here.
+//----------------------------------------------------------------------
+TEST(ReduceDynamicsGroup, OnePassReductions)
+{
+    SPHSystem sph_system(system_domain_bounds, particle_spacing);
+    GeometricShapeBox block_shape(Transform(Vec2d(0.5 * block_width, 0.5 * block_height)),
+                                  Vec2d(0.5 * block_width, 0.5 * block_height), "WaterBody");
+    FluidBody water_block(sph_system, block_shape);
+    water_block.defineMaterial<WeaklyCompressibleFluid>(rho0_f, c_f);
+    water_block.generateParticles<BaseParticles, Lattice>();
+
+    BaseParticles &particles = water_block.getBaseParticles();
+    Vecd *pos = particles.ParticlePositions();
+    Vecd *vel = particles.getVariableDataByName<Vecd>("Velocity");
+    for (size_t i = 0; i != particles.TotalRealParticles(); ++i)
+    {
+        vel[i] = U_ref * Vecd(sin(Pi * pos[i][0]) * cos(Pi * pos[i][1]), pos[i][0] * pos[i][1]);
+    }
+    //----------------------------------------------------------------------
+    //	Classic reduce dynamics.
+    //----------------------------------------------------------------------
+    ReduceDynamics<fluid_dynamics::AcousticTimeStep> acoustic_time_step(water_block);
+    ReduceDynamics<MaximumSpeed> maximum_speed(water_block);
+    ReduceDynamics<VelocityBoundCheck> velocity_bound_check(water_block, 0.5 * U_ref);
+    ReduceDynamicsGroup<ParallelPolicy, fluid_dynamics::AcousticTimeStep, MaximumSpeed, VelocityBoundCheck>
+        classic_reduce_group(acoustic_time_step, maximum_speed, velocity_bound_check);
+
+    auto [acoustic_dt, max_speed, is_out_of_bound] = classic_reduce_group.exec();
+    EXPECT_EQ(acoustic_dt, acoustic_time_step.exec());
+    EXPECT_EQ(max_speed, maximum_speed.exec());
+    EXPECT_EQ(is_out_of_bound, velocity_bound_check.exec());
+    EXPECT_TRUE(is_out_of_bound);
+    //----------------------------------------------------------------------
+    //	Computing-kernel reduce dynamics.
+    //----------------------------------------------------------------------
+    ReduceDynamicsCK<MainExecutionPolicy, fluid_dynamics::AcousticTimeStepCK<>> acoustic_time_step_ck(water_block);
+    ReduceDynamicsCK<MainExecutionPolicy, fluid_dynamics::AdvectionViscousTimeStepCK> advection_time_step_ck(water_block, U_ref);
+    ReduceDynamicsCK<MainExecutionPolicy, TotalKineticEnergyCK> total_kinetic_energy_ck(water_block);
+    ReduceDynamicsCK<MainExecutionPolicy, QuantityAverage<Vecd>> average_velocity_ck(water_block, "Velocity");
+    ReduceDynamicsGroupCK<MainExecutionPolicy, fluid_dynamics::AcousticTimeStepCK<>,
+                          fluid_dynamics::AdvectionViscousTimeStepCK, TotalKineticEnergyCK, QuantityAverage<Vecd>>
+        reduce_group_ck(acoustic_time_step_ck, advection_time_step_ck, total_kinetic_energy_ck, average_velocity_ck);
+
+    auto [acoustic_dt_ck, advection_dt_ck, kinetic_energy, average_velocity] = reduce_group_ck.exec();
+    EXPECT_EQ(acoustic_dt_ck, acoustic_time_step_ck.exec());
+    EXPECT_EQ(advection_dt_ck, advection_time_step_ck.exec());
+    Real separate_kinetic_energy = total_kinetic_energy_ck.exec();
+    EXPECT_NEAR(kinetic_energy, separate_kinetic_energy, 1.0e-12 * separate_kinetic_energy);
+    EXPECT_LT((average_velocity - average_velocity_ck.exec()).norm(), 1.0e-12 * U_ref);
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
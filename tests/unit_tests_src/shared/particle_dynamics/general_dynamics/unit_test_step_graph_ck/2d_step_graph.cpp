@@ -0,0 +1,194 @@
+/**
+ * @file 	2d_step_graph.cpp
+ * @brief 	test the dependency-graph execution of dynamics on several bodies
+ * @details Two identical groups of falling water blocks are integrated,
+ *			one with sequential calls and the other with the step graph.
+ *			The results should be identical. The dependencies recorded from the variables
+ *			accessed by the dynamics should chain the dynamics of each block
+ *			while leaving the blocks independent.
+ * @author 	Xiangyu Hu
+ */
+#include "sphinxsys_ck.h"
+#include <gtest/gtest.h>
+using namespace SPH;
+//----------------------------------------------------------------------
+//	Basic geometry parameters and numerical setup.
+//----------------------------------------------------------------------
+Real block_size = 1.0;
+Real particle_spacing = 0.02;
+size_t number_of_blocks = 3;
+Real rho0_f = 1.0;
+Real gravity_g = 1.0;
+Real c_f = 10.0 * sqrt(gravity_g * block_size);
+//----------------------------------------------------------------------
+//	A water block with its own dynamics.
+//----------------------------------------------------------------------
+class WaterBlock : public FluidBody
+{
+  public:
+    WaterBlock(SPHSystem &sph_system, Shape &shape) : FluidBody(sph_system, shape)
+    {
+        defineMaterial<WeaklyCompressibleFluid>(rho0_f, c_f);
+        generateParticles<BaseParticles, Lattice>();
+    };
+};
+
+using MainExecutionPolicy = execution::ParallelPolicy;
+class FallingBlock
+{
+  public:
+    FallingBlock(SPHSystem &sph_system, const std::string &name, size_t block_index, Gravity &gravity)
+        : block_shape_(Transform(Vec2d(2.0 * block_size * Real(block_index) + 0.5 * block_size, 0.5 * block_size)),
+                       Vec2d(0.5 * block_size, 0.5 * block_size), name),
+          water_block_(sph_system, block_shape_),
+          water_block_inner_(water_block_),
+          water_cell_linked_list_(water_block_),
+          water_block_update_inner_relation_(water_block_inner_),
+          constant_gravity_(water_block_, gravity),
+          water_advection_step_setup_(water_block_),
+          water_advection_step_close_(water_block_),
+          fluid_acoustic_step_1st_half_(water_block_inner_),
+          fluid_acoustic_step_2nd_half_(water_block_inner_){};
+
+    GeometricShapeBox block_shape_;
+    WaterBlock water_block_;
+    Relation<Inner<>> water_block_inner_;
+    UpdateCellLinkedList<MainExecutionPolicy, CellLinkedList> water_cell_linked_list_;
+    UpdateRelation<MainExecutionPolicy, Inner<>> water_block_update_inner_relation_;
+    StateDynamics<MainExecutionPolicy, GravityForceCK<Gravity>> constant_gravity_;
+    StateDynamics<MainExecutionPolicy, fluid_dynamics::AdvectionStepSetup> water_advection_step_setup_;
+    StateDynamics<MainExecutionPolicy, fluid_dynamics::AdvectionStepClose> water_advection_step_close_;
+    InteractionDynamicsCK<MainExecutionPolicy, fluid_dynamics::AcousticStep1stHalf<
+                                                   Inner<OneLevel, AcousticRiemannSolverCK, NoKernelCorrectionCK>>>
+        fluid_acoustic_step_1st_half_;
+    InteractionDynamicsCK<MainExecutionPolicy, fluid_dynamics::AcousticStep2ndHalf<
+                                                   Inner<OneLevel, AcousticRiemannSolverCK, NoKernelCorrectionCK>>>
+        fluid_acoustic_step_2nd_half_;
+
+    void initialize()
+    {
+        constant_gravity_.exec();
+        water_cell_linked_list_.exec();
+        water_block_update_inner_relation_.exec();
+    };
+
+    void runStep(Real dt)
+    {
+        water_advection_step_setup_.exec();
+        fluid_acoustic_step_1st_half_.exec(dt);
+        fluid_acoustic_step_2nd_half_.exec(dt);
+        water_advection_step_close_.exec();
+        water_cell_linked_list_.exec();
+        water_block_update_inner_relation_.exec();
+    };
+
+    void addToStepGraph(StepGraph &step_graph, const Real &dt)
+    {
+        // the variables accessed are recorded by the step graph at its first execution
+        std::string name = water_block_.getName();
+        step_graph.addNode(name + "AdvectionStepSetup", water_advection_step_setup_);
+        step_graph.addNode(name + "AcousticStep1stHalf", fluid_acoustic_step_1st_half_, dt);
+        step_graph.addNode(name + "AcousticStep2ndHalf", fluid_acoustic_step_2nd_half_, dt);
+        step_graph.addNode(name + "AdvectionStepClose", water_advection_step_close_);
+        step_graph.addNode(name + "CellLinkedList", water_cell_linked_list_);
+        step_graph.addNode(name + "InnerRelation", water_block_update_inner_relation_);
+    };
+};
+//----------------------------------------------------------------------
+//	Main program starts here.
+//----------------------------------------------------------------------
+size_t number_of_nodes_per_block = 6;
+size_t number_of_nodes = 0;
+size_t number_of_levels = 0;
+size_t number_of_cross_block_edges = 0;
+size_t number_of_missing_chain_edges = 0;
+Real max_position_difference = MaxReal;
+TEST(StepGraph, ConcurrentExecution)
+{
+    EXPECT_EQ(number_of_nodes, number_of_blocks * number_of_nodes_per_block);
+    EXPECT_EQ(number_of_levels, number_of_nodes_per_block);
+    EXPECT_EQ(number_of_cross_block_edges, size_t(0));
+    EXPECT_EQ(number_of_missing_chain_edges, size_t(0));
+    EXPECT_EQ(max_position_difference, 0.0);
+    std::cout << "Number of nodes: " << number_of_nodes << " and "
+              << "number of levels: " << number_of_levels << std::endl;
+};
+
+int main(int ac, char *av[])
+{
+    BoundingBox system_domain_bounds(Vec2d(-block_size, -block_size),
+                                     Vec2d(2.0 * block_size * Real(number_of_blocks) + block_size, 2.0 * block_size));
+    SPHSystem sph_system(system_domain_bounds, particle_spacing);
+    sph_system.handleCommandlineOptions(ac, av)->setIOEnvironment();
+
+    Gravity gravity(Vecd(0.0, -gravity_g));
+    UniquePtrsKeeper<FallingBlock> falling_block_ptrs;
+    StdVec<FallingBlock *> sequenced_blocks, graph_blocks;
+    for (size_t k = 0; k != number_of_blocks; ++k)
+    {
+        sequenced_blocks.push_back(falling_block_ptrs.createPtr<FallingBlock>(
+            sph_system, "SequencedBlock" + std::to_string(k), k, gravity));
+        graph_blocks.push_back(falling_block_ptrs.createPtr<FallingBlock>(
+            sph_system, "GraphBlock" + std::to_string(k), k, gravity));
+    }
+
+    Real dt = 0.1 * particle_spacing / c_f;
+    StepGraph step_graph;
+    for (size_t k = 0; k != number_of_blocks; ++k)
+    {
+        sequenced_blocks[k]->initialize();
+        graph_blocks[k]->initialize();
+        graph_blocks[k]->addToStepGraph(step_graph, dt);
+    }
+    number_of_nodes = step_graph.NumberOfNodes();
+
+    size_t number_of_steps = 100;
+    TimeInterval sequenced_time, graph_time;
+    TickCount time_instance = TickCount::now();
+    for (size_t n = 0; n != number_of_steps; ++n)
+    {
+        for (size_t k = 0; k != number_of_blocks; ++k)
+            sequenced_blocks[k]->runStep(dt);
+    }
+    sequenced_time = TickCount::now() - time_instance;
+
+    time_instance = TickCount::now();
+    for (size_t n = 0; n != number_of_steps; ++n)
+    {
+        step_graph.exec();
+    }
+    graph_time = TickCount::now() - time_instance;
+
+    // the nodes of a block form a chain and the blocks are independent
+    number_of_levels = step_graph.NumberOfLevels();
+    StdVec<StdVec<size_t>> &predecessors = step_graph.Predecessors();
+    for (size_t j = 0; j != number_of_nodes; ++j)
+    {
+        for (size_t i : predecessors[j])
+        {
+            if (i / number_of_nodes_per_block != j / number_of_nodes_per_block)
+                number_of_cross_block_edges++;
+        }
+        if (j % number_of_nodes_per_block != 0 &&
+            std::find(predecessors[j].begin(), predecessors[j].end(), j - 1) == predecessors[j].end())
+            number_of_missing_chain_edges++;
+    }
+    std::cout << "Sequential calls: " << sequenced_time.seconds() << " seconds, "
+              << "step graph: " << graph_time.seconds() << " seconds." << std::endl;
+
+    max_position_difference = 0.0;
+    for (size_t k = 0; k != number_of_blocks; ++k)
+    {
+        BaseParticles &sequenced_particles = sequenced_blocks[k]->water_block_.getBaseParticles();
+        BaseParticles &graph_particles = graph_blocks[k]->water_block_.getBaseParticles();
+        Vecd *sequenced_pos = sequenced_particles.ParticlePositions();
+        Vecd *graph_pos = graph_particles.ParticlePositions();
+        for (size_t i = 0; i != sequenced_particles.TotalRealParticles(); ++i)
+        {
+            max_position_difference = SMAX(max_position_difference, (sequenced_pos[i] - graph_pos[i]).norm());
+        }
+    }
+
+    testing::InitGoogleTest(&ac, av);
+    return RUN_ALL_TESTS();
+}
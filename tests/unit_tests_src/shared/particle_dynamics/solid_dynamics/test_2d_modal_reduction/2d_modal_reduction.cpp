@@ -0,0 +1,127 @@
+/**
+ * @file 	2d_modal_reduction.cpp
+ * @brief 	test the modal reduction of an elastic cantilever.
+ * @details The lowest modes of a cantilever clamped at the left end are computed
+ *			from the linearized SPH stiffness operator.
+ *			The first natural frequency and the static deflection under uniform load,
+ *			obtained by the damped modal dynamics, are compared with the Euler-Bernoulli beam theory
+ *			in plane strain.
+ * @author 	Xiangyu Hu
+ */
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+using namespace SPH;
+//----------------------------------------------------------------------
+//	Basic geometry parameters and numerical setup.
+//----------------------------------------------------------------------
+Real PL = 1.0;  // beam length
+Real PH = 0.1;  // beam thickness
+Real resolution_ref = PH / 10.0;
+Real SL = 4.0 * resolution_ref; // clamped length
+BoundingBox system_domain_bounds(Vec2d(-SL - PH, -PL), Vec2d(PL + PH, PL));
+//----------------------------------------------------------------------
+//	Material properties and load.
+//----------------------------------------------------------------------
+Real rho0_s = 1.0;
+Real Youngs_modulus = 1.0e4;
+Real poisson = 0.3;
+Real load_acceleration = 1.0;
+Real plane_strain_modulus = Youngs_modulus / (1.0 - poisson * poisson);
+Real second_moment = PH * PH * PH / 12.0;
+Real first_frequency = 1.875104 * 1.875104 * sqrt(plane_strain_modulus * second_moment / (rho0_s * PH * PL * PL * PL * PL));
+Real tip_deflection = -rho0_s * PH * load_acceleration * PL * PL * PL * PL / (8.0 * plane_strain_modulus * second_moment);
+//----------------------------------------------------------------------
+//	Body shapes.
+//----------------------------------------------------------------------
+class Beam : public ComplexShape
+{
+  public:
+    explicit Beam(const std::string &shape_name) : ComplexShape(shape_name)
+    {
+        Vec2d halfsize(0.5 * (PL + SL), 0.5 * PH);
+        add<GeometricShapeBox>(Transform(Vec2d(0.5 * (PL - SL), 0.5 * PH)), halfsize);
+    }
+};
+class Clamp : public ComplexShape
+{
+  public:
+    explicit Clamp(const std::string &shape_name) : ComplexShape(shape_name)
+    {
+        Vec2d halfsize(0.5 * SL, PH);
+        add<GeometricShapeBox>(Transform(Vec2d(-0.5 * SL, 0.5 * PH)), halfsize);
+    }
+};
+//----------------------------------------------------------------------
+//	Google test item.
+//----------------------------------------------------------------------
+Real frequency_error = MaxReal;
+Real deflection_error = MaxReal;
+Real orthonormality_error = MaxReal;
+TEST(ModalReduction, Cantilever)
+{
+    EXPECT_LT(frequency_error, 0.08);
+    EXPECT_LT(deflection_error, 0.15);
+    EXPECT_LT(orthonormality_error, 1.0e-6);
+    std::cout << "First frequency error: " << frequency_error << " and "
+              << "tip deflection error: " << deflection_error << std::endl;
+};
+//----------------------------------------------------------------------
+//	Main program starts here.
+//----------------------------------------------------------------------
+int main(int ac, char *av[])
+{
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    sph_system.handleCommandlineOptions(ac, av)->setIOEnvironment();
+
+    SolidBody beam(sph_system, makeShared<Beam>("Beam"));
+    beam.defineMaterial<SaintVenantKirchhoffSolid>(rho0_s, Youngs_modulus, poisson);
+    beam.generateParticles<BaseParticles, Lattice>();
+
+    InnerRelation beam_inner(beam);
+    InteractionWithUpdate<LinearGradientCorrectionMatrixInner> beam_corrected_configuration(beam_inner);
+    BodyRegionByParticle clamp(beam, makeShared<Clamp>("Clamp"));
+    solid_dynamics::ModalReduction modal_reduction(beam_inner, clamp, 4, 1.0);
+
+    sph_system.initializeSystemCellLinkedLists();
+    sph_system.initializeSystemConfigurations();
+    beam_corrected_configuration.exec();
+    modal_reduction.computeModes();
+
+    BaseParticles &beam_particles = beam.getBaseParticles();
+    size_t total_real_particles = beam_particles.TotalRealParticles();
+    Real *mass = beam_particles.getVariableDataByName<Real>("Mass");
+    Vecd *pos = beam_particles.getVariableDataByName<Vecd>("Position");
+    Vecd *pos0 = beam_particles.getVariableDataByName<Vecd>("InitialPosition");
+    Vecd *force_prior = beam_particles.getVariableDataByName<Vecd>("ForcePrior");
+
+    frequency_error = ABS(modal_reduction.NaturalFrequency(0) - first_frequency) / first_frequency;
+    orthonormality_error = 0.0;
+    for (size_t m = 0; m != modal_reduction.NumberOfModes(); ++m)
+        for (size_t n = 0; n != modal_reduction.NumberOfModes(); ++n)
+        {
+            Real product = 0.0;
+            for (size_t i = 0; i != total_real_particles; ++i)
+                product += mass[i] * modal_reduction.ModeShape(m)[i].dot(modal_reduction.ModeShape(n)[i]);
+            orthonormality_error = SMAX(orthonormality_error, ABS(product - (m == n ? 1.0 : 0.0)));
+        }
+
+    for (size_t i = 0; i != total_real_particles; ++i)
+        force_prior[i] = Vecd(0.0, -mass[i] * load_acceleration);
+    Real dt = 0.05 * 2.0 * Pi / modal_reduction.NaturalFrequency(0);
+    for (size_t n = 0; n != 400; ++n)
+        modal_reduction.exec(dt);
+
+    Real tip_displacement = 0.0, tip_particles = 0.0;
+    for (size_t i = 0; i != total_real_particles; ++i)
+    {
+        if (pos[i][0] > PL - resolution_ref)
+        {
+            tip_displacement += pos[i][1] - pos0[i][1];
+            tip_particles += 1.0;
+        }
+    }
+    deflection_error = ABS(tip_displacement / tip_particles - tip_deflection) / ABS(tip_deflection);
+
+    testing::InitGoogleTest(&ac, av);
+    return RUN_ALL_TESTS();
+}
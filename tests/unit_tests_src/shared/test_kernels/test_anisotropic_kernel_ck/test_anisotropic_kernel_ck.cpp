@@ -0,0 +1,137 @@
+/**
+ * @file 	test_anisotropic_kernel_ck.cpp
+ * @brief 	test the anisotropic kernel and neighbor search with computing kernels
+ * @details The particles are stretched along the x direction and the kernel support is stretched accordingly.
+ *			The neighbor lists should agree with those from a brute-force ellipsoidal search,
+ *			and the kernel should reproduce the partition of unity and a linear gradient.
+ * @author 	Xiangyu Hu
+ */
+#include "sphinxsys_ck.h"
+#include <gtest/gtest.h>
+using namespace SPH;
+//----------------------------------------------------------------------
+//	Basic geometry parameters and numerical setup.
+//----------------------------------------------------------------------
+Real block_width = 2.0;
+Real block_height = 0.5;
+Real stretch_ratio = 4.0;
+Real particle_spacing = 0.02; // in y direction
+BoundingBox system_domain_bounds(Vec2d(-0.5, -0.5), Vec2d(block_width + 0.5, block_height + 0.5));
+using MainExecutionPolicy = execution::ParallelPolicy;
+//----------------------------------------------------------------------
+//	Only anisotropy-aware interaction kernels are allowed with the anisotropic neighborhood.
+//----------------------------------------------------------------------
+struct AnisotropyAwareKernel
+{
+    static constexpr bool anisotropy_aware = true;
+};
+static_assert(is_anisotropy_aware<AnisotropyAwareKernel>::value, "declared anisotropy aware");
+static_assert(!is_anisotropy_aware<Interaction<Inner<Anisotropic>>::InteractKernel>::value,
+              "interaction kernels assume a unit e_ij by default");
+//----------------------------------------------------------------------
+//	Brute-force reference of the neighbor list.
+//----------------------------------------------------------------------
+IndexVector findNeighbors(size_t index_i, BaseParticles &particles, Matd *transform, Real cutoff_radius)
+{
+    IndexVector neighbors;
+    Vecd *pos = particles.ParticlePositions();
+    for (size_t j = 0; j != particles.TotalRealParticles(); ++j)
+    {
+        Vecd isotropic_displacement = 0.5 * (transform[index_i] + transform[j]) * (pos[index_i] - pos[j]);
+        if (j != index_i && isotropic_displacement.norm() < cutoff_radius)
+            neighbors.push_back(j);
+    }
+    return neighbors;
+}
+
+void checkNeighborLists(Relation<Inner<Anisotropic>> &inner_relation, BaseParticles &particles,
+                        Matd *transform, Real cutoff_radius)
+{
+    UnsignedInt *neighbor_index = inner_relation.getNeighborIndex()->Data();
+    UnsignedInt *particle_offset = inner_relation.getParticleOffset()->Data();
+    for (size_t i = 0; i != particles.TotalRealParticles(); ++i)
+    {
+        IndexVector reference = findNeighbors(i, particles, transform, cutoff_radius);
+        IndexVector neighbors(neighbor_index + particle_offset[i], neighbor_index + particle_offset[i + 1]);
+        std::sort(neighbors.begin(), neighbors.end());
+        ASSERT_EQ(neighbors, reference);
+    }
+}
+//----------------------------------------------------------------------
+//	Main program starts here.
+//----------------------------------------------------------------------
+TEST(AnisotropicKernelCK, NeighborSearchAndKernel)
+{
+    SPHSystem sph_system(system_domain_bounds, particle_spacing);
+    // particles are generated in a compressed block and stretched afterwards
+    GeometricShapeBox block_shape(Transform(Vec2d(0.5 * block_width / stretch_ratio, 0.5 * block_height)),
+                                  Vec2d(0.5 * block_width / stretch_ratio, 0.5 * block_height), "Block");
+    RealBody block(sph_system, block_shape);
+    block.defineAdaptation<AnisotropicAdaptation>(Vec2d(stretch_ratio, 1.0));
+    block.generateParticles<BaseParticles, Lattice>();
+
+    BaseParticles &particles = block.getBaseParticles();
+    Vecd *pos = particles.ParticlePositions();
+    Real *Vol = particles.getVariableDataByName<Real>("VolumetricMeasure");
+    for (size_t i = 0; i != particles.TotalRealParticles(); ++i)
+    {
+        pos[i][0] *= stretch_ratio;
+        Vol[i] *= stretch_ratio;
+    }
+
+    AnisotropicAdaptation &adaptation = DynamicCast<AnisotropicAdaptation>(this, block.getSPHAdaptation());
+    Matd *transform = adaptation.dvAnisotropicTransform()->Data();
+    Real cutoff_radius = adaptation.getKernel()->CutOffRadius();
+    CellLinkedList &cell_linked_list = DynamicCast<CellLinkedList>(this, block.getCellLinkedList());
+    EXPECT_NEAR(cell_linked_list.getMesh().GridSpacing(), cutoff_radius, Eps);
+    EXPECT_EQ(cell_linked_list.SearchDepth()[0], int(stretch_ratio));
+    EXPECT_EQ(cell_linked_list.SearchDepth()[1], 1);
+
+    Relation<Inner<Anisotropic>> block_inner(block);
+    UpdateCellLinkedList<MainExecutionPolicy, CellLinkedList> block_cell_linked_list(block);
+    UpdateRelation<MainExecutionPolicy, Inner<Anisotropic>> block_update_inner_relation(block_inner);
+    block_cell_linked_list.exec();
+    block_update_inner_relation.exec();
+    checkNeighborLists(block_inner, particles, transform, cutoff_radius);
+
+    // partition of unity and linear gradient at a particle far from the boundaries
+    Neighbor<Anisotropic> neighbor(MainExecutionPolicy{}, &adaptation, &adaptation,
+                                   block_inner.getSourcePosition(), block_inner.getTargetPosition());
+    UnsignedInt *neighbor_index = block_inner.getNeighborIndex()->Data();
+    UnsignedInt *particle_offset = block_inner.getParticleOffset()->Data();
+    Vecd center(0.5 * block_width, 0.5 * block_height);
+    size_t index_i = 0;
+    for (size_t i = 0; i != particles.TotalRealParticles(); ++i)
+    {
+        if ((pos[i] - center).norm() < (pos[index_i] - center).norm())
+            index_i = i;
+    }
+    Real kernel_integral = adaptation.ReferenceTransform().determinant() *
+                           adaptation.getKernel()->W0(ZeroVecd) * Vol[index_i];
+    Vecd linear_gradient = Vecd::Zero();
+    for (UnsignedInt n = particle_offset[index_i]; n != particle_offset[index_i + 1]; ++n)
+    {
+        UnsignedInt index_j = neighbor_index[n];
+        kernel_integral += neighbor.W_ij(index_i, index_j) * Vol[index_j];
+        linear_gradient -= (pos[index_i] - pos[index_j]).sum() *
+                           neighbor.dW_ij(index_i, index_j) * neighbor.e_ij(index_i, index_j) * Vol[index_j];
+    }
+    EXPECT_NEAR(kernel_integral, 1.0, 0.01);
+    EXPECT_NEAR(linear_gradient[0], 1.0, 0.05);
+    EXPECT_NEAR(linear_gradient[1], 1.0, 0.05);
+
+    // shorter supports in the right half of the block, the pair transforms are averaged
+    for (size_t i = 0; i != particles.TotalRealParticles(); ++i)
+    {
+        if (pos[i][0] > center[0])
+            transform[i](0, 0) = 1.0 / (0.5 * stretch_ratio);
+    }
+    block_update_inner_relation.exec();
+    checkNeighborLists(block_inner, particles, transform, cutoff_radius);
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}